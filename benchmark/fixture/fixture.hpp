@@ -6,4 +6,6 @@
 #include "fixture_partitioning.hpp"
 #include "fixture_fpr.hpp"
 #include "fixture_mtcount.hpp"
+#include "fixture_interleaved_count.hpp"
+#include "fixture_hashing.hpp"
 #include "fixture_base.hpp"
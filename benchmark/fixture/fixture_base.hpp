@@ -1,17 +1,21 @@
 #pragma once
 
 #include <parameter/parameter.hpp>
+#include <memory/allocation_policy.hpp>
 #include <benchmark/benchmark.h>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 
 namespace filters {
 
     enum class FixtureType : size_t {
-        Construct, Count, MTCount, Contains, Partitioning, FPR
+        Construct, Count, MTCount, Contains, Partitioning, FPR, InterleavedCount, Hashing
     };
 
     enum class FixtureParameter : size_t {
-        s = 0, n_threads = 1, n_partitions = 2, n_elements_build = 3, n_elements_lookup = 4, shared_elements = 5
+        s = 0, n_threads = 1, n_partitions = 2, n_elements_build = 3, n_elements_lookup = 4, shared_elements = 5,
+        allocation = 6
     };
 
     template<FixtureType /*fixture*/, typename /*BenchmarkConfig*/>
@@ -31,4 +35,18 @@ namespace filters {
         }
     };
 
+    /**
+     * creates a filter using the allocation policy of the benchmark, reference filters use their own allocation
+     */
+    template<typename F>
+    std::unique_ptr<F> make_filter(const ::benchmark::State &state, size_t s, size_t n_partitions, size_t n_threads) {
+        if constexpr (std::is_constructible_v<F, size_t, size_t, size_t, size_t, memory::AllocationPolicy>) {
+            const auto policy = memory::AllocationPolicy::from_id(
+                    state.range(static_cast<size_t>(FixtureParameter::allocation)));
+            return std::make_unique<F>(s, n_partitions, n_threads, 4 * n_threads, policy);
+        } else {
+            return std::make_unique<F>(s, n_partitions, n_threads, 4 * n_threads);
+        }
+    }
+
 } // filters
@@ -34,8 +34,8 @@ namespace filters {
             size_t n_threads = state.range(static_cast<size_t>(FixtureParameter::n_threads));
             size_t n_partitions = state.range(static_cast<size_t>(FixtureParameter::n_partitions));
 
-            perfBenchmark(state, [this, &filter, s, n_partitions, n_threads]() -> bool {
-                filter = std::make_unique<F>(s, n_partitions, n_threads, 4 * n_threads);
+            perfBenchmark(state, [this, &state, &filter, s, n_partitions, n_threads]() -> bool {
+                filter = make_filter<F>(state, s, n_partitions, n_threads);
                 return filter->construct(generator->buildData(), generator->buildElements());
             });
 
@@ -44,6 +44,9 @@ namespace filters {
             state.counters["size"] = filter->size();
             state.counters["avg_size"] = filter->avg_size();
             state.counters["retries"] = filter->retries();
+            if constexpr (requires(F &f) { f.stashed(); }) {
+                state.counters["stashed"] = filter->stashed();
+            }
         }
     };
 }
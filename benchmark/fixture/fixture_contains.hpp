@@ -33,7 +33,7 @@ namespace filters {
 
             generator = std::make_unique<G>(n_elements_build, n_elements_lookup, shared_elements);
 
-            filter = std::make_unique<F>(s, n_partitions, n_threads, 4 * n_threads);
+            filter = make_filter<F>(state, s, n_partitions, n_threads);
             success = filter->construct(generator->buildData(), n_elements_build);
         }
 
@@ -49,7 +49,7 @@ namespace filters {
                 size_t n_partitions = state.range(static_cast<size_t>(FixtureParameter::n_partitions));
                 size_t n_elements_build = state.range(static_cast<size_t>(FixtureParameter::n_elements_build));
 
-                auto filter = std::make_unique<F>(s, n_partitions, n_threads, 4 * n_threads);
+                auto filter = make_filter<F>(state, s, n_partitions, n_threads);
                 bool success = filter->construct(generator->buildData() + n_elements_build * iteration,
                         n_elements_build);
 
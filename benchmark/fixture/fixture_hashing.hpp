@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <benchmark/benchmark.h>
+#include <filter.hpp>
+#include "fixture_base.hpp"
+#include "../generator/generator.hpp"
+#include "../perfbenchmark.hpp"
+
+namespace filters {
+
+    /**
+     * hashes the build data (one hash and one rehash per key) without any filter, the filter of the config is unused
+     */
+    template<typename BenchmarkConfig>
+    class Fixture<FixtureType::Hashing, BenchmarkConfig> : public ::benchmark::Fixture {
+
+      public:
+        using B = BenchmarkConfig;
+        using V = filters::simd::Vector<B::OptimizationParameter::registerSize, B::OptimizationParameter::simd>;
+        using H = hash::Hasher<B::OptimizationParameter::hashingMode, V, 0>;
+        using G = Generator<B::generator, V>;
+
+        std::unique_ptr<G> generator;
+
+        void SetUp(const ::benchmark::State &state) override {
+            size_t n_elements_build = state.range(static_cast<size_t>(FixtureParameter::n_elements_build));
+            generator = std::make_unique<G>(n_elements_build, 0, 0);
+        }
+
+        void TearDown(const ::benchmark::State &) override {
+        }
+
+        void benchmark(::benchmark::State &state) {
+            const size_t n_elements = generator->buildElements() / V::n_elements * V::n_elements;
+
+            perfBenchmark(state, [this, n_elements]() {
+                const typename V::T *values = generator->buildData();
+                V result(0);
+                for (size_t i = 0; i < n_elements; i += V::n_elements) {
+                    const V value = V::load(values + i);
+                    const V hash = H::hash(value);
+                    result = result ^ H::template rehash<1>(hash, value);
+                }
+                ::benchmark::DoNotOptimize(result);
+                return true;
+            });
+
+            state.counters["n_elements"] = n_elements;
+            state.counters["register_size"] = static_cast<size_t>(B::OptimizationParameter::registerSize);
+        }
+    };
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <benchmark/benchmark.h>
+#include <filter.hpp>
+#include "fixture_base.hpp"
+#include "../generator/generator.hpp"
+#include "../perfbenchmark.hpp"
+
+namespace filters {
+
+    /**
+     * measures count_interleaved() (coroutine based scalar lookups), the vectorized count() is timed on the same
+     * data for comparison
+     */
+    template<typename BenchmarkConfig>
+    class Fixture<FixtureType::InterleavedCount, BenchmarkConfig> : public ::benchmark::Fixture {
+
+      public:
+        using B = BenchmarkConfig;
+        using F = Filter<B::filter, typename B::FilterParameter, B::k, typename B::OptimizationParameter>;
+        using V = filters::simd::Vector<B::OptimizationParameter::registerSize, B::OptimizationParameter::simd>;
+        using G = Generator<B::generator, V>;
+
+        static_assert(requires(F &f, typename V::T *values) { f.count_interleaved(values, 0); },
+                "Filter does not support interleaved lookups!");
+
+        std::unique_ptr<G> generator;
+        std::unique_ptr<F> filter;
+        bool success;
+
+        void SetUp(const ::benchmark::State &state) override {
+            size_t s = state.range(static_cast<size_t>(FixtureParameter::s));
+            size_t n_threads = state.range(static_cast<size_t>(FixtureParameter::n_threads));
+            size_t n_partitions = state.range(static_cast<size_t>(FixtureParameter::n_partitions));
+            size_t n_elements_build = state.range(static_cast<size_t>(FixtureParameter::n_elements_build));
+            size_t n_elements_lookup = state.range(static_cast<size_t>(FixtureParameter::n_elements_lookup));
+            size_t shared_elements = state.range(static_cast<size_t>(FixtureParameter::shared_elements));
+
+            generator = std::make_unique<G>(n_elements_build, n_elements_lookup, shared_elements);
+
+            filter = make_filter<F>(state, s, n_partitions, n_threads);
+            success = filter->construct(generator->buildData(), n_elements_build);
+        }
+
+        void TearDown(const ::benchmark::State &) override {
+        }
+
+        void benchmark(::benchmark::State &state) {
+
+            if (not success) {
+                perfBenchmark(state, [this]() {
+                    return false;
+                });
+                state.counters["fpr"] = -1;
+            } else {
+                size_t counter = 0;
+                perfBenchmark(state, [this, &counter]() {
+                    counter = filter->count_interleaved(generator->lookupData(), generator->lookupElements());
+                    return true;
+                });
+
+                auto measure = [this](auto &&function) {
+                    auto begin = std::chrono::steady_clock::now();
+                    function();
+                    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+                };
+                const double interleaved_time = measure([this]() {
+                    filter->count_interleaved(generator->lookupData(), generator->lookupElements());
+                });
+                const double count_time = measure([this]() {
+                    filter->count(generator->lookupData(), generator->lookupElements());
+                });
+                state.counters["interleaved_time"] = interleaved_time;
+                state.counters["count_time"] = count_time;
+                state.counters["interleaved_speedup"] = count_time / interleaved_time;
+
+                // do not include first 10% of data as they always hit
+                state.counters["fpr"] = static_cast<double>(counter - generator->sharedElements()) /
+                                        static_cast<double>(generator->lookupElements() - generator->sharedElements());
+            }
+            state.counters["bits"] =
+                    static_cast<double >(filter->size() * 8) / static_cast<double>(generator->buildElements());
+            state.counters["size"] = filter->size();
+            state.counters["avg_size"] = filter->avg_size();
+            state.counters["retries"] = filter->retries();
+        }
+    };
+}
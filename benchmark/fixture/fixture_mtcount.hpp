@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <benchmark/benchmark.h>
 #include <filter.hpp>
@@ -34,7 +35,7 @@ namespace filters {
 
             generator = std::make_unique<G>(n_elements_build, n_elements_lookup, shared_elements);
 
-            filter = std::make_unique<F>(s, n_partitions, n_threads, 4 * n_threads);
+            filter = make_filter<F>(state, s, n_partitions, n_threads);
             success = filter->construct(generator->buildData(), n_elements_build);
         }
 
@@ -51,7 +52,9 @@ namespace filters {
             } else {
                 size_t counter = 0;
                 size_t n_threads = state.range(static_cast<size_t>(FixtureParameter::n_threads));
-                perfBenchmark(state, [this, &counter, n_threads]() {
+
+                // node_shift > 0 makes every worker read the replica of another node instead of its local one
+                auto count = [this, n_threads](size_t node_shift) {
                     task::TaskQueue<parameter::MultiThreading::Enabled> queue(n_threads, 4 * n_threads);
                     std::atomic<size_t> amo_counter{0};
 
@@ -61,18 +64,38 @@ namespace filters {
                     size_t n_tasks = queue.get_n_tasks_per_level();
                     for (; n_tasks > 0; n_tasks--) {
                         size_t n_elements = length / n_tasks;
-                        queue.add_task([this, &amo_counter, data, n_elements](size_t thread) {
+                        queue.add_task([this, &amo_counter, data, n_elements, node_shift](size_t thread) {
+                            int &node = memory::current_node();
+                            const int local_node = node;
+                            node = static_cast<int>((local_node + node_shift) % memory::n_nodes());
                             amo_counter += filter->count(data, n_elements);
+                            node = local_node;
                         });
                         data += n_elements;
                         length -= n_elements;
                     }
                     queue.execute_tasks();
-                    counter = amo_counter;
+                    return amo_counter.load();
+                };
 
+                perfBenchmark(state, [&counter, &count]() {
+                    counter = count(0);
                     return true;
                 });
 
+                if (memory::n_nodes() > 1) {
+                    auto measure = [&count](size_t node_shift) {
+                        auto begin = std::chrono::steady_clock::now();
+                        count(node_shift);
+                        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+                    };
+                    const double local_time = measure(0);
+                    const double remote_time = measure(1);
+                    state.counters["local_time"] = local_time;
+                    state.counters["remote_time"] = remote_time;
+                    state.counters["remote_slowdown"] = remote_time / local_time;
+                }
+
                 // do not include first 10% of data as they always hit
                 state.counters["fpr"] = static_cast<double>(counter - generator->sharedElements()) /
                                         static_cast<double>(generator->lookupElements() - generator->sharedElements());
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <benchmark/benchmark.h>
 #include <filter.hpp>
@@ -18,7 +19,7 @@ namespace filters {
         using G = Generator<B::generator, V>;
         static constexpr parameter::Partitioning p = B::OptimizationParameter::partitioning;
         static constexpr parameter::MultiThreading m = B::OptimizationParameter::multiThreading;
-        static_assert(p == parameter::Partitioning::Enabled, "Partitioning must be enabled!");
+        static_assert(p != parameter::Partitioning::Disabled, "Partitioning must be enabled!");
 
         std::unique_ptr<G> generator;
 
@@ -31,17 +32,19 @@ namespace filters {
         }
 
         void benchmark(::benchmark::State &state) {
-            size_t n_elements;
+            size_t n_elements, max_elements;
             size_t n_partitions = state.range(static_cast<size_t>(FixtureParameter::n_partitions));
 
             if (m == parameter::MultiThreading::Disabled) {
-                perfBenchmark(state, [this, &n_elements, n_partitions]() {
+                perfBenchmark(state, [this, &n_elements, &max_elements, n_partitions]() {
                     n_elements = 0;
+                    max_elements = 0;
                     partition::PartitionSet<p, V> partitions(n_partitions);
                     partitions.init(generator->buildData(), generator->buildElements());
 
                     for (size_t i = 0; i < partitions.n_partitions; i++) {
                         n_elements += partitions.histogram[i];
+                        max_elements = std::max<size_t>(max_elements, partitions.histogram[i]);
                     }
                     return true;
                 });
@@ -49,14 +52,16 @@ namespace filters {
                 size_t n_threads = state.range(static_cast<size_t>(FixtureParameter::n_threads));
                 task::TaskQueue<B::OptimizationParameter::multiThreading> queue(n_threads, n_threads * 4);
 
-                perfBenchmark(state, [this, &queue, &n_elements, n_partitions]() {
+                perfBenchmark(state, [this, &queue, &n_elements, &max_elements, n_partitions]() {
                     n_elements = 0;
+                    max_elements = 0;
                     partition::PartitionSet<p, V> partitions(n_partitions);
                     partitions.init(generator->buildData(), generator->buildElements(), queue);
                     queue.execute_tasks();
 
                     for (size_t i = 0; i < partitions.n_partitions; i++) {
                         n_elements += partitions.histogram[i];
+                        max_elements = std::max<size_t>(max_elements, partitions.histogram[i]);
                     }
                     return true;
                 });
@@ -64,6 +69,8 @@ namespace filters {
 
             state.counters["size"] = n_elements * sizeof(typename V::T);
             state.counters["avg_size"] = n_elements * sizeof(typename V::T) / n_partitions;
+            // the largest partition bounds the build time of a partition and the size of its filter
+            state.counters["max_size"] = max_elements * sizeof(typename V::T);
         }
     };
 }
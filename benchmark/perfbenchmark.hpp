@@ -25,6 +25,19 @@ namespace filters {
         return sum(v) * (1.0 / v.size());
     }
 
+    double stddev(const std::vector<double> &v) {
+        if (v.size() < 2) {
+            return 0.0;
+        }
+
+        const double m = mean(v);
+        double squares = 0.0;
+        for (double x : v) {
+            squares += (x - m) * (x - m);
+        }
+        return std::sqrt(squares / (v.size() - 1));
+    }
+
     size_t perfBenchmark(::benchmark::State &state, const std::function<bool()> &function) {
         std::vector<PerfEvent> events;
 
@@ -52,6 +65,10 @@ namespace filters {
             });
 
             state.counters[counter] = mean(v);
+            if (counter == "duration") {
+                // unlucky builds (e.g., xor retries) show up in the variance rather than in the mean
+                state.counters["duration_stddev"] = stddev(v);
+            }
         }
 
         state.counters["failures"] = static_cast<double>(state.max_iterations - events.size());
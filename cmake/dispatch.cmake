@@ -0,0 +1,29 @@
+# ---------------------------------------------------------------------------
+# Dispatch modules
+# ---------------------------------------------------------------------------
+
+# one shared module per instruction set, filters::dispatch::Dispatcher loads the widest one the cpu supports
+set(FILTERS_DISPATCH_ISAS scalar avx2 avx512)
+set(FILTERS_DISPATCH_MARCH_scalar "x86-64-v2")
+set(FILTERS_DISPATCH_MARCH_avx2 "haswell")
+set(FILTERS_DISPATCH_MARCH_avx512 "skylake-avx512")
+
+# compiles source into the modules <name>_scalar.so, <name>_avx2.so and <name>_avx512.so
+function(filters_add_dispatch_module name source)
+    if (FILTERS_MARCH STREQUAL "native")
+        message(STATUS "${name}: -march=native enables the instruction sets of the build machine in every dispatch module, configure with a portable FILTERS_MARCH (e.g. x86-64-v2)")
+    endif ()
+
+    foreach (isa ${FILTERS_DISPATCH_ISAS})
+        set(target ${name}_${isa})
+        add_library(${target} MODULE ${source})
+        set_target_properties(${target} PROPERTIES PREFIX "" OUTPUT_NAME ${target}
+                CXX_VISIBILITY_PRESET hidden VISIBILITY_INLINES_HIDDEN ON)
+        # the last -march wins over the one of the project
+        target_compile_options(${target} PRIVATE -march=${FILTERS_DISPATCH_MARCH_${isa}})
+        target_link_libraries(${target} PRIVATE Threads::Threads filters::filters)
+        list(APPEND targets ${target})
+    endforeach ()
+
+    add_custom_target(${name} DEPENDS ${targets})
+endfunction()
@@ -7,7 +7,7 @@ def extract_time(rows: [dict], index: int, xaxis: str, yaxis: str):
 
 
 def extract_throughput(rows: [dict], index: int, xaxis: str, yaxis: str):
-    if rows[index]['fixture'] == 'Count':
+    if rows[index]['fixture'] in ['Count', 'InterleavedCount']:
         return rows[index]['n_elements_lookup'] * 1000 / rows[index]['real_time']
     else:
         return rows[index]['n_elements_build'] * 1000 / rows[index]['real_time']
@@ -17,11 +17,16 @@ def extract_speedup(rows: [dict], index: int, xaxis: str, yaxis: str):
     return rows[0]['real_time'] / rows[index]['real_time']
 
 
+def extract_dtlb_delta(rows: [dict], index: int, xaxis: str, yaxis: str):
+    return rows[index]['DTLB-misses'] - rows[0]['DTLB-misses']
+
+
 yconverter = {
     'time': extract_time,
     'throughput': extract_throughput,
     'speedup': extract_speedup,
     'DTLB-misses': extract,
+    'DTLB-misses-delta': extract_dtlb_delta,
     'ITLB-misses': extract,
     'L1D-misses': extract,
     'L1I-misses': extract,
@@ -34,7 +39,12 @@ yconverter = {
     'size': extract,
     'bits': extract,
     'retries': extract,
-    'fpr': extract
+    'stashed': extract,
+    'failures': extract,
+    'duration_stddev': extract,
+    'fpr': extract,
+    'remote_slowdown': extract,
+    'interleaved_speedup': extract
 }
 
 xscale = {
@@ -44,5 +54,6 @@ xscale = {
     'n_partitions': 'log',
     'n_elements_build': 'log',
     'n_elements_lookup': 'log',
-    'shared_elements': 'linear'
+    'shared_elements': 'linear',
+    'allocation': 'linear'
 }
@@ -14,6 +14,8 @@ def read_benchmark(path: str):
     csv['n_elements_build'] = csv['name'].apply(lambda x: int(x.split('/')[5]))
     csv['n_elements_lookup'] = csv['name'].apply(lambda x: int(x.split('/')[6]))
     csv['shared_elements'] = csv['name'].apply(lambda x: float(x.split('/')[7]) / 100)
+    csv['allocation'] = csv['name'].apply(
+        lambda x: int(x.split('/')[8]) if len(x.split('/')) > 8 and x.split('/')[8].isdigit() else 1)
 
     csv['name'] = split_name.apply(lambda x: "\_".join(x[0:(len(x) - 1)]))
 
@@ -5,6 +5,7 @@
 #include <parameter/parameter.hpp>
 #include <compiler/compiler_hints.hpp>
 #include <simd/helper.hpp>
+#include <serialize/serializer.hpp>
 #include <libdivide.h>
 #include <stdexcept>
 
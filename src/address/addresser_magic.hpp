@@ -78,6 +78,28 @@ namespace filters::addresser {
             }
         }
 
+        void save(serialize::Writer &writer, const size_t length) const {
+            writer.array(magics, length * sizeof(T));
+            writer.array(shift_amounts, length * sizeof(T));
+            writer.array(divisors, length * sizeof(T));
+        }
+
+        void load(serialize::Reader &reader) {
+            Addresser loaded;
+            loaded.magics = reader.copy<T>();
+            loaded.shift_amounts = reader.copy<T>();
+            loaded.divisors = reader.copy<T>();
+            *this = std::move(loaded);
+        }
+
+        Addresser copy(const size_t length) const {
+            Addresser copied;
+            copied.magics = simd::vcopy<Vector>(magics, length * sizeof(T));
+            copied.shift_amounts = simd::vcopy<Vector>(shift_amounts, length * sizeof(T));
+            copied.divisors = simd::vcopy<Vector>(divisors, length * sizeof(T));
+            return copied;
+        }
+
         forceinline
         Vector compute_address(const Vector &index, const Vector &addresses, const M m) const {
             const Vector magic = index.gather(magics, m);
@@ -49,6 +49,22 @@ namespace filters::addresser {
             }
         }
 
+        void save(serialize::Writer &writer, const size_t length) const {
+            writer.array(sizes, length * sizeof(T));
+        }
+
+        void load(serialize::Reader &reader) {
+            Addresser loaded;
+            loaded.sizes = reader.copy<T>();
+            *this = std::move(loaded);
+        }
+
+        Addresser copy(const size_t length) const {
+            Addresser copied;
+            copied.sizes = simd::vcopy<Vector>(sizes, length * sizeof(T));
+            return copied;
+        }
+
         forceinline
         Vector compute_address(const Vector &index, const Vector &addresses, const M m) const {
             return addresses.mulh32(index.gather(sizes, m));
@@ -1,17 +1,21 @@
 #pragma once
 
 #include <iostream>
+#include <vector>
 #include <bloom/container/bloom_container.hpp>
 #include <bloom/construct/bloom_construct.hpp>
 #include <bloom/count/bloom_count.hpp>
 #include <filter_base.hpp>
 #include <address/addresser.hpp>
 #include <task/task_queue.hpp>
+#include <partition/partition_chunk.hpp>
+#include <task/interleaved_lookup.hpp>
 
 namespace filters {
 
     template<typename FilterParameter, size_t _k, typename OptimizationParameter>
-    struct Filter<FilterType::Bloom, FilterParameter, _k, OptimizationParameter> {
+    struct Filter<FilterType::Bloom, FilterParameter, _k, OptimizationParameter>
+            : FilterBase<Filter<FilterType::Bloom, FilterParameter, _k, OptimizationParameter>, OptimizationParameter> {
 
         using FP = FilterParameter;
         static constexpr size_t k = _k;
@@ -20,6 +24,9 @@ namespace filters {
                                              (FP::variant == bloom::Variant::Sectorized and
                                               FP::vectorization == bloom::Vectorization::Vertical);
         static constexpr bool supports_add_partition = supports_add;
+        // adds never fail
+        static constexpr bool supports_failsafe_add = supports_add;
+        static constexpr bool supports_remove = FP::variant == bloom::Variant::Counting;
 
         // (variant == Sectorized and blockSize == 32bit) -> registerSize == 32bit
         static_assert(not(FP::variant == bloom::Variant::Sectorized and FP::blockSize == bloom::BlockSize::_32bit) or
@@ -32,10 +39,19 @@ namespace filters {
 
         using Vector = simd::Vector<OP::registerSize, OP::simd>;
         using T = typename Vector::T;
+        using M = typename Vector::M;
+        using Base = FilterBase<Filter, OptimizationParameter>;
+        using Base::local_container;
+        using Base::replicate;
         using Addresser = addresser::Addresser<OP::addressingMode, Vector>;
         using Container = bloom::BloomContainer<FP::blockSize, OP::partitioning, Vector, Addresser>;
         using Hasher = hash::Hasher<OP::hashingMode, Vector, 0>;
         using PartitionSet = partition::PartitionSet<OP::partitioning, Vector>;
+        using BuildPartitionSet = partition::PartitionSet<OP::partitioning, Vector, OP::deduplication>;
+        // read-only export of the Counting variant, a Blocked filter with one bit per counter
+        using BitFilter = Filter<FilterType::Bloom, bloom::BloomFilterParameter<bloom::Variant::Blocked,
+                FP::vectorization, static_cast<bloom::BlockSize>(static_cast<size_t>(FP::blockSize) / 4), FP::groups>,
+                k, OP>;
 
         using Constructor = bloom::BloomConstructor<FP::variant, FP::vectorization, FP::blockSize, FP::groups, k,
                 OP::registerSize, OP::simd, Container, Hasher>;
@@ -47,11 +63,14 @@ namespace filters {
         Constructor constructor;
         Counter counter;
         task::TaskQueue<OP::multiThreading> queue;
-
-        Filter(size_t s, size_t n_partitions, size_t n_threads, size_t n_tasks_per_level) : s(s),
-                                                                                            n_partitions(n_partitions),
-                                                                                            queue(n_threads,
-                                                                                                    n_tasks_per_level) {
+        memory::AllocationPolicy policy;
+        std::vector<Container> replicas;
+        // lookahead of unpartitioned lookups in vectors, 0 disables software prefetching
+        size_t prefetch_distance{0};
+
+        Filter(size_t s, size_t n_partitions, size_t n_threads, size_t n_tasks_per_level,
+               const memory::AllocationPolicy &policy = {}) : s(s), n_partitions(n_partitions),
+                                                              queue(n_threads, n_tasks_per_level), policy(policy) {
         }
 
         forceinline
@@ -59,20 +78,22 @@ namespace filters {
             static_assert(supports_add_partition, "not supported!");
 
             n_partitions = std::max(n_partitions, 1ul);
-            container = std::move(Container(k, s, n_partitions, histogram));
+            container = std::move(Container(k, s, n_partitions, histogram, policy));
+            replicas.clear();
+            prefetch_distance = simd::prefetch_distance(size());
         }
 
         forceinline
         bool contains(const T &value) const {
-            return contains(value, value & (n_partitions - 1));
+            return contains(value, partition::partition_of<OP::partitioning>(value, n_partitions));
         }
 
         forceinline
         bool contains(const T &value, size_t index) const {
             if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
-                return counter.contains(container, Vector(value), 1, 0);
+                return counter.contains(local_container(), Vector(value), 1, 0);
             } else {
-                return counter.contains(container, Vector(value), 1, index);
+                return counter.contains(local_container(), Vector(value), 1, index);
             }
         }
 
@@ -84,6 +105,7 @@ namespace filters {
         forceinline
         bool add_partition(const T *values, size_t length, size_t index) {
             static_assert(supports_add, "not supported!");
+            replicas.clear();
 
             if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
                 constructor.construct_partition(container, values, length, 0);
@@ -95,12 +117,13 @@ namespace filters {
 
         forceinline
         bool add(const T &value) {
-            return add(value, value & (n_partitions - 1));
+            return add(value, partition::partition_of<OP::partitioning>(value, n_partitions));
         }
 
         forceinline
         bool add(const T &value, size_t index) {
             static_assert(supports_add, "not supported!");
+            replicas.clear();
 
             if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
                 constructor.insert(container, Vector(value), 1, 0);
@@ -110,44 +133,130 @@ namespace filters {
             return true;
         }
 
-        bool construct(T *values, size_t length) {
+        forceinline
+        bool remove(const T &value) {
+            return remove(value, partition::partition_of<OP::partitioning>(value, n_partitions));
+        }
+
+        /**
+         * removes a key by decrementing its counters, a key is only removed if all its counters are non-zero.
+         * Removing keys that have not been added may cause false negatives.
+         */
+        forceinline
+        bool remove(const T &value, size_t index) {
+            static_assert(supports_remove and supports_add, "not supported!");
+            replicas.clear();
+
+            if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
+                return constructor.remove(container, Vector(value), 1, 0);
+            } else {
+                return constructor.remove(container, Vector(value), 1, index);
+            }
+        }
+
+        /**
+         * removes every key and returns the number of removed keys, the keys are partitioned like in construct() and
+         * the counters of all lanes are decremented at once
+         */
+        size_t remove_all(T *values, size_t length) {
+            static_assert(supports_remove, "not supported!");
+            replicas.clear();
+
             PartitionSet partitions(n_partitions);
+            if constexpr (OP::multiThreading == parameter::MultiThreading::Disabled) {
+                partitions.init(values, length);
+                return constructor.remove(container, partitions);
+            } else {
+                partitions.init(values, length, queue);
+
+                std::atomic<size_t> n_removed{0};
+                constructor.remove(container, partitions, n_removed, queue);
+                queue.execute_tasks();
+                return n_removed;
+            }
+        }
+
+        /**
+         * exports the filter into bits, a bit is set iff its counter is non-zero. Thus, the exported filter answers
+         * every lookup like this filter with a quarter of the memory.
+         */
+        void export_bits(BitFilter &bits) const requires (FP::variant == bloom::Variant::Counting) {
+            typename BitFilter::Container exported;
+            exported.addresser = std::move(container.addresser.copy(n_partitions));
+            if constexpr (OP::partitioning != parameter::Partitioning::Disabled) {
+                exported.offsets = simd::vcopy<Vector>(container.offsets, n_partitions * sizeof(T));
+            }
+            exported.policy = bits.policy;
+            exported.n_bytes = simd::valign<Vector>(container.n_bytes / 4);
+            exported.filter = simd::valloc<Vector>(exported.n_bytes, 0, exported.policy);
+
+            // the 16 counters of a 64-bit word become 16 bits
+            const auto *counters = reinterpret_cast<const uint64_t *>(container.filter);
+            auto *words = reinterpret_cast<uint16_t *>(exported.filter);
+            for (size_t i = 0; i < container.n_bytes / sizeof(uint64_t); i++) {
+                const uint64_t non_zero = counters[i] | (counters[i] >> 1) | (counters[i] >> 2) | (counters[i] >> 3);
+                words[i] = simd::pext64(non_zero, 0x1111111111111111);
+            }
+
+            bits.s = s / 4;
+            bits.n_partitions = n_partitions;
+            bits.container = std::move(exported);
+            bits.replicas.clear();
+            if (bits.policy.placement == memory::Placement::Replicated) {
+                bits.replicate();
+            }
+            bits.prefetch_distance = simd::prefetch_distance(bits.size());
+        }
+
+        bool construct(T *values, size_t length) {
+            replicas.clear();
+            BuildPartitionSet partitions(n_partitions);
             n_partitions = partitions.n_partitions;
 
             if constexpr (OP::multiThreading == parameter::MultiThreading::Disabled) {
                 partitions.init(values, length);
-                container = std::move(Container(k, s, n_partitions, partitions.histogram));
+                container = std::move(Container(k, s, n_partitions, partitions.histogram, policy));
                 constructor.construct(container, partitions);
             } else {
                 partitions.init(values, length, queue);
 
                 queue.add_task([&](size_t) {
-                    container = std::move(Container(k, s, n_partitions, partitions.histogram));
+                    container = std::move(Container(k, s, n_partitions, partitions.histogram, policy));
                 });
                 queue.add_barrier();
 
                 constructor.construct(container, partitions, queue);
                 queue.execute_tasks();
             }
+
+            if (policy.placement == memory::Placement::Replicated) {
+                replicate();
+            }
+            prefetch_distance = simd::prefetch_distance(size());
             return true;
         }
 
-        size_t count(T *values, size_t length) {
-            PartitionSet partitions(n_partitions);
-
-            if constexpr (OP::multiThreading == parameter::MultiThreading::Disabled) {
-                partitions.init(values, length);
+        forceinline
+        void _prefetch(const Container &local, const Vector &keys, const M mask, const size_t index) const {
+            local.prefetch(index, simd::extractBits(Hasher::hash(keys), 0, Container::address_bits), mask);
+        }
 
-                return counter.count(container, partitions);
-            } else {
-                partitions.init(values, length, queue);
+        forceinline
+        M _contains(const Container &local, const Vector &keys, const M mask, const size_t index) const {
+            return counter.contains(local, keys, mask, index);
+        }
 
-                std::atomic<size_t> count{0};
-                counter.count(container, partitions, count, queue);
-                queue.execute_tasks();
+        template<typename Partitions>
+        forceinline
+        size_t _count(const Container &local, const Partitions &partitions) const {
+            return counter.count(local, partitions);
+        }
 
-                return count;
-            }
+        /**
+         * the layout does not depend on the instruction set, a filter can be loaded by one built for another
+         */
+        static std::string signature() {
+            return "Bloom;" + std::to_string(k) + ";" + FP::to_string() + ";" + OP::to_string(false);
         }
 
         size_t size() const {
@@ -168,6 +277,7 @@ namespace filters {
             s += "\t\"size\": " + std::to_string(size() * 8) + " bits,\n";
             s += "\t\"avg_size\": " + std::to_string(size() * 8) + " bits,\n";
             s += "\t\"n_partitions\": " + std::to_string(n_partitions) + ",\n";
+            s += "\t\"allocation\": " + policy.to_string() + ",\n";
             s += "\t\"filter_params\": " + FP::to_string() + ",\n";
             s += "\t\"optimization_params\": " + OP::to_string() + "\n";
             s += "}\n";
@@ -3,7 +3,7 @@
 namespace filters::bloom {
 
     enum class Variant : size_t {
-        Naive, Blocked, Sectorized, Grouped
+        Naive, Blocked, Sectorized, Grouped, Counting
     };
 
     enum class BlockSize : size_t {
@@ -40,6 +40,9 @@ namespace filters::bloom {
                 case Variant::Grouped:
                     s_variant = "Grouped";
                     break;
+                case Variant::Counting:
+                    s_variant = "Counting";
+                    break;
             }
 
             std::string s_vectorization = (vectorization == Vectorization::Horizontal)
@@ -103,4 +106,11 @@ namespace filters::bloom {
     template<size_t> using Sectorized512Vertical = BloomFilterParameter<Variant::Sectorized, Vectorization::Vertical,
             BlockSize::_512bit, Groups::_1group>;
 
+    /*
+     * Counting512 stores 4-bit counters instead of bits in a cache line, i.e., 128 counters per block. The counters
+     * are selected like the bits of Blocked128, s refers to the size including the counters.
+     */
+    template<size_t> using Counting512 = BloomFilterParameter<Variant::Counting, Vectorization::Horizontal,
+            BlockSize::_512bit, Groups::_1group>;
+
 } // filters::bloom
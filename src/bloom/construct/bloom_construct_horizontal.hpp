@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <bloom/bloom_parameter.hpp>
 #include <partition/partition_set.hpp>
 #include <hash/hasher.hpp>
@@ -40,6 +41,32 @@ namespace filters::bloom {
             }
         }
 
+        /**
+         * decrements the counters of every contained key and returns the removed keys (Counting only)
+         */
+        forceinline
+        M remove(Container &container, const Vector &values, const M mask, const size_t index) {
+            Vector hash = Hasher::hash(values);
+            Vector check_hash = hash;
+            const Vector block_offset =
+                    container.compute_offset_horizontal(index, simd::extractBits(hash, 0, Container::address_bits))
+                            << shift_factor;
+
+            M found;
+            if constexpr (Vector::avx) {
+                found = Mask::check_mask(values, check_hash, container.data(), block_offset, mask);
+                if (found) {
+                    Mask::clear_mask(values, hash, container.data(), block_offset, found);
+                }
+            } else {
+                found = Mask::check_mask(values, check_hash, container.data() + block_offset.vector, Vector(0), mask);
+                if (found) {
+                    Mask::clear_mask(values, hash, container.data() + block_offset.vector, Vector(0), found);
+                }
+            }
+            return found;
+        }
+
         forceinline
         void construct_partition(Container &container, const T *values, const size_t length, const size_t index) {
             static_assert(not Vector::avx);
@@ -79,6 +106,41 @@ namespace filters::bloom {
                 });
             }
         }
+
+        template<typename PartitionSet>
+        forceinline
+        size_t remove(Container &container, const PartitionSet &partitions) {
+            size_t n_removed = 0;
+            for (size_t i = 0; i < partitions.n_partitions; i += Mask::n_lanes) {
+                Vector begin = Vector::load(partitions.offsets + i);
+                const Vector end = begin + Vector::load(partitions.histogram + i);
+
+                for (M mask; (mask = begin < end); begin = begin + Vector(1)) {
+                    const Vector values = begin.gather(partitions.values, mask);
+                    n_removed += Vector::popcount_mask(remove(container, values, mask, i));
+                }
+            }
+            return n_removed;
+        }
+
+        template<typename PartitionSet, typename TaskQueue>
+        forceinline
+        void remove(Container &container, const PartitionSet &partitions, std::atomic<size_t> &n_removed,
+                    TaskQueue &queue) {
+            for (size_t i = 0; i < partitions.n_partitions; i += Mask::n_lanes) {
+                queue.add_task([this, &container, &partitions, &n_removed, i](size_t) {
+                    Vector begin = Vector::load(partitions.offsets + i);
+                    const Vector end = begin + Vector::load(partitions.histogram + i);
+
+                    size_t local_removed = 0;
+                    for (M mask; (mask = begin < end); begin = begin + Vector(1)) {
+                        const Vector values = begin.gather(partitions.values, mask);
+                        local_removed += Vector::popcount_mask(remove(container, values, mask, i));
+                    }
+                    n_removed += local_removed;
+                });
+            }
+        }
     };
 
 } // filters::bloom
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <cstring>
 #include <partition/partition_set.hpp>
 #include <simd/helper.hpp>
+#include <simd/prefetch.hpp>
+#include <serialize/serializer.hpp>
 
 namespace filters::bloom {
 
@@ -20,12 +22,16 @@ namespace filters::bloom {
         T *filter;
         size_t n_bytes;
         T *offsets;
+        memory::AllocationPolicy policy;
+        // set if the filter is used in place from a mapped file
+        std::shared_ptr<serialize::MappedFile> mapping;
 
         BloomContainer() : filter(nullptr), n_bytes(0), offsets(nullptr) {
         }
 
         explicit BloomContainer(BloomContainer &&other) : addresser(std::move(other.addresser)), filter(other.filter),
-                                                          n_bytes(other.n_bytes), offsets(other.offsets) {
+                                                          n_bytes(other.n_bytes), offsets(other.offsets),
+                                                          policy(other.policy), mapping(std::move(other.mapping)) {
             other.filter = nullptr;
             other.offsets = nullptr;
         }
@@ -35,14 +41,16 @@ namespace filters::bloom {
                 if (offsets) {
                     free(offsets);
                 }
-                if (filter) {
-                    simd::vfree(filter, n_bytes, true);
+                if (filter and not mapping) {
+                    simd::vfree(filter, n_bytes, policy);
                 }
 
                 addresser = std::move(other.addresser);
                 filter = other.filter;
                 n_bytes = other.n_bytes;
                 offsets = other.offsets;
+                policy = other.policy;
+                mapping = std::move(other.mapping);
 
                 other.filter = nullptr;
                 other.offsets = nullptr;
@@ -50,7 +58,8 @@ namespace filters::bloom {
             return *this;
         }
 
-        BloomContainer(size_t k, size_t s, size_t n_partitions, const T *histogram) {
+        BloomContainer(size_t k, size_t s, size_t n_partitions, const T *histogram,
+                       const memory::AllocationPolicy &policy = {}) : policy(policy) {
             T *h = new T[n_partitions];
 
             for (size_t i = 0; i < n_partitions; i++) {
@@ -62,7 +71,7 @@ namespace filters::bloom {
 
             T last_offset = 0;
 
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 offsets = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)), 0);
                 for (size_t i = 0; i < n_partitions; i++) {
                     size_t n_blocks = addresser.get_size(i);
@@ -76,21 +85,53 @@ namespace filters::bloom {
             }
 
             n_bytes = simd::valign<Vector>(last_offset * static_cast<size_t>(blockSize) / 8);
-            filter = simd::valloc<Vector>(n_bytes, 0, true);
+            filter = simd::valloc<Vector>(n_bytes, 0, policy);
+        }
+
+        /**
+         * copies other into memory allocated with policy, e.g., a replica on another node
+         */
+        BloomContainer(const BloomContainer &other, const size_t n_partitions, const memory::AllocationPolicy &policy)
+                : addresser(other.addresser.copy(n_partitions)), n_bytes(other.n_bytes), offsets(nullptr),
+                  policy(policy) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                offsets = simd::vcopy<Vector>(other.offsets, n_partitions * sizeof(T));
+            }
+            filter = simd::valloc<Vector>(n_bytes, 0, policy);
+            std::memcpy(filter, other.filter, n_bytes);
         }
 
         ~BloomContainer() {
             if (offsets) {
                 free(offsets);
             }
-            if (filter) {
-                simd::vfree(filter, n_bytes, true);
+            if (filter and not mapping) {
+                simd::vfree(filter, n_bytes, policy);
+            }
+        }
+
+        void save(serialize::Writer &writer, const size_t n_partitions) const {
+            addresser.save(writer, n_partitions);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                writer.array(offsets, n_partitions * sizeof(T));
+            }
+            writer.array(filter, n_bytes);
+        }
+
+        void load(serialize::Reader &reader) {
+            BloomContainer loaded;
+            loaded.addresser.load(reader);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                loaded.offsets = reader.copy<T>();
             }
+            loaded.filter = reader.array<T>(loaded.n_bytes);
+            loaded.mapping = reader.mapping();
+            *this = std::move(loaded);
         }
 
         forceinline
         Vector compute_offset_vertical(const size_t index, const Vector &address) const {
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 const Vector offset = Vector(offsets[index]);
                 return offset + addresser.compute_address_vertical(index, address);
             } else {
@@ -100,7 +141,7 @@ namespace filters::bloom {
 
         forceinline
         Vector compute_offset_horizontal(const size_t index, const Vector &address) const {
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 const Vector offset = Vector::load(offsets + index);
                 return offset + addresser.compute_address_horizontal(index, address);
             } else {
@@ -108,6 +149,15 @@ namespace filters::bloom {
             }
         }
 
+        /**
+         * prefetches the block of every lane, address are the address bits of the hash as used by the counters
+         */
+        forceinline
+        void prefetch(const size_t index, const Vector &address, const typename Vector::M mask) const {
+            static constexpr size_t block_shift = math::const_log2(static_cast<size_t>(blockSize) / 8);
+            simd::prefetch(filter, compute_offset_vertical(index, address) << block_shift, mask);
+        }
+
         forceinline
         size_t size(size_t index) const {
             return addresser.get_size(index);
@@ -4,5 +4,6 @@
 #include "bloom_mask_sectorized.hpp"
 #include "bloom_mask_sectorized_vertical.hpp"
 #include "bloom_mask_grouped.hpp"
+#include "bloom_mask_counting.hpp"
 
 #include "bloom_mask_base.hpp"
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <bloom/bloom_parameter.hpp>
+#include <hash/hash.hpp>
+#include <math/math.hpp>
+#include "bloom_mask_base.hpp"
+#include "bloom_mask_blocked.hpp"
+
+namespace filters::bloom {
+
+    /**
+     * A block of blockSize bits holds blockSize / 4 counters of 4 bits. Counter i corresponds to bit i of the Blocked
+     * variant with blockSize / 4 bits, i.e., counters are selected with exactly the same hash bits. Counters saturate
+     * at 15 and saturated counters are never decremented.
+     */
+    template<Groups groups, BlockSize blockSize, size_t k, RegisterSize registerSize, SIMD _simd, size_t remaining_k, size_t _remaining_hash_bits, size_t _n_rehash,
+            typename Hasher>
+    struct BloomMask<Variant::Counting, Vectorization::Horizontal, blockSize, groups, k, registerSize, _simd,
+            remaining_k, _remaining_hash_bits, _n_rehash, Hasher> {
+
+        using Vector = simd::Vector<registerSize, _simd>;
+        using Mask = typename Vector::M;
+
+        static constexpr size_t n_lanes = Vector::n_elements;
+
+        static constexpr size_t counter_size = 4;
+        static constexpr size_t max_counter = (1 << counter_size) - 1;
+        static constexpr BlockSize bit_block_size = static_cast<BlockSize>(static_cast<size_t>(blockSize) /
+                                                                           counter_size);
+        static constexpr size_t word_size = static_cast<size_t>(registerSize);
+        static constexpr size_t counters_per_word = word_size / counter_size;
+        static constexpr size_t counter_bits = math::const_log2(counters_per_word);
+
+        static_assert(word_size <= static_cast<size_t>(bit_block_size), "Block is too small for the register size!");
+
+        using Selection = BloomMask<Variant::Blocked, Vectorization::Horizontal, bit_block_size, groups, k,
+                registerSize, _simd, remaining_k, _remaining_hash_bits, _n_rehash, Hasher>;
+        using Recursion = BloomMask<Variant::Counting, Vectorization::Horizontal, blockSize, groups, k, registerSize,
+                _simd, remaining_k - 1, Selection::remaining_hash_bits - Selection::hash_bits_per_iteration,
+                Selection::n_rehash, Hasher>;
+
+        /**
+         * returns the address of the word that holds the counter, shift is the position of the counter in the word
+         */
+        forceinline
+        static Vector select_counter(const Vector &values, Vector &hash, const Vector &offset, Vector &shift) {
+            if constexpr (_remaining_hash_bits < Selection::hash_bits_per_iteration) {
+                hash = Hasher::template rehash<_n_rehash>(hash, values);
+            }
+
+            const Vector position =
+                    (simd::extractBits(hash, Selection::hash_offset, Selection::sector_bits) << Selection::word_bits) |
+                    simd::extractBits(hash, Selection::hash_offset + Selection::sector_bits, Selection::word_bits);
+            shift = (position & Vector(counters_per_word - 1)) * Vector(counter_size);
+            return offset + (position >> counter_bits);
+        }
+
+        /**
+         * increments the counters of the key
+         */
+        forceinline
+        static void
+        generate_mask(const Vector &values, Vector &hash, void *base_address, const Vector &offset, const Mask mask) {
+            Vector shift;
+            const Vector word_address = select_counter(values, hash, offset, shift);
+
+            Vector vector = word_address.gather(base_address, mask);
+            const Mask not_saturated = ((vector >> shift) & Vector(max_counter)) != Vector(max_counter);
+            vector = vector.add_mask(Vector(1) << shift, not_saturated);
+            vector.scatter(base_address, word_address, mask);
+
+            if constexpr (remaining_k > 1) {
+                Recursion::generate_mask(values, hash, base_address, offset, mask);
+            }
+        }
+
+        /**
+         * decrements the counters of the key, none of them may be zero
+         */
+        forceinline
+        static void
+        clear_mask(const Vector &values, Vector &hash, void *base_address, const Vector &offset, const Mask mask) {
+            Vector shift;
+            const Vector word_address = select_counter(values, hash, offset, shift);
+
+            Vector vector = word_address.gather(base_address, mask);
+            const Mask not_saturated = ((vector >> shift) & Vector(max_counter)) != Vector(max_counter);
+            vector = vector.add_mask(Vector(0) - (Vector(1) << shift), not_saturated);
+            vector.scatter(base_address, word_address, mask);
+
+            if constexpr (remaining_k > 1) {
+                Recursion::clear_mask(values, hash, base_address, offset, mask);
+            }
+        }
+
+        forceinline
+        static Mask check_mask(const Vector &values, Vector &hash, const void *base_address, const Vector &offset,
+                               const Mask mask) {
+            Vector shift;
+            const Vector word_address = select_counter(values, hash, offset, shift);
+
+            const Vector vector = word_address.gather(base_address, mask);
+            const Mask found = ((vector >> shift) & Vector(max_counter)) != Vector(0);
+
+            if constexpr (remaining_k > 1) {
+                if constexpr ((remaining_k - 1) % 8 == 0) {
+                    if (found == 0) {
+                        return 0;
+                    }
+                }
+
+                return found & Recursion::check_mask(values, hash, base_address, offset, mask);
+            } else {
+                return mask & found;
+            }
+        }
+    };
+
+} // filters::bloom
@@ -28,8 +28,9 @@
 #define unlikely(expr) __builtin_expect((expr), 0)
 #endif
 
+// may_alias: stores through unaligned must not be reordered with loads of the same bytes through other types
 template<class T>
-struct [[gnu::packed]] unaligned {
+struct [[gnu::packed, gnu::may_alias]] unaligned {
 	    T value;
 };
 
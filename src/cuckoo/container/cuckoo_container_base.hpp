@@ -8,7 +8,7 @@ namespace filters::cuckoo {
     // thread local random number generator to avoid cache evictions
     static thread_local KnuthLCG rng{};
 
-    template<bool /*retry*/, Variant, size_t /*associativity*/, size_t /*buckets_per_block*/, size_t /*ota_size*/, size_t /*k*/, parameter::Partitioning, parameter::RegisterSize, parameter::SIMD, parameter::AddressingMode, parameter::HashingMode>
+    template<bool /*retry*/, Variant, size_t /*associativity*/, size_t /*buckets_per_block*/, size_t /*ota_size*/, size_t /*k*/, parameter::Partitioning, parameter::RegisterSize, parameter::SIMD, parameter::AddressingMode, parameter::HashingMode, size_t /*bfs_depth*/ = 0>
     struct CuckooContainer {
     };
 
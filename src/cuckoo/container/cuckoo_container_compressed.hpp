@@ -5,19 +5,21 @@
 #include <cstring>
 #include <partition/partition_set.hpp>
 #include <simd/helper.hpp>
+#include <simd/prefetch.hpp>
 #include <cuckoo/cuckoo_parameter.hpp>
 #include <math/math.hpp>
 #include <parameter/parameter.hpp>
 #include <random/random.hpp>
+#include <serialize/serializer.hpp>
 #include <simd/vector_div.hpp>
 #include "cuckoo_container_base.hpp"
 #include "cuckoo_helper.hpp"
 
 namespace filters::cuckoo {
 
-    template<size_t associativity, size_t buckets_per_block, size_t ota_size, size_t k, parameter::Partitioning partitioning, parameter::RegisterSize registerSize, parameter::SIMD simd, parameter::AddressingMode addressingMode, parameter::HashingMode hashingMode>
+    template<size_t associativity, size_t buckets_per_block, size_t ota_size, size_t k, parameter::Partitioning partitioning, parameter::RegisterSize registerSize, parameter::SIMD simd, parameter::AddressingMode addressingMode, parameter::HashingMode hashingMode, size_t bfs_depth>
     struct CuckooContainer<false, Variant::Morton, associativity, buckets_per_block, ota_size, k, partitioning,
-            registerSize, simd, addressingMode, hashingMode> {
+            registerSize, simd, addressingMode, hashingMode, bfs_depth> {
 
         using Vector = simd::Vector<registerSize, simd>;
         using T = typename Vector::T;
@@ -71,12 +73,16 @@ namespace filters::cuckoo {
         uint8_t *filter;
         size_t n_bytes{0};
         T *offsets;
+        memory::AllocationPolicy policy;
+        // set if the filter is used in place from a mapped file
+        std::shared_ptr<serialize::MappedFile> mapping;
 
         CuckooContainer() : filter(nullptr), offsets(nullptr) {
         }
 
         explicit CuckooContainer(CuckooContainer &&other) : addresser(std::move(other.addresser)), filter(other.filter),
-                                                            n_bytes(other.n_bytes), offsets(other.offsets) {
+                                                            n_bytes(other.n_bytes), offsets(other.offsets),
+                                                            policy(other.policy), mapping(std::move(other.mapping)) {
             other.filter = nullptr;
             other.offsets = nullptr;
         }
@@ -86,14 +92,16 @@ namespace filters::cuckoo {
                 if (offsets) {
                     free(offsets);
                 }
-                if (filter) {
-                    simd::vfree(filter, n_bytes, true);
+                if (filter and n_bytes > 0 and not mapping) {
+                    simd::vfree(filter, n_bytes, policy);
                 }
 
                 addresser = std::move(other.addresser);
                 filter = other.filter;
                 n_bytes = other.n_bytes;
                 offsets = other.offsets;
+                policy = other.policy;
+                mapping = std::move(other.mapping);
 
                 other.filter = nullptr;
                 other.offsets = nullptr;
@@ -101,7 +109,8 @@ namespace filters::cuckoo {
             return *this;
         }
 
-        CuckooContainer(size_t s, size_t n_partitions, const T *histogram) {
+        CuckooContainer(size_t s, size_t n_partitions, const T *histogram,
+                        const memory::AllocationPolicy &policy = {}) : policy(policy) {
             rng.reset();
             // number of buckets per partition
             T *h = new T[n_partitions];
@@ -114,7 +123,7 @@ namespace filters::cuckoo {
             delete[](h);
 
             T last_offset = 0;
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 offsets = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)));
                 for (size_t i = 0; i < n_partitions; i++) {
                     size_t n_buckets = this->addresser.get_size(i);
@@ -131,7 +140,7 @@ namespace filters::cuckoo {
 
             n_bytes = simd::valign<Vector>(last_offset);
             if (n_bytes > 0) {
-                filter = reinterpret_cast<uint8_t *>(simd::valloc<Vector>(n_bytes, 0, true));
+                filter = reinterpret_cast<uint8_t *>(simd::valloc<Vector>(n_bytes, 0, policy));
             }
         }
 
@@ -142,18 +151,52 @@ namespace filters::cuckoo {
             addresser = std::move(Addresser(&histogram, 1));
         }
 
+        /**
+         * copies other into memory allocated with policy, e.g., a replica on another node
+         */
+        CuckooContainer(const CuckooContainer &other, const size_t n_partitions, const memory::AllocationPolicy &policy)
+                : addresser(other.addresser.copy(n_partitions)), filter(nullptr), n_bytes(other.n_bytes),
+                  offsets(nullptr), policy(policy) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                offsets = simd::vcopy<Vector>(other.offsets, n_partitions * sizeof(T));
+            }
+            if (n_bytes > 0) {
+                filter = reinterpret_cast<uint8_t *>(simd::valloc<Vector>(n_bytes, 0, policy));
+                std::memcpy(filter, other.filter, n_bytes);
+            }
+        }
+
         ~CuckooContainer() {
             if (offsets) {
                 free(offsets);
             }
-            if (filter and n_bytes > 0) {
-                simd::vfree(filter, n_bytes, true);
+            if (filter and n_bytes > 0 and not mapping) {
+                simd::vfree(filter, n_bytes, policy);
             }
         }
 
+        void save(serialize::Writer &writer, const size_t n_partitions) const {
+            addresser.save(writer, n_partitions);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                writer.array(offsets, n_partitions * sizeof(T));
+            }
+            writer.array(filter, n_bytes);
+        }
+
+        void load(serialize::Reader &reader) {
+            CuckooContainer loaded;
+            loaded.addresser.load(reader);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                loaded.offsets = reader.copy<T>();
+            }
+            loaded.filter = reader.array<uint8_t>(loaded.n_bytes);
+            loaded.mapping = reader.mapping();
+            *this = std::move(loaded);
+        }
+
         forceinline
         Vector offset_vertical(const size_t index) const {
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 return Vector(offsets[index]);
             } else {
                 return Vector(0);
@@ -162,7 +205,7 @@ namespace filters::cuckoo {
 
         forceinline
         Vector offset_horizontal(const size_t index) const {
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 return Vector::load(offsets + index);
             } else {
                 return Vector(0);
@@ -350,7 +393,8 @@ namespace filters::cuckoo {
                         mask).vector;
                 PartialBucket partialBucket_mask;
                 const size_t shift_factor = slots_to_load + i - slot_count.vector;
-                if (slots_to_load * k == register_size) {
+                // an empty bucket shifts by the full width of PartialBucket, a single shift would keep the mask
+                if constexpr (slots_to_load * k == sizeof(PartialBucket) * 8) {
                     partialBucket_mask = (bucket_mask >> shift_factor) >> (shift_factor * (k - 1));
                 } else {
                     partialBucket_mask = bucket_mask >> (shift_factor * k);
@@ -497,6 +541,26 @@ namespace filters::cuckoo {
             set_slot_count(bucket_index, block_offset_in_bits, slot_count + Vector(1), true);
         }
 
+        /**
+         * removes the fingerprint from the bucket, the following slots of the block close the gap and the last
+         * occupied slot is cleared
+         */
+        forceinline
+        bool bucket_remove(const Vector &fingerprint, const Vector &bucket_index, const Vector &block_offset_in_bits) {
+            const Vector slot_offset = get_slot_offset(bucket_index, block_offset_in_bits, true);
+            const Vector slot_count = get_slot_count(bucket_index, block_offset_in_bits, true);
+
+            for (size_t slot = slot_offset.vector; slot < (slot_offset + slot_count).vector; slot++) {
+                if (read_fingerprint(Vector(slot), block_offset_in_bits).vector == fingerprint.vector) {
+                    shift_slots_right_and_insert(Vector(0), Vector(slot),
+                            get_occupied_slots(block_offset_in_bits, true), block_offset_in_bits);
+                    set_slot_count(bucket_index, block_offset_in_bits, slot_count - Vector(1), true);
+                    return true;
+                }
+            }
+            return false;
+        }
+
         forceinline
         M contains(const Vector &value, const size_t index, const M mask) const {
             const Vector hash = Hasher::hash(value);
@@ -529,6 +593,26 @@ namespace filters::cuckoo {
             }
         }
 
+        /**
+         * prefetches both candidate blocks of every lane, the second block is prefetched even if the overflow
+         * tracking array would allow to skip it
+         */
+        forceinline
+        void prefetch(const Vector &value, const size_t index, const M mask) const {
+            const Vector hash = Hasher::hash(value);
+            const Vector fingerprint = morton_fingerprint<k>(addresser, hash);
+            const Vector offset = offset_vertical(index);
+            const Vector address1 = addresser.compute_address_vertical(index, simd::extractAddressBits(hash));
+            const Vector address2 = addresser.compute_alternative_address_vertical(index, address1, fingerprint);
+
+            Vector block_address1, bucket_index1, block_address2, bucket_index2;
+            split_address<buckets_per_block>(address1, block_address1, bucket_index1);
+            split_address<buckets_per_block>(address2, block_address2, bucket_index2);
+
+            simd::prefetch(filter, offset + block_address1 * Vector(block_size / 8), mask);
+            simd::prefetch(filter, offset + block_address2 * Vector(block_size / 8), mask);
+        }
+
         forceinline
         bool evict_victim(const size_t index, Vector &address, Vector &bucket_index, Vector &block_offset_in_bits,
                           Vector &slot_count, Vector &occupied_slots, const Vector slot_offset, Vector &fingerprint,
@@ -650,6 +734,116 @@ namespace filters::cuckoo {
             }
         }
 
+        /**
+         * moves fingerprint victim out of bucket source and fingerprint into bucket target, both buckets are in the
+         * same block. If they differ, the victim's slot is handed over to target by shifting the slots in between.
+         */
+        forceinline
+        Vector move_fingerprint(const Vector &target, const Vector &source, const Vector &victim,
+                                const Vector &fingerprint, const Vector &offset) {
+            Vector bucket_index, block_offset_in_bits, slot_count, occupied_slots;
+            is_free(target, bucket_index, block_offset_in_bits, slot_count, occupied_slots, offset);
+
+            Vector source_block_address, source_bucket_index;
+            split_address<buckets_per_block>(source, source_block_address, source_bucket_index);
+            const Vector source_slot_count = get_slot_count(source_bucket_index, block_offset_in_bits, true);
+            Vector slot_index = get_slot_offset(source_bucket_index, block_offset_in_bits, true);
+            while (read_fingerprint(slot_index, block_offset_in_bits).vector != victim.vector) {
+                slot_index = slot_index + Vector(1);
+            }
+
+            if (source.vector == target.vector) {
+                set_fingerprint(slot_index, block_offset_in_bits, fingerprint);
+                set_ota(source_bucket_index, block_offset_in_bits, true);
+                return victim;
+            }
+
+            const Vector slot_offset = get_slot_offset(bucket_index, block_offset_in_bits, true);
+            if (slot_index.vector < slot_offset.vector) {
+                shift_slots_right_and_insert(fingerprint, slot_index, slot_offset, block_offset_in_bits);
+            } else {
+                shift_slots_left_and_insert(fingerprint, slot_offset + slot_count, slot_index, block_offset_in_bits);
+            }
+            set_slot_count(bucket_index, block_offset_in_bits, slot_count + Vector(1), true);
+            set_slot_count(source_bucket_index, block_offset_in_bits, source_slot_count - Vector(1), true);
+            set_ota(source_bucket_index, block_offset_in_bits, true);
+            return victim;
+        }
+
+        /**
+         * bounded breadth-first search for a bucket with a free slot in a block with a free slot (scalar only). A
+         * full bucket passes on one of its fingerprints, a bucket in a full block passes on any fingerprint of its
+         * block. Moves within a block shift the slots, thus moved fingerprints are identified by value. Nothing is
+         * moved before a path to a free bucket is known.
+         */
+        forceinline
+        bool insert_bfs(const size_t index, const Vector &fingerprint, const Vector &address1,
+                        const Vector &address2, const Vector &offset) {
+            BFSState<T> &bfs = bfs_state<T>;
+            bfs.reset();
+            bfs.push_root(address1.vector);
+            bfs.push_root(address2.vector);
+
+            Vector bucket_index, block_offset_in_bits, slot_count, occupied_slots;
+            for (uint32_t node = 0; node < bfs.n_nodes and bfs.nodes[node].depth < bfs_depth; node++) {
+                const Vector address = Vector(bfs.nodes[node].address);
+                is_free(address, bucket_index, block_offset_in_bits, slot_count, occupied_slots, offset);
+
+                const bool bucket_full = slot_count.vector == slots_per_bucket;
+                const size_t first = bucket_full ? bucket_index.vector : 0;
+                const size_t last = bucket_full ? bucket_index.vector + 1 : buckets_per_block;
+                Vector slot_index = get_slot_offset(Vector(first), block_offset_in_bits, true);
+
+                for (size_t i = first; i < last; i++) {
+                    const Vector source = address - bucket_index + Vector(i);
+                    const size_t n_slots = get_slot_count(Vector(i), block_offset_in_bits, true).vector;
+                    for (size_t slot = 0; slot < n_slots; slot++, slot_index = slot_index + Vector(1)) {
+                        const Vector victim = read_fingerprint(slot_index, block_offset_in_bits);
+                        const Vector alternative = addresser.compute_alternative_address_horizontal(index, source,
+                                victim);
+                        if (not bfs.visit(alternative.vector) or
+                            bfs.conflicts(node, alternative.vector, source.vector)) {
+                            continue;
+                        }
+
+                        Vector free_bucket_index, free_block_offset_in_bits, free_slot_count, free_occupied_slots;
+                        if (is_free(alternative, free_bucket_index, free_block_offset_in_bits, free_slot_count,
+                                free_occupied_slots, offset)) {
+                            uint32_t path[bfs_depth + 1];
+                            const size_t length = bfs.path(node, path);
+
+                            Vector moved = fingerprint;
+                            for (size_t j = 0; j < length; j++) {
+                                const bool leaf = j + 1 == length;
+                                const Vector next_source = leaf
+                                                           ? source
+                                                           : Vector(bfs.nodes[path[j + 1]].source);
+                                const Vector next_victim = leaf
+                                                           ? victim
+                                                           : Vector(bfs.nodes[path[j + 1]].fingerprint);
+                                moved = move_fingerprint(Vector(bfs.nodes[path[j]].address), next_source,
+                                        next_victim, moved, offset);
+                            }
+
+                            // the free bucket may have passed on a fingerprint on the way
+                            is_free(alternative, free_bucket_index, free_block_offset_in_bits, free_slot_count,
+                                    free_occupied_slots, offset);
+                            bucket_insert(moved, free_bucket_index, free_block_offset_in_bits,
+                                    get_slot_offset(free_bucket_index, free_block_offset_in_bits, true),
+                                    free_slot_count, free_occupied_slots);
+                            return true;
+                        }
+
+                        if (not bfs.push(alternative.vector, node, source.vector, 0, victim.vector)) {
+                            return false;
+                        }
+                    }
+                }
+            }
+
+            return false;
+        }
+
         forceinline
         M insert(const Vector &hash, const Vector &offset, const size_t index) {
             if constexpr (Vector::avx) {
@@ -667,8 +861,19 @@ namespace filters::cuckoo {
                 }
 
                 set_ota(bucket_index, block_offset_in_bits, true);
+                const Vector address1 = address;
                 address = addresser.compute_alternative_address_horizontal(index, address, fingerprint);
                 bool free = is_free(address, bucket_index, block_offset_in_bits, slot_count, occupied_slots, offset);
+                if constexpr (bfs_depth > 0) {
+                    if (free) {
+                        const Vector slot_offset = get_slot_offset(bucket_index, block_offset_in_bits, true);
+                        bucket_insert(fingerprint, bucket_index, block_offset_in_bits, slot_offset, slot_count,
+                                occupied_slots);
+                        return true;
+                    }
+                    return insert_bfs(index, fingerprint, address1, address, offset);
+                }
+
                 for (size_t i = 0; i < MAX_ITERATION; i++) {
                     const Vector slot_offset = get_slot_offset(bucket_index, block_offset_in_bits, true);
                     if (free) {
@@ -695,6 +900,35 @@ namespace filters::cuckoo {
             return insert(hash, offset, index);
         }
 
+        /**
+         * removes one copy of the fingerprint of value (scalar only), the second bucket is only searched if the
+         * overflow bit of the first bucket is set. Overflow bits are never cleared, a bit is shared by several
+         * buckets and may still be needed by other keys, a stale bit only costs the lookup a second bucket.
+         */
+        forceinline
+        M remove(const Vector &value, const size_t index, const M mask) {
+            const Vector offset = offset_horizontal(index);
+            const Vector hash = Hasher::hash(value);
+            const Vector fingerprint = morton_fingerprint<k>(addresser, hash);
+            const Vector address1 = addresser.compute_address_horizontal(index, simd::extractAddressBits(hash));
+            Vector block_address1, bucket_index1;
+            split_address<buckets_per_block>(address1, block_address1, bucket_index1);
+            const Vector block_offset_in_bits1 = (offset << 3) + block_address1 * Vector(block_size);
+
+            if (bucket_remove(fingerprint, bucket_index1, block_offset_in_bits1)) {
+                return mask;
+            }
+            if (not get_ota(bucket_index1, block_offset_in_bits1, mask)) {
+                return Vector::mask(0);
+            }
+
+            const Vector address2 = addresser.compute_alternative_address_horizontal(index, address1, fingerprint);
+            Vector block_address2, bucket_index2;
+            split_address<buckets_per_block>(address2, block_address2, bucket_index2);
+            const Vector block_offset_in_bits2 = (offset << 3) + block_address2 * Vector(block_size);
+            return mask & bucket_remove(fingerprint, bucket_index2, block_offset_in_bits2);
+        }
+
         forceinline
         M construct(Vector begin, const Vector &end, const T *values, size_t index) {
             if constexpr (Vector::avx) {
@@ -14,27 +14,28 @@
 
 namespace filters::cuckoo {
 
-    template<Variant variant, size_t associativity, size_t buckets_per_block, size_t ota_size, size_t k, parameter::Partitioning partitioning, parameter::RegisterSize registerSize, parameter::SIMD simd, parameter::AddressingMode addressingMode, parameter::HashingMode hashingMode>
+    template<Variant variant, size_t associativity, size_t buckets_per_block, size_t ota_size, size_t k, parameter::Partitioning partitioning, parameter::RegisterSize registerSize, parameter::SIMD simd, parameter::AddressingMode addressingMode, parameter::HashingMode hashingMode, size_t bfs_depth>
     struct CuckooContainer<true, variant, associativity, buckets_per_block, ota_size, k, partitioning, registerSize,
-            simd, addressingMode, hashingMode> {
+            simd, addressingMode, hashingMode, bfs_depth> {
 
         using Vector = simd::Vector<registerSize, simd>;
         using T = typename Vector::T;
         using M = typename Vector::M;
 
         using Container = CuckooContainer<false, variant, associativity, buckets_per_block, ota_size, k, partitioning,
-                registerSize, simd, addressingMode, hashingMode>;
+                registerSize, simd, addressingMode, hashingMode, bfs_depth>;
 
-        static constexpr bool partitioned = partitioning == parameter::Partitioning::Enabled;
+        static constexpr bool partitioned = partitioning != parameter::Partitioning::Disabled;
 
         T *seeds;
         Container container;
         size_t s, n_partitions, n_retries{0};
 
-        // types used for fallback (always scalar)
+        // types used for fallback (always scalar, thus a vectorized container with bfs_depth > 0 retries with BFS)
         using FallbackVector = simd::Vector<registerSize, parameter::SIMD::Scalar>;
         using FallbackContainer = CuckooContainer<false, variant, associativity, buckets_per_block, ota_size, k,
-                parameter::Partitioning::Disabled, registerSize, parameter::SIMD::Scalar, addressingMode, hashingMode>;
+                parameter::Partitioning::Disabled, registerSize, parameter::SIMD::Scalar, addressingMode, hashingMode,
+                bfs_depth>;
 
         CuckooContainer() : seeds(nullptr) {
         }
@@ -62,22 +63,51 @@ namespace filters::cuckoo {
             return *this;
         }
 
-        CuckooContainer(size_t s, size_t n_partitions, const T *histogram) : container(s, n_partitions, histogram),
-                                                                             s(s), n_partitions(n_partitions) {
+        CuckooContainer(size_t s, size_t n_partitions, const T *histogram, const memory::AllocationPolicy &policy = {})
+                : container(s, n_partitions, histogram, policy), s(s), n_partitions(n_partitions) {
             seeds = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)), 0);
         }
 
+        CuckooContainer(const CuckooContainer &other, const size_t n_partitions, const memory::AllocationPolicy &policy)
+                : container(other.container, n_partitions, policy), s(other.s), n_partitions(other.n_partitions),
+                  n_retries(other.n_retries) {
+            seeds = simd::vcopy<Vector>(other.seeds, n_partitions * sizeof(T));
+        }
+
         ~CuckooContainer() {
             if (seeds) {
                 free(seeds);
             }
         }
 
+        void save(serialize::Writer &writer, const size_t n_partitions) const {
+            writer.array(seeds, n_partitions * sizeof(T));
+            writer.value(s);
+            writer.value(n_partitions);
+            writer.value(n_retries);
+            container.save(writer, n_partitions);
+        }
+
+        void load(serialize::Reader &reader) {
+            CuckooContainer loaded;
+            loaded.seeds = reader.copy<T>();
+            loaded.s = reader.value<size_t>();
+            loaded.n_partitions = reader.value<size_t>();
+            loaded.n_retries = reader.value<size_t>();
+            loaded.container.load(reader);
+            *this = std::move(loaded);
+        }
+
         forceinline
         M contains(const Vector &value, const size_t index, const M mask) const {
             return container.contains(value ^ Vector(seeds[index]), index, mask);
         }
 
+        forceinline
+        void prefetch(const Vector &value, const size_t index, const M mask) const {
+            container.prefetch(value ^ Vector(seeds[index]), index, mask);
+        }
+
         forceinline
         M insert(const Vector &value, const size_t index, const M mask) {
             return container.insert(value ^ Vector::load(seeds + index), index, mask);
@@ -5,18 +5,20 @@
 #include <cstring>
 #include <partition/partition_set.hpp>
 #include <simd/helper.hpp>
+#include <simd/prefetch.hpp>
 #include <cuckoo/cuckoo_parameter.hpp>
 #include <math/math.hpp>
 #include <parameter/parameter.hpp>
 #include <random/random.hpp>
+#include <serialize/serializer.hpp>
 #include "cuckoo_container_base.hpp"
 #include "cuckoo_helper.hpp"
 
 namespace filters::cuckoo {
 
-    template<size_t associativity, size_t k, parameter::Partitioning partitioning, parameter::RegisterSize registerSize, parameter::SIMD simd, parameter::AddressingMode addressingMode, parameter::HashingMode hashingMode>
+    template<size_t associativity, size_t k, parameter::Partitioning partitioning, parameter::RegisterSize registerSize, parameter::SIMD simd, parameter::AddressingMode addressingMode, parameter::HashingMode hashingMode, size_t bfs_depth>
     struct CuckooContainer<false, Variant::Standard, associativity, 0, 0, k, partitioning, registerSize, simd,
-            addressingMode, hashingMode> {
+            addressingMode, hashingMode, bfs_depth> {
 
         using Vector = simd::Vector<registerSize, simd>;
         using T = typename Vector::T;
@@ -55,12 +57,16 @@ namespace filters::cuckoo {
         uint8_t *filter;
         size_t n_bytes{0};
         T *offsets;
+        memory::AllocationPolicy policy;
+        // set if the filter is used in place from a mapped file
+        std::shared_ptr<serialize::MappedFile> mapping;
 
         CuckooContainer() : filter(nullptr), offsets(nullptr) {
         }
 
         explicit CuckooContainer(CuckooContainer &&other) : addresser(std::move(other.addresser)), filter(other.filter),
-                                                            n_bytes(other.n_bytes), offsets(other.offsets) {
+                                                            n_bytes(other.n_bytes), offsets(other.offsets),
+                                                            policy(other.policy), mapping(std::move(other.mapping)) {
             other.filter = nullptr;
             other.offsets = nullptr;
         }
@@ -70,14 +76,16 @@ namespace filters::cuckoo {
                 if (offsets) {
                     free(offsets);
                 }
-                if (filter) {
-                    simd::vfree(filter, n_bytes, true);
+                if (filter and n_bytes > 0 and not mapping) {
+                    simd::vfree(filter, n_bytes, policy);
                 }
 
                 addresser = std::move(other.addresser);
                 filter = other.filter;
                 n_bytes = other.n_bytes;
                 offsets = other.offsets;
+                policy = other.policy;
+                mapping = std::move(other.mapping);
 
                 other.filter = nullptr;
                 other.offsets = nullptr;
@@ -85,7 +93,8 @@ namespace filters::cuckoo {
             return *this;
         }
 
-        CuckooContainer(size_t s, size_t n_partitions, const T *histogram) {
+        CuckooContainer(size_t s, size_t n_partitions, const T *histogram,
+                        const memory::AllocationPolicy &policy = {}) : policy(policy) {
             rng.reset();
             // number of buckets per partition
             T *h = new T[n_partitions];
@@ -98,7 +107,7 @@ namespace filters::cuckoo {
             delete[](h);
 
             T last_offset = 0;
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 offsets = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)));
                 for (size_t i = 0; i < n_partitions; i++) {
                     size_t n_buckets = this->addresser.get_size(i);
@@ -121,7 +130,7 @@ namespace filters::cuckoo {
 
             n_bytes = simd::valign<Vector>(last_offset);
             if (n_bytes > 0) {
-                filter = reinterpret_cast<uint8_t *>(simd::valloc<Vector>(n_bytes + 64, 0, true));
+                filter = reinterpret_cast<uint8_t *>(simd::valloc<Vector>(n_bytes + 64, 0, policy));
             }
         }
 
@@ -132,18 +141,54 @@ namespace filters::cuckoo {
             addresser = std::move(Addresser(&histogram, 1));
         }
 
+        /**
+         * copies other into memory allocated with policy, e.g., a replica on another node
+         */
+        CuckooContainer(const CuckooContainer &other, const size_t n_partitions, const memory::AllocationPolicy &policy)
+                : addresser(other.addresser.copy(n_partitions)), filter(nullptr), n_bytes(other.n_bytes),
+                  offsets(nullptr), policy(policy) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                offsets = simd::vcopy<Vector>(other.offsets, n_partitions * sizeof(T));
+            }
+            if (n_bytes > 0) {
+                filter = reinterpret_cast<uint8_t *>(simd::valloc<Vector>(n_bytes + 64, 0, policy));
+                std::memcpy(filter, other.filter, n_bytes + 64);
+            }
+        }
+
         ~CuckooContainer() {
             if (offsets) {
                 free(offsets);
             }
-            if (filter and n_bytes > 0) {
-                simd::vfree(filter, n_bytes, true);
+            if (filter and n_bytes > 0 and not mapping) {
+                simd::vfree(filter, n_bytes, policy);
+            }
+        }
+
+        void save(serialize::Writer &writer, const size_t n_partitions) const {
+            addresser.save(writer, n_partitions);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                writer.array(offsets, n_partitions * sizeof(T));
+            }
+            writer.array(filter, n_bytes + 64);
+        }
+
+        void load(serialize::Reader &reader) {
+            CuckooContainer loaded;
+            loaded.addresser.load(reader);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                loaded.offsets = reader.copy<T>();
             }
+            loaded.filter = reader.array<uint8_t>(loaded.n_bytes);
+            // unaligned loads may touch the register after the last bucket
+            loaded.n_bytes -= 64;
+            loaded.mapping = reader.mapping();
+            *this = std::move(loaded);
         }
 
         forceinline
         Vector offset_vertical(const size_t index) const {
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 return Vector(offsets[index]);
             } else {
                 return Vector(0);
@@ -152,7 +197,7 @@ namespace filters::cuckoo {
 
         forceinline
         Vector offset_horizontal(const size_t index) const {
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 return Vector::load(offsets + index);
             } else {
                 return Vector(0);
@@ -238,6 +283,33 @@ namespace filters::cuckoo {
             }
         }
 
+        /**
+         * clears the first slot of the bucket that holds the fingerprint (scalar only)
+         */
+        forceinline
+        M bucket_remove(const Vector &fingerprint, const Vector &address, const Vector &byte_offset) {
+            if constexpr (optimal_fingerprint_size) {
+                auto *bucket = reinterpret_cast<Bucket *>(filter + byte_offset.vector +
+                                                          address.vector * bits_per_bucket / 8);
+                const Bucket match = has_value<k, slots_per_bucket>(reinterpret_cast<unaligned<T> *>(bucket)->value,
+                        fingerprint.vector);
+                if (match > 0) {
+                    reinterpret_cast<Fingerprint *>(bucket)[simd::tzcount(match) / k] = 0;
+                    return Vector::mask(1);
+                }
+                return Vector::mask(0);
+            } else {
+                Bucket bucket = simd::gatheru_bits<bits_per_bucket>(address, filter, byte_offset, true).vector;
+                const Bucket match = has_value<k, slots_per_bucket>(bucket, fingerprint.vector);
+                if (match > 0) {
+                    bucket &= ~(fingerprint_mask << simd::tzcount(match));
+                    simd::scatteru_bits<bits_per_bucket>(address, filter, byte_offset, Vector(bucket), true);
+                    return Vector::mask(1);
+                }
+                return Vector::mask(0);
+            }
+        }
+
         forceinline
         M contains(const Vector &value, const size_t index, const M mask) const {
             const Vector hash = Hasher::hash(value);
@@ -250,6 +322,50 @@ namespace filters::cuckoo {
                            bucket_contains(fingerprint, address2, offset, mask));
         }
 
+        /**
+         * prefetches both candidate buckets of every lane
+         */
+        forceinline
+        void prefetch(const Vector &value, const size_t index, const M mask) const {
+            const Vector hash = Hasher::hash(value);
+            const Vector fingerprint = cuckoo_fingerprint<k>(addresser, hash);
+            const Vector offset = offset_vertical(index);
+            const Vector address1 = addresser.compute_address_vertical(index, simd::extractAddressBits(hash));
+            const Vector address2 = addresser.compute_alternative_address_vertical(index, address1, fingerprint);
+
+            simd::prefetch(filter, offset + ((address1 * Vector(bits_per_bucket)) >> 3), mask);
+            simd::prefetch(filter, offset + ((address2 * Vector(bits_per_bucket)) >> 3), mask);
+        }
+
+        /**
+         * replaces the fingerprint in slot of the bucket and returns the replaced fingerprint, the fingerprint is
+         * only read if write is false
+         */
+        template<bool write = true>
+        forceinline
+        Vector swap_slot(const Vector &address, const Vector &slot_index, const Vector &fingerprint,
+                         const Vector &byte_offset, const M mask) {
+            Vector slot;
+
+            if constexpr (not Vector::avx and optimal_fingerprint_size) {
+                auto *bucket = reinterpret_cast<Bucket *>(filter + byte_offset.vector +
+                                                          address.vector * bits_per_bucket / 8);
+                slot.vector = reinterpret_cast<Fingerprint *>(bucket)[slot_index.vector];
+                if constexpr (write) {
+                    reinterpret_cast<Fingerprint *>(bucket)[slot_index.vector] = fingerprint.vector;
+                }
+            } else {
+                const Vector bit_address =
+                        Vector(byte_offset << 3) + address * Vector(bits_per_bucket) + slot_index * Vector(k);
+                slot = simd::_gatheru_bits<k, false>(bit_address, filter, mask);
+                if constexpr (write) {
+                    simd::_scatteru_bits<k, false>(bit_address, filter, fingerprint, mask);
+                }
+            }
+
+            return slot;
+        }
+
         forceinline
         void evict_victim(const size_t index, Vector &address, Vector &fingerprint, const Vector &byte_offset,
                           const M mask) {
@@ -260,22 +376,71 @@ namespace filters::cuckoo {
                 // compiler should optimize the division
                 random_index = Vector(rng.rand<32>() % slots_per_bucket);
             }
-            Vector slot;
 
-            if constexpr (not Vector::avx and optimal_fingerprint_size) {
-                auto *bucket = reinterpret_cast<Bucket *>(filter + byte_offset.vector +
-                                                          address.vector * bits_per_bucket / 8);
-                slot.vector = reinterpret_cast<Fingerprint *>(bucket)[random_index.vector];
-                reinterpret_cast<Fingerprint *>(bucket)[random_index.vector] = fingerprint.vector;
+            const Vector slot = swap_slot(address, random_index, fingerprint, byte_offset, mask);
+            address = addresser.compute_alternative_address_horizontal(index, address, slot);
+            fingerprint = slot;
+        }
+
+        forceinline
+        bool bucket_free(const Vector &address, const Vector &byte_offset) const {
+            if constexpr (optimal_fingerprint_size) {
+                auto *bucket = reinterpret_cast<T *>(filter + byte_offset.vector +
+                                                     address.vector * bits_per_bucket / 8);
+                return has_zero<k, slots_per_bucket>(reinterpret_cast<unaligned<T> *>(bucket)->value) != 0;
             } else {
-                const Vector bit_address =
-                        Vector(byte_offset << 3) + address * Vector(bits_per_bucket) + random_index * Vector(k);
-                slot = simd::_gatheru_bits<k, false>(bit_address, filter, mask);
-                simd::_scatteru_bits<k, false>(bit_address, filter, fingerprint, mask);
+                const T bucket = simd::gatheru_bits<bits_per_bucket>(address, filter, byte_offset, true).vector;
+                return has_zero<k, slots_per_bucket>(bucket) != 0;
             }
+        }
 
-            address = addresser.compute_alternative_address_horizontal(index, address, slot);
-            fingerprint = slot;
+        /**
+         * bounded breadth-first search for a free slot (scalar only), the search starts at both candidate buckets,
+         * which are full. Fingerprints are only moved once the shortest path to a free bucket is known, thus a failed
+         * insert leaves the filter unchanged.
+         */
+        forceinline
+        bool insert_bfs(const size_t index, const Vector &fingerprint, const Vector &address1,
+                        const Vector &address2, const Vector &offset) {
+            BFSState<T> &bfs = bfs_state<T>;
+            bfs.reset();
+            bfs.push_root(address1.vector);
+            bfs.push_root(address2.vector);
+
+            for (uint32_t node = 0; node < bfs.n_nodes and bfs.nodes[node].depth < bfs_depth; node++) {
+                const Vector address = Vector(bfs.nodes[node].address);
+                for (size_t slot = 0; slot < slots_per_bucket; slot++) {
+                    const Vector victim = swap_slot<false>(address, Vector(slot), Vector(0), offset, true);
+                    const Vector alternative = addresser.compute_alternative_address_horizontal(index, address,
+                            victim);
+                    if (not bfs.visit(alternative.vector) or
+                        bfs.conflicts(node, alternative.vector, address.vector)) {
+                        continue;
+                    }
+
+                    if (bucket_free(alternative, offset)) {
+                        uint32_t path[bfs_depth + 1];
+                        const size_t length = bfs.path(node, path);
+
+                        // every fingerprint on the path moves one bucket further, the last one to the free bucket
+                        Vector moved = fingerprint;
+                        for (size_t i = 0; i < length; i++) {
+                            const size_t next_slot = (i + 1 < length)
+                                                     ? bfs.nodes[path[i + 1]].slot
+                                                     : slot;
+                            moved = swap_slot(Vector(bfs.nodes[path[i]].address), Vector(next_slot), moved, offset,
+                                    true);
+                        }
+                        return bucket_insert(moved, alternative, offset, true);
+                    }
+
+                    if (not bfs.push(alternative.vector, node, address.vector, slot, 0)) {
+                        return false;
+                    }
+                }
+            }
+
+            return false;
         }
 
         forceinline
@@ -291,6 +456,11 @@ namespace filters::cuckoo {
             }
 
             Vector address2 = addresser.compute_alternative_address_horizontal(index, address1, fingerprint);
+            if constexpr (bfs_depth > 0 and not Vector::avx) {
+                return bucket_insert(fingerprint, address2, offset, mask) or
+                       insert_bfs(index, fingerprint, address1, address2, offset);
+            }
+
             for (size_t i = 0; i < MAX_ITERATION; i++) {
                 inserted |= bucket_insert(fingerprint, address2, offset, todo);
                 todo = mask & ~inserted;
@@ -312,6 +482,24 @@ namespace filters::cuckoo {
             return insert(hash, offset, index, mask);
         }
 
+        /**
+         * removes one copy of the fingerprint of value from its candidate buckets (scalar only), value has to be
+         * inserted before, otherwise the fingerprint of another key may be removed
+         */
+        forceinline
+        M remove(const Vector &value, const size_t index, const M mask) {
+            const Vector offset = offset_horizontal(index);
+            const Vector hash = Hasher::hash(value);
+            const Vector fingerprint = cuckoo_fingerprint<k>(addresser, hash);
+            const Vector address1 = addresser.compute_address_horizontal(index, simd::extractAddressBits(hash));
+            if (bucket_remove(fingerprint, address1, offset)) {
+                return mask;
+            }
+
+            const Vector address2 = addresser.compute_alternative_address_horizontal(index, address1, fingerprint);
+            return mask & bucket_remove(fingerprint, address2, offset);
+        }
+
         forceinline
         M construct(Vector begin, const Vector &end, const T *values, size_t index) {
             rng.reset();
@@ -1,12 +1,115 @@
 #pragma once
 
+#include <algorithm>
 #include <compiler/compiler_hints.hpp>
 #include <simd/vector_div.hpp>
 #include <cstddef>
+#include <cstdint>
 
 namespace filters::cuckoo {
 
     static constexpr size_t MAX_ITERATION = 1000;
+    static constexpr size_t MAX_BFS_NODES = 4096;
+
+    /**
+     * state of a breadth-first eviction search. Every node is a bucket that is reached by moving a fingerprint out of
+     * the source bucket (the parent bucket or, for blocked buckets, a bucket in the same block) to its alternative
+     * bucket. Visited buckets are remembered in a small direct-mapped cache, a conflict in the cache only causes a
+     * bucket to be searched twice.
+     */
+    template<typename T>
+    struct BFSState {
+        static constexpr uint32_t root = UINT32_MAX;
+        static constexpr size_t n_cached = 1024;
+
+        struct Node {
+            T address;
+            T source;
+            uint32_t parent;
+            uint32_t depth;
+            uint32_t slot;
+            uint32_t fingerprint;
+        };
+
+        Node nodes[MAX_BFS_NODES];
+        size_t n_nodes{0};
+
+        T cached[n_cached];
+        uint32_t epochs[n_cached]{};
+        uint32_t epoch{0};
+
+        forceinline
+        void reset() {
+            n_nodes = 0;
+            if (++epoch == 0) {
+                std::fill(epochs, epochs + n_cached, 0);
+                epoch = 1;
+            }
+        }
+
+        /**
+         * returns false if the bucket has been visited before
+         */
+        forceinline
+        bool visit(const T address) {
+            const size_t i = (static_cast<uint64_t>(address) * 0x9e3779b97f4a7c15ull) >> 54;
+            if (epochs[i] == epoch and cached[i] == address) {
+                return false;
+            }
+            epochs[i] = epoch;
+            cached[i] = address;
+            return true;
+        }
+
+        /**
+         * a path must neither pass a bucket twice nor take two fingerprints from the same bucket, otherwise it would
+         * move a fingerprint that has been moved already
+         */
+        forceinline
+        bool conflicts(uint32_t node, const T address, const T source) const {
+            for (; node != root; node = nodes[node].parent) {
+                if (nodes[node].address == address or
+                    (nodes[node].parent != root and nodes[node].source == source)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        forceinline
+        void push_root(const T address) {
+            if (visit(address)) {
+                nodes[n_nodes++] = {address, address, root, 0, 0, 0};
+            }
+        }
+
+        forceinline
+        bool push(const T address, const uint32_t parent, const T source, const uint32_t slot,
+                  const uint32_t fingerprint) {
+            if (n_nodes == MAX_BFS_NODES) {
+                return false;
+            }
+            nodes[n_nodes++] = {address, source, parent, nodes[parent].depth + 1, slot, fingerprint};
+            return true;
+        }
+
+        /**
+         * collects the nodes from the root to node, returns the length of the path
+         */
+        forceinline
+        size_t path(uint32_t node, uint32_t *p) const {
+            size_t length = 0;
+            for (; node != root; node = nodes[node].parent) {
+                p[length++] = node;
+            }
+            std::reverse(p, p + length);
+            return length;
+        }
+    };
+
+    // thread local to avoid allocations per insert, the nodes of one search take up to 128 KiB
+    template<typename T>
+    static thread_local BFSState<T> bfs_state{};
 
     template<size_t k, typename Addresser, typename Vector>
     forceinline
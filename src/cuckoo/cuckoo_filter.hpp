@@ -1,42 +1,58 @@
 #pragma once
 
 #include <iostream>
+#include <vector>
 #include <bloom/container/bloom_container.hpp>
 #include <bloom/construct/bloom_construct.hpp>
 #include <bloom/count/bloom_count.hpp>
 #include <filter_base.hpp>
 #include <address/addresser.hpp>
 #include <cuckoo/container/cuckoo_container.hpp>
+#include <partition/partition_chunk.hpp>
+#include <task/interleaved_lookup.hpp>
 
 namespace filters {
 
     template<typename FilterParameter, size_t _k, typename OptimizationParameter>
-    struct Filter<FilterType::Cuckoo, FilterParameter, _k, OptimizationParameter> {
+    struct Filter<FilterType::Cuckoo, FilterParameter, _k, OptimizationParameter>
+            : FilterBase<Filter<FilterType::Cuckoo, FilterParameter, _k, OptimizationParameter>,
+                    OptimizationParameter> {
 
         using FP = FilterParameter;
         static constexpr size_t k = _k;
         using OP = OptimizationParameter;
-        static constexpr bool retry = OP::partitioning == parameter::Partitioning::Enabled or
+        static constexpr bool retry = OP::partitioning != parameter::Partitioning::Disabled or
                                       (FP::variant == cuckoo::Variant::Morton and OP::simd != parameter::SIMD::Scalar);
         static constexpr bool supports_add = OP::simd == parameter::SIMD::Scalar and not retry;
         static constexpr bool supports_add_partition = supports_add;
+        // the random walk drops the last victim if it fails, the bounded BFS only moves keys once it found a free slot
+        static constexpr bool supports_failsafe_add = supports_add and FP::bfs_depth > 0;
+        static constexpr bool supports_remove = supports_add;
 
         using Vector = simd::Vector<OP::registerSize, OP::simd>;
         using T = typename Vector::T;
         using M = typename Vector::M;
+        using Base = FilterBase<Filter, OptimizationParameter>;
+        using Base::local_container;
+        using Base::replicate;
         using Container = cuckoo::CuckooContainer<retry, FP::variant, FP::associativity, FP::buckets_per_block,
-                FP::ota_size, k, OP::partitioning, OP::registerSize, OP::simd, OP::addressingMode, OP::hashingMode>;
+                FP::ota_size, k, OP::partitioning, OP::registerSize, OP::simd, OP::addressingMode, OP::hashingMode,
+                FP::bfs_depth>;
         using PartitionSet = typename partition::PartitionSet<OP::partitioning, Vector>;
+        using BuildPartitionSet = typename partition::PartitionSet<OP::partitioning, Vector, OP::deduplication>;
 
         size_t s;
         size_t n_partitions;
         Container container;
         task::TaskQueue<OP::multiThreading> queue;
-
-        Filter(size_t s, size_t n_partitions, size_t n_threads, size_t n_tasks_per_level) : s(s),
-                                                                                            n_partitions(n_partitions),
-                                                                                            queue(n_threads,
-                                                                                                    n_tasks_per_level) {
+        memory::AllocationPolicy policy;
+        std::vector<Container> replicas;
+        // lookahead of unpartitioned lookups in vectors, 0 disables software prefetching
+        size_t prefetch_distance{0};
+
+        Filter(size_t s, size_t n_partitions, size_t n_threads, size_t n_tasks_per_level,
+               const memory::AllocationPolicy &policy = {}) : s(s), n_partitions(n_partitions),
+                                                              queue(n_threads, n_tasks_per_level), policy(policy) {
         }
 
         forceinline
@@ -44,20 +60,22 @@ namespace filters {
             static_assert(supports_add, "not supported!");
 
             n_partitions = std::max(n_partitions, 1ul);
-            container = std::move(Container(s, n_partitions, histogram));
+            container = std::move(Container(s, n_partitions, histogram, policy));
+            replicas.clear();
+            prefetch_distance = simd::prefetch_distance(size());
         }
 
         forceinline
         bool contains(const T &value) const {
-            return contains(value, value & (n_partitions - 1));
+            return contains(value, partition::partition_of<OP::partitioning>(value, n_partitions));
         }
 
         forceinline
         bool contains(const T &value, size_t index) const {
             if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
-                return container.contains(Vector(value), 0, 1);
+                return local_container().contains(Vector(value), 0, 1);
             } else {
-                return container.contains(Vector(value), index, 1);
+                return local_container().contains(Vector(value), index, 1);
             }
         }
 
@@ -69,6 +87,7 @@ namespace filters {
         forceinline
         bool add_partition(const T *values, size_t length, size_t index) {
             static_assert(supports_add, "not supported!");
+            replicas.clear();
 
             if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
                 return container.construct(Vector(0), Vector(length), values, 0);
@@ -79,12 +98,13 @@ namespace filters {
 
         forceinline
         bool add(const T &value) {
-            return add(value, value & (n_partitions - 1));
+            return add(value, partition::partition_of<OP::partitioning>(value, n_partitions));
         }
 
         forceinline
         bool add(const T &value, size_t index) {
             static_assert(supports_add, "not supported!");
+            replicas.clear();
 
             if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
                 return container.insert(Vector(value), 0, 1);
@@ -93,13 +113,52 @@ namespace filters {
             }
         }
 
+        forceinline
+        bool remove(const T &value) {
+            return remove(value, partition::partition_of<OP::partitioning>(value, n_partitions));
+        }
+
+        /**
+         * removes one copy of a key that has been added before, removing other keys may cause false negatives. Like
+         * add(), it drops the replicas.
+         */
+        forceinline
+        bool remove(const T &value, size_t index) {
+            static_assert(supports_remove, "not supported!");
+            replicas.clear();
+
+            if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
+                return container.remove(Vector(value), 0, 1);
+            } else {
+                return container.remove(Vector(value), index, 1);
+            }
+        }
+
+        /**
+         * removes one copy of every key and returns the number of removed keys, the buckets of the upcoming keys are
+         * prefetched for filters that exceed the last level cache
+         */
+        size_t remove_all(const T *values, size_t length) {
+            static_assert(supports_remove, "not supported!");
+            replicas.clear();
+
+            size_t n_removed = 0;
+            simd::prefetched<Vector>(values, length, prefetch_distance, [this](const Vector &keys, const M mask) {
+                container.prefetch(keys, 0, mask);
+            }, [&](const Vector &keys, const M mask, const size_t) {
+                n_removed += Vector::popcount_mask(container.remove(keys, 0, mask));
+            });
+            return n_removed;
+        }
+
         bool construct(T *values, size_t length) {
-            PartitionSet partitions(n_partitions);
+            replicas.clear();
+            BuildPartitionSet partitions(n_partitions);
             n_partitions = partitions.n_partitions;
 
             if constexpr (OP::multiThreading == parameter::MultiThreading::Disabled) {
                 partitions.init(values, length);
-                container = std::move(Container(s, n_partitions, partitions.histogram));
+                container = std::move(Container(s, n_partitions, partitions.histogram, policy));
 
                 bool success = true;
                 for (size_t i = 0; i < partitions.n_partitions and success; i += Vector::n_elements) {
@@ -107,12 +166,17 @@ namespace filters {
                     const Vector end = begin + Vector::load(partitions.histogram + i);
                     success &= (Vector::mask(1) == container.construct(begin, end, partitions.values, i));
                 }
+
+                prefetch_distance = simd::prefetch_distance(size());
+                if (success and policy.placement == memory::Placement::Replicated) {
+                    replicate();
+                }
                 return success;
             } else {
                 partitions.init(values, length, queue);
 
                 queue.add_task([&](size_t) {
-                    container = std::move(Container(s, n_partitions, partitions.histogram));
+                    container = std::move(Container(s, n_partitions, partitions.histogram, policy));
                 });
                 queue.add_barrier();
 
@@ -126,72 +190,30 @@ namespace filters {
                 }
                 queue.execute_tasks();
 
+                prefetch_distance = simd::prefetch_distance(size());
+                if (success and policy.placement == memory::Placement::Replicated) {
+                    replicate();
+                }
                 return success;
             }
         }
 
         forceinline
-        size_t _count(const T *begin, const T *end, size_t i) const {
-            size_t counter = 0;
-            for (; begin + Vector::n_elements <= end; begin += Vector::n_elements) {
-                const Vector values = Vector::load(begin);
-                counter += Vector::popcount_mask(container.contains(values, i, Vector::mask(1)));
-            }
-
-            if constexpr (Vector::avx) {
-                if (begin < end) {
-                    M mask = (1 << (end - begin)) - 1;
-                    const Vector values = Vector::load(begin);
-                    counter += Vector::popcount_mask(container.contains(values, i, mask));
-                }
-            }
-
-            return counter;
+        M _contains(const Container &local, const Vector &keys, const M mask, const size_t index) const {
+            return local.contains(keys, index, mask);
         }
 
-        size_t count(T *values, size_t length) {
-            PartitionSet partitions(n_partitions);
-            if constexpr (OP::multiThreading == parameter::MultiThreading::Disabled) {
-                partitions.init(values, length);
-                size_t counter = 0;
-
-                for (size_t i = 0; i < partitions.n_partitions; i += 1) {
-                    const T *begin = partitions.values + partitions.offsets[i];
-                    const T *end = begin + partitions.histogram[i];
-
-                    counter += _count(begin, end, i);
-                }
-
-                return counter;
-            } else {
-                partitions.init(values, length, queue);
-
-                std::atomic<size_t> counter{0};
-                size_t remaining_tasks = queue.get_n_tasks_per_level();
-                for (size_t i = 0; i < partitions.n_partitions; i++) {
-                    // add at least one task
-                    size_t n_tasks = 1;
-                    if (remaining_tasks > 0) {
-                        n_tasks = std::max(remaining_tasks / (partitions.n_partitions - i), static_cast<size_t>(1));
-                        remaining_tasks -= n_tasks;
-                    }
-
-                    for (size_t j = 0; j < n_tasks; j++) {
-                        queue.add_task([this, &counter, &partitions, i, j, n_tasks](size_t) {
-                            const size_t length = partitions.histogram[i];
-                            const T *begin = partitions.values + partitions.offsets[i] +
-                                             simd::valign<Vector>((length / n_tasks + 1) * j);
-                            const T *end = partitions.values + partitions.offsets[i] +
-                                           std::min(simd::valign<Vector>((length / n_tasks + 1) * (j + 1)), length);
-
-                            counter += _count(begin, end, i);
-                        });
-                    }
-                }
-                queue.execute_tasks();
+        forceinline
+        void _prefetch(const Container &local, const Vector &keys, const M mask, const size_t index) const {
+            local.prefetch(keys, index, mask);
+        }
 
-                return counter;
-            }
+        /**
+         * only the layout of the standard variant is the same for every instruction set
+         */
+        static std::string signature() {
+            return "Cuckoo;" + std::to_string(k) + ";" + FP::to_string() + ";" +
+                   OP::to_string(FP::variant != cuckoo::Variant::Standard);
         }
 
         size_t size() const {
@@ -213,6 +235,7 @@ namespace filters {
             s += "\t\"avg_size\": " + std::to_string(size() * 8) + " bits,\n";
             s += "\t\"n_partitions\": " + std::to_string(n_partitions) + ",\n";
             s += "\t\"retries\": " + std::to_string(retries()) + ",\n";
+            s += "\t\"allocation\": " + policy.to_string() + ",\n";
             s += "\t\"filter_params\": " + FP::to_string() + ",\n";
             s += "\t\"optimization_params\": " + OP::to_string() + "\n";
             s += "}\n";
@@ -201,7 +201,12 @@ namespace filters::cuckoo {
         return math::align_number(k * associativity, 8ul);
     }
 
-    template<size_t k, Variant _variant, size_t _associativity, size_t _compression_ratio, size_t _ota_ratio>
+    /**
+     * bfs_depth > 0 replaces the random walk eviction by a breadth-first search for the shortest eviction path of at
+     * most bfs_depth moves, scalar inserts only
+     */
+    template<size_t k, Variant _variant, size_t _associativity, size_t _compression_ratio, size_t _ota_ratio,
+            size_t _bfs_depth = 0>
     struct CuckooFilterParameter {
         static constexpr Variant variant = (_variant == Variant::Morton or _variant == Variant::MortonOpt)
                                            ? Variant::Morton
@@ -215,6 +220,7 @@ namespace filters::cuckoo {
         static constexpr size_t buckets_per_block = optimal_buckets_per_block(k, _variant, associativity,
                 _compression_ratio, _ota_ratio);
         static constexpr size_t ota_size = optimal_ota_size(k, _variant, associativity, buckets_per_block, _ota_ratio);
+        static constexpr size_t bfs_depth = _bfs_depth;
 
         static std::string to_string() {
             std::string s_variant;
@@ -231,7 +237,8 @@ namespace filters::cuckoo {
             s += "\"variant\": \"" + s_variant + "\", ";
             s += "\"associativity\": \"" + std::to_string(associativity) + " slots\",";
             s += "\"buckets_per_block\": " + std::to_string(buckets_per_block) + ",";
-            s += "\"ota_size\": " + std::to_string(ota_size) + "}";
+            s += "\"ota_size\": " + std::to_string(ota_size) + ",";
+            s += "\"bfs_depth\": " + std::to_string(bfs_depth) + "}";
 
             return s;
         }
@@ -258,6 +265,16 @@ namespace filters::cuckoo {
     template<size_t k> using Standard8 = CuckooFilterParameter<k, Variant::Standard, 8, 0, 0>;
 
 
+    /**
+     * Cuckoo Filter with BFS eviction
+     */
+
+    template<size_t k> using CuckooOptBFS = CuckooFilterParameter<k, Variant::CuckooOpt, 0, 0, 0, 5>;
+    template<size_t k> using MortonOptBFS = CuckooFilterParameter<k, Variant::MortonOpt, 0, 0, 0, 5>;
+    template<size_t k> using Standard2BFS = CuckooFilterParameter<k, Variant::Standard, 2, 0, 0, 10>;
+    template<size_t k> using Standard4BFS = CuckooFilterParameter<k, Variant::Standard, 4, 0, 0, 5>;
+
+
     /**
      * Compressed Cuckoo Filter (Morton Filter)
      */
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <parameter/parameter.hpp>
+
+namespace filters::dispatch {
+
+    /**
+     * entry points of one filter instantiation, the filter is an opaque pointer so that the table can be passed out of
+     * a dispatch module. Filters must only be used with the table (and module) that has created them.
+     */
+    template<typename T>
+    struct Kernels {
+        void *(*create)(size_t s, size_t n_partitions, size_t n_threads, size_t n_tasks_per_level);
+        void (*destroy)(void *filter);
+        bool (*construct)(void *filter, T *values, size_t length);
+        size_t (*count)(void *filter, T *values, size_t length);
+        size_t (*probe)(const void *filter, const T *values, size_t length, uint32_t *positions);
+        size_t (*probe_bitmap)(const void *filter, const T *values, size_t length, uint64_t *bitmap);
+        void (*save)(const void *filter, const char *path);
+        void (*load)(void *filter, const char *path);
+        size_t (*size)(const void *filter);
+    };
+
+    template<typename Filter>
+    struct KernelsOf {
+        using T = typename Filter::T;
+
+        static void *create(size_t s, size_t n_partitions, size_t n_threads, size_t n_tasks_per_level) {
+            return new Filter(s, n_partitions, n_threads, n_tasks_per_level);
+        }
+
+        static void destroy(void *filter) {
+            delete static_cast<Filter *>(filter);
+        }
+
+        static bool construct(void *filter, T *values, size_t length) {
+            return static_cast<Filter *>(filter)->construct(values, length);
+        }
+
+        static size_t count(void *filter, T *values, size_t length) {
+            return static_cast<Filter *>(filter)->count(values, length);
+        }
+
+        static size_t probe(const void *filter, const T *values, size_t length, uint32_t *positions) {
+            return static_cast<const Filter *>(filter)->probe(values, length, positions);
+        }
+
+        static size_t probe_bitmap(const void *filter, const T *values, size_t length, uint64_t *bitmap) {
+            return static_cast<const Filter *>(filter)->probe_bitmap(values, length, bitmap);
+        }
+
+        static void save(const void *filter, const char *path) {
+            static_cast<const Filter *>(filter)->save(path);
+        }
+
+        static void load(void *filter, const char *path) {
+            static_cast<Filter *>(filter)->load(path);
+        }
+
+        static size_t size(const void *filter) {
+            return static_cast<const Filter *>(filter)->size();
+        }
+
+        static constexpr Kernels<T> kernels{&create, &destroy, &construct, &count, &probe, &probe_bitmap, &save, &load,
+                &size};
+    };
+
+    struct Entry {
+        const char *name;
+        size_t key_size;
+        const void *kernels;
+    };
+
+    /**
+     * table of contents of a dispatch module, simd is the instruction set the module is compiled for
+     */
+    struct Module {
+        parameter::SIMD simd;
+        size_t n_entries;
+        const Entry *entries;
+    };
+
+    /**
+     * kernels of the filter called name with keys of type T, nullptr if the module has no such filter
+     */
+    template<typename T>
+    const Kernels<T> *find(const Module &module, const std::string &name) {
+        for (size_t i = 0; i < module.n_entries; i++) {
+            const Entry &entry = module.entries[i];
+            if (name == entry.name and entry.key_size == sizeof(T)) {
+                return static_cast<const Kernels<T> *>(entry.kernels);
+            }
+        }
+        return nullptr;
+    }
+
+} // filters::dispatch
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <filter.hpp>
+#include <simd/cpu.hpp>
+#include "dispatch_kernels.hpp"
+
+/*
+ * A dispatch module is a source file that is compiled once per instruction set into a shared module (see
+ * filters_add_dispatch_module in cmake/dispatch.cmake). It lists its filters with FILTERS_DISPATCH_MODULE, their SIMD
+ * parameter should be filters::simd::compiled_simd:
+ *
+ *     using Bloom = filters::Filter<filters::FilterType::Bloom, filters::bloom::Blocked512<8>, 8,
+ *             filters::parameter::OptimizationParameter<..., filters::simd::compiled_simd, ...>>;
+ *
+ *     FILTERS_DISPATCH_MODULE(FILTERS_DISPATCH_KERNEL("bloom", Bloom))
+ *
+ * or export every filter of a catalogue (see filter_catalogue.hpp) for FilterHandle:
+ *
+ *     FILTERS_DISPATCH_CATALOGUE(filters::DefaultCatalogue<filters::parameter::RegisterSize::_32bit>)
+ *
+ * Modules are compiled with hidden visibility, thus the inline functions and template instances of every module stay
+ * local to it and code compiled for one instruction set is never linked into another one.
+ */
+
+#define FILTERS_DISPATCH_KERNEL(name, ...)                                                                            \
+    filters::dispatch::Entry{name, sizeof(typename __VA_ARGS__::T), &filters::dispatch::KernelsOf<__VA_ARGS__>::kernels}
+
+#define FILTERS_DISPATCH_MODULE(...)                                                                                  \
+    extern "C" __attribute__((visibility("default")))                                                                 \
+    const filters::dispatch::Module *filters_dispatch_module() {                                                       \
+        static const filters::dispatch::Entry entries[] = {__VA_ARGS__};                                              \
+        static const filters::dispatch::Module module{filters::simd::compiled_simd,                                   \
+                sizeof(entries) / sizeof(entries[0]), entries};                                                        \
+        return &module;                                                                                                \
+    }
+
+#define FILTERS_DISPATCH_CATALOGUE(...)                                                                               \
+    extern "C" __attribute__((visibility("default")))                                                                 \
+    const filters::dispatch::Module *filters_dispatch_module() {                                                       \
+        return &__VA_ARGS__::module();                                                                                 \
+    }
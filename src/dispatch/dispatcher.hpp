@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <dlfcn.h>
+#include <simd/cpu.hpp>
+#include "dispatch_kernels.hpp"
+
+namespace filters::dispatch {
+
+    /**
+     * loads the dispatch module of the widest instruction set the cpu supports. The modules of prefix are expected at
+     * <prefix>_avx512.so, <prefix>_avx2.so and <prefix>_scalar.so, missing ones are skipped. Filters created by the
+     * kernels must be destroyed before the dispatcher.
+     */
+    class Dispatcher {
+      private:
+        void *handle{nullptr};
+        const Module *module{nullptr};
+
+        static std::string suffix(parameter::SIMD simd) {
+            switch (simd) {
+                case parameter::SIMD::AVX512:
+                    return "_avx512.so";
+                case parameter::SIMD::AVX2:
+                    return "_avx2.so";
+                default:
+                    return "_scalar.so";
+            }
+        }
+
+      public:
+        explicit Dispatcher(const std::string &prefix) {
+            const size_t limit = static_cast<size_t>(simd::cpu_simd());
+            for (parameter::SIMD simd : {parameter::SIMD::AVX512, parameter::SIMD::AVX2, parameter::SIMD::Scalar}) {
+                if (static_cast<size_t>(simd) > limit) {
+                    continue;
+                }
+                handle = dlopen((prefix + suffix(simd)).c_str(), RTLD_NOW | RTLD_LOCAL);
+                if (handle) {
+                    break;
+                }
+            }
+            if (not handle) {
+                throw std::runtime_error{"no dispatch module of " + prefix + " runs on this cpu!"};
+            }
+
+            auto *entry = reinterpret_cast<const Module *(*)()>(dlsym(handle, "filters_dispatch_module"));
+            if (not entry) {
+                dlclose(handle);
+                throw std::runtime_error{prefix + " is not a dispatch module!"};
+            }
+            module = entry();
+        }
+
+        Dispatcher(const Dispatcher &) = delete;
+
+        Dispatcher &operator=(const Dispatcher &) = delete;
+
+        ~Dispatcher() {
+            dlclose(handle);
+        }
+
+        parameter::SIMD simd() const {
+            return module->simd;
+        }
+
+        const Module &loaded_module() const {
+            return *module;
+        }
+
+        template<typename T>
+        const Kernels<T> &kernels(const std::string &name) const {
+            const Kernels<T> *kernels = find<T>(*module, name);
+            if (not kernels) {
+                throw std::runtime_error{"dispatch module has no filter " + name + "!"};
+            }
+            return *kernels;
+        }
+    };
+
+} // filters::dispatch
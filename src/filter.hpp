@@ -7,7 +7,12 @@
  */
 #include <bloom/bloom_filter.hpp>
 #include <xor/xor_filter.hpp>
+#include <xor/xor_builder.hpp>
 #include <cuckoo/cuckoo_filter.hpp>
+#include <ribbon/ribbon_filter.hpp>
+#include <vqf/vqf_filter.hpp>
+#include <prefix/prefix_filter.hpp>
+#include <growing/growing_filter.hpp>
 
 /*
  * Reference Implementations
@@ -1,8 +1,19 @@
 #pragma once
 
-#include <parameter/parameter.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <stdexcept>
+#include <string>
+#include <parameter/parameter.hpp>
+#include <memory/allocation_policy.hpp>
+#include <partition/partition_chunk.hpp>
+#include <serialize/serializer.hpp>
+#include <simd/helper.hpp>
+#include <simd/prefetch.hpp>
 #include <simd/vector.hpp>
+#include <task/interleaved_lookup.hpp>
+#include <task/task_queue.hpp>
 
 namespace filters {
 
@@ -17,7 +28,10 @@ namespace filters {
         BSDCuckoo,
         EfficientCuckooFilter,
         AMDMortonFilter,
-        VacuumFilter
+        VacuumFilter,
+        Ribbon,
+        VectorQuotient,
+        Prefix
     };
 
     template<FilterType filter, typename FilterParameter, size_t k, typename OptimizationParameter>
@@ -71,4 +85,255 @@ namespace filters {
         }
     };
 
+    /**
+     * lookups, counts, NUMA replicas and serialization of the partitioned filters (CRTP). Derived provides the members
+     * s, n_partitions, container, replicas, queue, policy and prefetch_distance, its scalar contains(value, index) and
+     * signature(), and probes its container through _contains(local, keys, mask, index) and _prefetch(local, keys,
+     * mask, index). _count(), _save() and _load() can be hidden by Derived.
+     */
+    template<typename Derived, typename OptimizationParameter>
+    struct FilterBase {
+
+        using OP = OptimizationParameter;
+        using Vector = simd::Vector<OP::registerSize, OP::simd>;
+        using T = typename Vector::T;
+        using M = typename Vector::M;
+
+        forceinline
+        Derived &self() {
+            return static_cast<Derived &>(*this);
+        }
+
+        forceinline
+        const Derived &self() const {
+            return static_cast<const Derived &>(*this);
+        }
+
+        /**
+         * copies the filter to every NUMA node, lookups use the copy of the node they run on. Copies are dropped by
+         * every change of the filter, so the filter has to be replicated again after adding or removing keys.
+         */
+        void replicate() {
+            Derived &filter = self();
+            filter.replicas.clear();
+            const size_t n_nodes = memory::n_nodes();
+            if (n_nodes > 1) {
+                filter.replicas.reserve(n_nodes);
+                for (size_t node = 0; node < n_nodes; node++) {
+                    filter.replicas.emplace_back(filter.container, filter.n_partitions, filter.policy.on_node(node));
+                }
+            }
+        }
+
+        forceinline
+        const auto &local_container() const {
+            const Derived &filter = self();
+            return filter.replicas.empty()
+                   ? filter.container
+                   : filter.replicas[memory::current_node() % filter.replicas.size()];
+        }
+
+        forceinline
+        size_t partition_index(const T &value) const {
+            if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
+                return 0;
+            } else {
+                return partition::partition_of<OP::partitioning>(value, self().n_partitions);
+            }
+        }
+
+        /**
+         * matches of a partitioned chunk (or PartitionSet)
+         */
+        template<typename Container, typename Partitions>
+        size_t _count(const Container &local, const Partitions &partitions) const {
+            size_t counter = 0;
+            for (size_t i = 0; i < partitions.n_partitions; i++) {
+                const T *begin = partitions.values + partitions.offsets[i];
+                const T *end = begin + partitions.histogram[i];
+                for (; begin + Vector::n_elements <= end; begin += Vector::n_elements) {
+                    counter += Vector::popcount_mask(self()._contains(local, Vector::load(begin), Vector::mask(1), i));
+                }
+
+                if constexpr (Vector::avx) {
+                    if (begin < end) {
+                        const M mask = (1 << (end - begin)) - 1;
+                        counter += Vector::popcount_mask(self()._contains(local, Vector::load(begin), mask, i));
+                    }
+                }
+            }
+            return counter;
+        }
+
+        /**
+         * sums count_range(begin, n) over the input, multi-threaded filters split it into one range per task
+         */
+        template<typename CountRange>
+        size_t _count_ranges(const T *values, size_t length, CountRange &&count_range) {
+            if constexpr (OP::multiThreading == parameter::MultiThreading::Disabled) {
+                return count_range(values, length);
+            } else {
+                std::atomic<size_t> n_matches{0};
+                const size_t n_tasks = self().queue.get_n_tasks_per_level();
+                for (size_t j = 0; j < n_tasks; j++) {
+                    const size_t begin = std::min(simd::valign<Vector>((length / n_tasks + 1) * j), length);
+                    const size_t end = std::min(simd::valign<Vector>((length / n_tasks + 1) * (j + 1)), length);
+                    self().queue.add_task([&count_range, &n_matches, values, begin, end](size_t) {
+                        n_matches += count_range(values + begin, end - begin);
+                    });
+                }
+                self().queue.execute_tasks();
+
+                return n_matches;
+            }
+        }
+
+        /**
+         * counts unpartitioned filters, lookups prefetch prefetch_distance vectors ahead unless the filter fits into
+         * the cache (distance 0)
+         */
+        size_t _count_prefetched(const T *values, size_t length) {
+            return _count_ranges(values, length, [this](const T *begin, const size_t n) {
+                const Derived &filter = self();
+                const auto &local = local_container();
+                size_t n_matches = 0;
+                simd::prefetched<Vector>(begin, n, filter.prefetch_distance, [&](const Vector &keys, const M mask) {
+                    filter._prefetch(local, keys, mask, 0);
+                }, [&](const Vector &keys, const M mask, const size_t) {
+                    n_matches += __builtin_popcountll(simd::lane_mask<Vector>(filter._contains(local, keys, mask, 0)));
+                });
+                return n_matches;
+            });
+        }
+
+        /**
+         * partitions the keys chunk by chunk, so the memory of a count does not grow with the number of keys
+         */
+        size_t _count_chunked(const T *values, size_t length) {
+            using Chunk = partition::PartitionChunk<OP::partitioning, Vector>;
+            auto count = [this](const Chunk &chunk) {
+                return self()._count(local_container(), chunk);
+            };
+
+            if constexpr (OP::multiThreading == parameter::MultiThreading::Disabled) {
+                return Chunk::local(self().n_partitions).count(values, length, count);
+            } else {
+                return Chunk::count(values, length, self().n_partitions, self().queue, count);
+            }
+        }
+
+        size_t count(T *values, size_t length) {
+            if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
+                return _count_prefetched(values, length);
+            } else {
+                return _count_chunked(values, length);
+            }
+        }
+
+        /**
+         * lookup of a single key as coroutine, it prefetches the cache lines of the key and suspends before probing
+         */
+        task::Lookup lookup(const T value) const {
+            const size_t index = partition_index(value);
+            self()._prefetch(local_container(), Vector(value), 1, index);
+            co_await std::suspend_always{};
+            co_return self().contains(value, index);
+        }
+
+        /**
+         * counts with interleaved scalar lookups, every thread keeps n_in_flight lookups in flight (task::interleave)
+         */
+        size_t count_interleaved(const T *values, size_t length, size_t n_in_flight = task::default_n_in_flight) {
+            return _count_ranges(values, length, [this, n_in_flight](const T *begin, const size_t n) {
+                size_t n_matches = 0;
+                task::interleave(n, n_in_flight, [this, begin](const size_t i) {
+                    return lookup(begin[i]);
+                }, [&n_matches](const size_t, const bool found) {
+                    n_matches += found;
+                });
+                return n_matches;
+            });
+        }
+
+        template<typename Sink>
+        forceinline
+        void _probe(const T *values, size_t length, Sink &&sink) const {
+            const Derived &filter = self();
+            const auto &local = local_container();
+            auto contains = [&filter, &local](const Vector &keys, const M mask, const size_t index) {
+                return filter._contains(local, keys, mask, index);
+            };
+
+            if constexpr (OP::partitioning != parameter::Partitioning::Disabled) {
+                // partitioning reorders the input, so chunks are partitioned together with their row ids
+                partition::PartitionChunk<OP::partitioning, Vector>::local(filter.n_partitions).probe(values, length,
+                        contains, sink);
+            } else {
+                simd::prefetched<Vector>(values, length, filter.prefetch_distance,
+                        [&](const Vector &keys, const M mask) {
+                    filter._prefetch(local, keys, mask, 0);
+                }, [&](const Vector &keys, const M mask, const size_t i) {
+                    sink(simd::lane_mask<Vector>(contains(keys, mask, 0)), i);
+                });
+            }
+        }
+
+        size_t probe(const T *values, size_t length, uint32_t *positions) const {
+            size_t n_matches = 0;
+            _probe(values, length, [&](const uint64_t mask, const size_t i) {
+                n_matches += simd::compress_positions(mask, i, positions + n_matches);
+            });
+            return n_matches;
+        }
+
+        size_t probe_bitmap(const T *values, size_t length, uint64_t *bitmap) const {
+            std::memset(bitmap, 0, (length + 63) / 64 * sizeof(uint64_t));
+
+            size_t n_matches = 0;
+            _probe(values, length, [&](const uint64_t mask, const size_t i) {
+                n_matches += __builtin_popcountll(mask);
+                simd::compress_bitmap(mask, i, bitmap);
+            });
+            return n_matches;
+        }
+
+        /**
+         * state of Derived that is stored after n_partitions, e.g., statistics of the construction
+         */
+        void _save(serialize::Writer &) const {
+        }
+
+        void _load(serialize::Reader &) {
+        }
+
+        /**
+         * writes the filter to path, it can be loaded by a filter with the same parameters
+         */
+        void save(const std::string &path) const {
+            const Derived &filter = self();
+            serialize::Writer writer(path, Derived::signature());
+            writer.value(filter.s);
+            writer.value(filter.n_partitions);
+            filter._save(writer);
+            filter.container.save(writer, filter.n_partitions);
+        }
+
+        /**
+         * maps the filter stored at path, the filter data is used in place and only paged in on access
+         */
+        void load(const std::string &path) {
+            Derived &filter = self();
+            serialize::Reader reader(path, Derived::signature());
+            filter.s = reader.value<size_t>();
+            filter.n_partitions = reader.value<size_t>();
+            filter._load(reader);
+            filter.container.load(reader);
+            filter.replicas.clear();
+            if (filter.policy.placement == memory::Placement::Replicated) {
+                replicate();
+            }
+            filter.prefetch_distance = simd::prefetch_distance(filter.size());
+        }
+    };
+
 } // filters
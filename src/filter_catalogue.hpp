@@ -0,0 +1,155 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <filter.hpp>
+#include <filter_handle.hpp>
+#include <simd/cpu.hpp>
+#include <dispatch/dispatch_kernels.hpp>
+
+namespace filters {
+
+    namespace catalogue {
+
+        /**
+         * variant of a catalogue, instantiated for every k of ks. Subtypes name the variant for FilterConfig and may set
+         * deduplicate to instantiate it with deduplication as well, catalogues with registers narrower than
+         * register_size skip the variant.
+         */
+        template<FilterType _type, template<size_t> typename _FP, size_t ..._ks>
+        struct Variant {
+            static constexpr FilterType type = _type;
+            template<size_t k> using FP = _FP<k>;
+            using ks = std::index_sequence<_ks...>;
+            static constexpr bool deduplicate = false;
+            static constexpr parameter::RegisterSize register_size = parameter::RegisterSize::_32bit;
+        };
+
+        struct Blocked512 : Variant<FilterType::Bloom, bloom::Blocked512, 4, 6, 8> {
+            static constexpr const char *name = "Blocked512";
+        };
+
+        struct Standard4 : Variant<FilterType::Cuckoo, cuckoo::Standard4, 4, 8> {
+            static constexpr const char *name = "Standard4";
+        };
+
+        struct Standard4BFS : Variant<FilterType::Cuckoo, cuckoo::Standard4BFS, 8> {
+            static constexpr const char *name = "Standard4BFS";
+        };
+
+        // construction fails on duplicate keys, thus the static filters are deduplicated as well
+        struct BinaryFuse3 : Variant<FilterType::Xor, nxor::BinaryFuse3, 8, 16> {
+            static constexpr const char *name = "BinaryFuse3";
+            static constexpr bool deduplicate = true;
+        };
+
+        struct BinaryFuse3Stash : Variant<FilterType::Xor, nxor::BinaryFuse3Stash, 8> {
+            static constexpr const char *name = "BinaryFuse3Stash";
+        };
+
+        struct Standard64 : Variant<FilterType::Ribbon, ribbon::Standard64, 8> {
+            static constexpr const char *name = "Standard64";
+            static constexpr bool deduplicate = true;
+            static constexpr parameter::RegisterSize register_size = parameter::RegisterSize::_64bit;
+        };
+
+        struct VQFStandard : Variant<FilterType::VectorQuotient, vqf::Standard, 8> {
+            static constexpr const char *name = "Standard";
+        };
+
+        struct PrefixStandard : Variant<FilterType::Prefix, prefix::Standard, 8> {
+            static constexpr const char *name = "Standard";
+        };
+
+    } // catalogue
+
+    /**
+     * compiles every variant and k of a catalogue for each instruction set up to the one of the translation unit,
+     * unpartitioned, partitioned and hash partitioned, with and without multi-threading. The instantiations are exported as a dispatch module from
+     * which FilterHandle picks the one matching its FilterConfig, the catalogue can be compiled into the binary or
+     * into dispatch modules (FILTERS_DISPATCH_CATALOGUE).
+     */
+    template<parameter::RegisterSize registerSize, parameter::AddressingMode addressingMode, parameter::HashingMode hashingMode, typename ...Variants>
+    class FilterCatalogue {
+      public:
+        using T = typename simd::Vector<registerSize, parameter::SIMD::Scalar>::T;
+        static constexpr parameter::RegisterSize register_size = registerSize;
+
+      private:
+        using Entries = std::vector<std::pair<std::string, const void *>>;
+
+        template<typename Variant, size_t k, parameter::SIMD _simd, parameter::Partitioning partitioning, parameter::MultiThreading multiThreading, parameter::Deduplication deduplication>
+        static void add(Entries &entries) {
+            using OP = parameter::OptimizationParameter<addressingMode, hashingMode, partitioning, registerSize, _simd,
+                    multiThreading, deduplication>;
+            using F = Filter<Variant::type, typename Variant::template FP<k>, k, OP>;
+
+            const std::string key = FilterConfig::key(Variant::type, Variant::name, k, _simd, partitioning,
+                    multiThreading, deduplication);
+            entries.emplace_back(key, &dispatch::KernelsOf<F>::kernels);
+        }
+
+        template<typename Variant, size_t k, parameter::SIMD _simd, parameter::Partitioning partitioning, parameter::MultiThreading multiThreading>
+        static void add(Entries &entries) {
+            add<Variant, k, _simd, partitioning, multiThreading, parameter::Deduplication::Disabled>(entries);
+            if constexpr (Variant::deduplicate) {
+                add<Variant, k, _simd, partitioning, multiThreading, parameter::Deduplication::Enabled>(entries);
+            }
+        }
+
+        template<typename Variant, size_t k, parameter::SIMD _simd, parameter::Partitioning partitioning>
+        static void add(Entries &entries) {
+            add<Variant, k, _simd, partitioning, parameter::MultiThreading::Disabled>(entries);
+            add<Variant, k, _simd, partitioning, parameter::MultiThreading::Enabled>(entries);
+        }
+
+        template<typename Variant, size_t k, parameter::SIMD _simd>
+        static void add(Entries &entries) {
+            if constexpr (static_cast<size_t>(_simd) <= static_cast<size_t>(simd::compiled_simd)) {
+                add<Variant, k, _simd, parameter::Partitioning::Disabled>(entries);
+                add<Variant, k, _simd, parameter::Partitioning::Enabled>(entries);
+                add<Variant, k, _simd, parameter::Partitioning::Hashed>(entries);
+            }
+        }
+
+        template<typename Variant, size_t ...ks>
+        static void add(Entries &entries, std::index_sequence<ks...>) {
+            if constexpr (static_cast<size_t>(Variant::register_size) <= static_cast<size_t>(registerSize)) {
+                (add<Variant, ks, parameter::SIMD::Scalar>(entries), ...);
+                (add<Variant, ks, parameter::SIMD::AVX2>(entries), ...);
+                (add<Variant, ks, parameter::SIMD::AVX512>(entries), ...);
+            }
+        }
+
+      public:
+        static const dispatch::Module &module() {
+            static const Entries names = [] {
+                Entries entries;
+                (add<Variants>(entries, typename Variants::ks{}), ...);
+                return entries;
+            }();
+            static const std::vector<dispatch::Entry> entries = [] {
+                std::vector<dispatch::Entry> entries;
+                for (const auto &[name, kernels] : names) {
+                    entries.push_back({name.c_str(), sizeof(T), kernels});
+                }
+                return entries;
+            }();
+            static const dispatch::Module module{simd::compiled_simd, entries.size(), entries.data()};
+            return module;
+        }
+    };
+
+    /**
+     * the common variants at a few ks and one variant of the remaining filter types at k = 8 (ribbon filters only with
+     * 64-bit registers). Every k of a variant adds 18 instantiations (36 if deduplicated) to the binary, other
+     * variants and ks are left to custom catalogues.
+     */
+    template<parameter::RegisterSize registerSize>
+    using DefaultCatalogue = FilterCatalogue<registerSize, parameter::AddressingMode::Lemire,
+            parameter::HashingMode::Murmur, catalogue::Blocked512, catalogue::Standard4, catalogue::Standard4BFS,
+            catalogue::BinaryFuse3, catalogue::BinaryFuse3Stash, catalogue::Standard64, catalogue::VQFStandard,
+            catalogue::PrefixStandard>;
+
+} // filters
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <filter_base.hpp>
+#include <compiler/compiler_hints.hpp>
+#include <simd/cpu.hpp>
+#include <dispatch/dispatcher.hpp>
+
+namespace filters {
+
+    /**
+     * runtime parameters of a FilterHandle. The filter is partitioned if n_partitions > 1 (on the low bits of the key,
+     * or on a hash of it with partitioning_mode Hashed) and multi-threaded if n_threads > 1, simd is the widest
+     * instruction set the handle may use. deduplication removes duplicate keys before construction, only the variants
+     * of a catalogue that are marked as deduplicated provide it.
+     */
+    struct FilterConfig {
+        FilterType type;
+        std::string variant;
+        size_t k;
+        size_t s;
+        size_t n_partitions{0};
+        size_t n_threads{0};
+        size_t n_tasks_per_level{0};
+        parameter::SIMD simd{parameter::SIMD::AVX512};
+        parameter::Partitioning partitioning_mode{parameter::Partitioning::Enabled};
+        parameter::Deduplication deduplication{parameter::Deduplication::Disabled};
+
+        parameter::Partitioning partitioning() const {
+            return (n_partitions > 1) ? partitioning_mode : parameter::Partitioning::Disabled;
+        }
+
+        parameter::MultiThreading multiThreading() const {
+            return (n_threads > 1) ? parameter::MultiThreading::Enabled : parameter::MultiThreading::Disabled;
+        }
+
+        /**
+         * name of the filter instantiation in a catalogue
+         */
+        static std::string key(FilterType type, const std::string &variant, size_t k, parameter::SIMD simd,
+                               parameter::Partitioning partitioning, parameter::MultiThreading multiThreading,
+                               parameter::Deduplication deduplication) {
+            std::string s_type;
+            switch (type) {
+                case FilterType::Bloom:
+                    s_type = "Bloom";
+                    break;
+                case FilterType::Xor:
+                    s_type = "Xor";
+                    break;
+                case FilterType::Cuckoo:
+                    s_type = "Cuckoo";
+                    break;
+                case FilterType::Ribbon:
+                    s_type = "Ribbon";
+                    break;
+                case FilterType::VectorQuotient:
+                    s_type = "VectorQuotient";
+                    break;
+                case FilterType::Prefix:
+                    s_type = "Prefix";
+                    break;
+                default:
+                    s_type = std::to_string(static_cast<size_t>(type));
+                    break;
+            }
+
+            std::string s_simd;
+            switch (simd) {
+                case parameter::SIMD::Scalar:
+                    s_simd = "Scalar";
+                    break;
+                case parameter::SIMD::AVX2:
+                    s_simd = "AVX2";
+                    break;
+                case parameter::SIMD::AVX512:
+                    s_simd = "AVX512";
+                    break;
+            }
+
+            std::string s_partitioning;
+            switch (partitioning) {
+                case parameter::Partitioning::Disabled:
+                    s_partitioning = "Unpartitioned";
+                    break;
+                case parameter::Partitioning::Enabled:
+                    s_partitioning = "Partitioned";
+                    break;
+                case parameter::Partitioning::Hashed:
+                    s_partitioning = "HashPartitioned";
+                    break;
+            }
+
+            return s_type + "/" + variant + "/" + std::to_string(k) + "/" + s_simd + "/" + s_partitioning + "/" +
+                   ((multiThreading == parameter::MultiThreading::Enabled) ? "MT" : "ST") +
+                   ((deduplication == parameter::Deduplication::Enabled) ? "/Dedup" : "");
+        }
+
+        std::string key(parameter::SIMD with_simd) const {
+            return key(type, variant, k, with_simd, partitioning(), multiThreading(), deduplication);
+        }
+    };
+
+    /**
+     * type-erased filter configured at runtime. The instantiation is looked up once in a catalogue or dispatch module,
+     * afterwards every batch costs a single indirect call, the loops over the keys run in the templated filter.
+     */
+    template<typename T>
+    class FilterHandle {
+      private:
+        FilterConfig _config;
+        parameter::SIMD _simd{parameter::SIMD::Scalar};
+        const dispatch::Kernels<T> *kernels{nullptr};
+        void *instance{nullptr};
+
+      public:
+        /**
+         * uses the widest instruction set up to config.simd that the module provides and the cpu supports
+         */
+        FilterHandle(const dispatch::Module &module, const FilterConfig &config) : _config(config) {
+            const size_t limit = std::min({static_cast<size_t>(config.simd), static_cast<size_t>(module.simd),
+                                           static_cast<size_t>(simd::cpu_simd())});
+            for (parameter::SIMD simd : {parameter::SIMD::AVX512, parameter::SIMD::AVX2, parameter::SIMD::Scalar}) {
+                if (static_cast<size_t>(simd) > limit) {
+                    continue;
+                }
+                kernels = dispatch::find<T>(module, config.key(simd));
+                if (kernels) {
+                    _simd = simd;
+                    break;
+                }
+            }
+            if (not kernels) {
+                throw std::runtime_error{"no filter " + config.key(config.simd) + " in catalogue!"};
+            }
+            instance = kernels->create(config.s, config.n_partitions, config.n_threads, config.n_tasks_per_level);
+        }
+
+        FilterHandle(const dispatch::Dispatcher &dispatcher, const FilterConfig &config)
+                : FilterHandle(dispatcher.loaded_module(), config) {
+        }
+
+        FilterHandle(const FilterHandle &) = delete;
+
+        FilterHandle &operator=(const FilterHandle &) = delete;
+
+        FilterHandle(FilterHandle &&other) noexcept: _config(std::move(other._config)), _simd(other._simd),
+                                                     kernels(other.kernels), instance(other.instance) {
+            other.instance = nullptr;
+        }
+
+        FilterHandle &operator=(FilterHandle &&other) noexcept {
+            std::swap(_config, other._config);
+            std::swap(_simd, other._simd);
+            std::swap(kernels, other.kernels);
+            std::swap(instance, other.instance);
+            return *this;
+        }
+
+        ~FilterHandle() {
+            if (instance) {
+                kernels->destroy(instance);
+            }
+        }
+
+        forceinline
+        bool construct(T *values, size_t length) {
+            return kernels->construct(instance, values, length);
+        }
+
+        forceinline
+        size_t count(T *values, size_t length) {
+            return kernels->count(instance, values, length);
+        }
+
+        forceinline
+        size_t probe(const T *values, size_t length, uint32_t *positions) const {
+            return kernels->probe(instance, values, length, positions);
+        }
+
+        forceinline
+        size_t probe_bitmap(const T *values, size_t length, uint64_t *bitmap) const {
+            return kernels->probe_bitmap(instance, values, length, bitmap);
+        }
+
+        void save(const std::string &path) const {
+            kernels->save(instance, path.c_str());
+        }
+
+        void load(const std::string &path) {
+            kernels->load(instance, path.c_str());
+        }
+
+        size_t size() const {
+            return kernels->size(instance);
+        }
+
+        const FilterConfig &config() const {
+            return _config;
+        }
+
+        /**
+         * instruction set of the selected instantiation
+         */
+        parameter::SIMD simd() const {
+            return _simd;
+        }
+    };
+
+} // filters
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include <compiler/compiler_hints.hpp>
+#include <memory/allocation_policy.hpp>
+#include <simd/helper.hpp>
+
+namespace filters::growing {
+
+    /**
+     * filters that reject a key without dropping keys added before, e.g. a cuckoo filter with BFS eviction
+     */
+    template<typename Filter> concept FailsafeAdd = requires { requires Filter::supports_failsafe_add; };
+
+    /**
+     * Chain of filters that grows instead of failing once it is full (like a scalable Bloom filter). A new stage is
+     * appended when the newest stage has reached its capacity or rejects a key. Every stage has growth times the
+     * capacity of the previous one and tightening percent more space per key (s), so the false-positive rate of the
+     * chain stays bounded while the number of stages grows only logarithmically with the number of keys.
+     *
+     * Keys are added one at a time, a rejected key is retried in a new stage. Lookups are batched per stage: the
+     * newest stage holds most keys, so it probes all keys and the older stages only probe the keys rejected by the
+     * newer ones.
+     */
+    template<FailsafeAdd Filter>
+    class GrowingFilter {
+      public:
+        using Vector = typename Filter::Vector;
+        using T = typename Vector::T;
+
+      private:
+        struct Stage {
+            std::unique_ptr<Filter> filter;
+            size_t capacity;
+            size_t n_keys;
+        };
+
+        size_t s, n_partitions, n_threads, n_tasks_per_level;
+        size_t capacity, growth, tightening;
+        memory::AllocationPolicy policy;
+        std::vector<Stage> stages;
+
+        void grow() {
+            const size_t stage_capacity = stages.empty() ? capacity : stages.back().capacity * growth;
+            const size_t stage_s = stages.empty() ? s : stages.back().filter->s * (100 + tightening) / 100;
+
+            auto filter = std::make_unique<Filter>(stage_s, n_partitions, n_threads, n_tasks_per_level, policy);
+
+            // keys are spread evenly over the partitions
+            const size_t n_histogram = std::max(n_partitions, 1ul);
+            T *histogram = simd::valloc<Vector>(simd::valign<Vector>(n_histogram * sizeof(T)), 0);
+            for (size_t i = 0; i < n_histogram; i++) {
+                histogram[i] = (stage_capacity + n_histogram - 1) / n_histogram;
+            }
+            filter->init(histogram);
+            free(histogram);
+
+            stages.push_back({std::move(filter), stage_capacity, 0});
+        }
+
+      public:
+        /**
+         * capacity is the number of keys of the first stage, the other parameters are passed to every stage
+         */
+        GrowingFilter(size_t s, size_t n_partitions, size_t n_threads, size_t n_tasks_per_level, size_t capacity,
+                      size_t growth = 2, size_t tightening = 10, const memory::AllocationPolicy &policy = {})
+                : s(s), n_partitions(n_partitions), n_threads(n_threads), n_tasks_per_level(n_tasks_per_level),
+                  capacity(std::max(capacity, 1ul)), growth(std::max(growth, 1ul)), tightening(tightening),
+                  policy(policy) {
+            grow();
+        }
+
+        /**
+         * adds a key to the newest stage, only fails if a new and empty stage rejects the key
+         */
+        bool add(const T &value) {
+            Stage &stage = stages.back();
+            if (stage.n_keys < stage.capacity and stage.filter->add(value)) {
+                stage.n_keys++;
+                return true;
+            }
+
+            grow();
+            if (stages.back().filter->add(value)) {
+                stages.back().n_keys++;
+                return true;
+            }
+            return false;
+        }
+
+        bool add_all(const T *values, size_t length) {
+            bool success = true;
+            for (size_t i = 0; i < length; i++) {
+                success &= add(values[i]);
+            }
+            return success;
+        }
+
+        forceinline
+        bool contains(const T &value) const {
+            for (auto stage = stages.rbegin(); stage != stages.rend(); ++stage) {
+                if (stage->filter->contains(value)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        size_t count(const T *values, size_t length) const {
+            std::vector<uint64_t> bitmap((length + 63) / 64);
+            std::vector<T> misses;
+
+            size_t n_matches = 0;
+            const T *probed = values;
+            size_t n_probed = length;
+            for (size_t stage = stages.size(); stage > 0 and n_probed > 0; stage--) {
+                n_matches += stages[stage - 1].filter->probe_bitmap(probed, n_probed, bitmap.data());
+                if (stage == 1) {
+                    break;
+                }
+
+                // compact the rejected keys, in place after the first stage
+                misses.resize(n_probed);
+                size_t n_misses = 0;
+                for (size_t word = 0; word < (n_probed + 63) / 64; word++) {
+                    uint64_t rejected = ~bitmap[word];
+                    if (word == n_probed / 64) {
+                        rejected &= (1ul << (n_probed % 64)) - 1;
+                    }
+                    for (; rejected; rejected &= rejected - 1) {
+                        misses[n_misses++] = probed[word * 64 + __builtin_ctzll(rejected)];
+                    }
+                }
+                probed = misses.data();
+                n_probed = n_misses;
+            }
+            return n_matches;
+        }
+
+        size_t n_stages() const {
+            return stages.size();
+        }
+
+        size_t n_keys() const {
+            size_t n = 0;
+            for (const Stage &stage : stages) {
+                n += stage.n_keys;
+            }
+            return n;
+        }
+
+        size_t size() const {
+            size_t n_bytes = 0;
+            for (const Stage &stage : stages) {
+                n_bytes += stage.filter->size();
+            }
+            return n_bytes;
+        }
+
+        std::string to_string() {
+            std::string s = "\n{\n";
+            s += "\t\"stages\": " + std::to_string(n_stages()) + ",\n";
+            s += "\t\"keys\": " + std::to_string(n_keys()) + ",\n";
+            s += "\t\"size\": " + std::to_string(size() * 8) + " bits,\n";
+            s += "\t\"growth\": " + std::to_string(growth) + ",\n";
+            s += "\t\"tightening\": " + std::to_string(tightening) + ",\n";
+            s += "\t\"newest_stage\": " + stages.back().filter->to_string();
+            s += "}\n";
+
+            return s;
+        }
+    };
+
+} // filters::growing
@@ -57,4 +57,43 @@ namespace filters::hash {
         }
     }
 
+    /**
+     * xxHash of a single key, i.e., XXH32 of 4 bytes and XXH3_64bits of 8 bytes, respectively. Only lane-wise
+     * multiplies, shifts and rotates are needed, so all lanes are hashed at once.
+     */
+    template<typename Vector>
+    static Vector xxhash(const Vector &v, const Vector &seed) {
+        if constexpr (Vector::registerSize == parameter::RegisterSize::_32bit) {
+            const Vector prime2(0x85ebca77), prime3(0xc2b2ae3d), prime4(0x27d4eb2f), prime5(0x165667b1);
+
+            Vector h = seed + prime5 + Vector(sizeof(uint32_t));
+            h = h + v * prime3;
+            h = h.template rol<17>() * prime4;
+            h = h ^ (h >> 15);
+            h = h * prime2;
+            h = h ^ (h >> 13);
+            h = h * prime3;
+            h = h ^ (h >> 16);
+
+            return h;
+        } else {
+            // xor of the secret words 1 and 2 of XXH3
+            const Vector secret(0xc73ab174c5ecd5a2), mul(0x9fb21c651e98df25);
+
+            // XXH3 mixes the byte swapped low half of the seed into its high half
+            const Vector swapped = ((seed & Vector(0xff)) << 24) | ((seed & Vector(0xff00)) << 8) |
+                                   ((seed >> 8) & Vector(0xff00)) | ((seed >> 24) & Vector(0xff));
+            const Vector bitflip = secret - (seed ^ (swapped << 32));
+
+            Vector h = v.template rol<32>() ^ bitflip;
+            h = h ^ h.template rol<49>() ^ h.template rol<24>();
+            h = h * mul;
+            h = h ^ ((h >> 35) + Vector(sizeof(uint64_t)));
+            h = h * mul;
+            h = h ^ (h >> 28);
+
+            return h;
+        }
+    }
+
 } // filters::hash
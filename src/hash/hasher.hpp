@@ -7,3 +7,5 @@
 #include "hasher_base.hpp"
 #include "hasher_two_independent_multiply_shift.hpp"
 #include "hasher_cityhash.hpp"
+#include "hasher_simple_tabulation.hpp"
+#include "hasher_xxhash.hpp"
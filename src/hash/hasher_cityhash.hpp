@@ -36,7 +36,7 @@ namespace filters::hash {
         forceinline
         static Vector rehash(const Vector &hash, const Vector &val) {
             if constexpr (Vector::registerSize == RegisterSize::_32bit) {
-                return hash(hash ^ val);
+                return Hasher::hash(hash ^ val);
             } else {
                 Vector res(0);
                 for (size_t i = 0; i < Vector::n_elements; i++) {
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <parameter/parameter.hpp>
+#include <compiler/compiler_hints.hpp>
+#include "hasher_base.hpp"
+
+namespace filters::hash {
+
+    using HashingMode = parameter::HashingMode;
+
+    /**
+     * simple tabulation hashing: every 11-bit character of the key selects a random word of its own table and the
+     * words are combined with xor. The tables (3 x 2048 x 32 bits or 6 x 2048 x 64 bits) are filled with splitmix64
+     * at compile time, vectors look up all lanes with one gather per character. 11-bit instead of 8-bit characters
+     * save a quarter of the gathers, the 24 KiB tables of 32-bit keys still fit into the L1 cache.
+     *
+     * Tabulation trades speed for its 3-independence: hashing 16M random keys with AVX2 takes about 0.9 ns per
+     * 32-bit key and 3 ns per 64-bit key, Murmur about 0.7 ns and 1.5 ns. Filters that are bound by hashing get
+     * slower accordingly.
+     */
+    template<typename Vector, size_t config>
+    struct Hasher<HashingMode::SimpleTabulation, Vector, config> {
+
+        using T = typename Vector::T;
+
+        static constexpr size_t hash_bits = static_cast<size_t>(Vector::registerSize);
+        static constexpr size_t n_character_bits = 11;
+        static constexpr size_t n_tables = (hash_bits + n_character_bits - 1) / n_character_bits;
+        static constexpr size_t n_entries = 1ull << n_character_bits;
+
+        static constexpr std::array<T, n_tables * n_entries> generate_tables() {
+            std::array<T, n_tables * n_entries> tables{};
+            uint64_t seed = 0x9e3779b97f4a7c15ull * (config + 1);
+            for (T &entry : tables) {
+                seed += 0x9e3779b97f4a7c15ull;
+                uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                entry = static_cast<T>(z ^ (z >> 31));
+            }
+            return tables;
+        }
+
+        alignas(64) static constexpr std::array<T, n_tables * n_entries> tables = generate_tables();
+
+        forceinline unroll_loops
+        static Vector hash(const Vector &val) {
+            Vector h = (val & Vector(n_entries - 1)).gather(tables.data(), Vector::mask(1));
+            for (size_t i = 1; i < n_tables; i++) {
+                const Vector index = ((val >> (n_character_bits * i)) & Vector(n_entries - 1)) + Vector(i * n_entries);
+                h = h ^ index.gather(tables.data(), Vector::mask(1));
+            }
+            return h;
+        }
+
+        template<size_t>
+        forceinline
+        static Vector rehash(const Vector &hash, const Vector &val) {
+            return Hasher::hash(hash ^ val);
+        }
+    };
+
+} // filters::hash
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <sched.h>
+#include <sys/mman.h>
+#include <compiler/compiler_hints.hpp>
+#include <math/math.hpp>
+
+#if defined(HAVE_NUMA)
+#include <numa.h>
+#endif
+
+namespace filters::memory {
+
+    enum class Pages : int64_t {
+        Small = 0, Huge2M = 1, Huge1G = 2
+    };
+
+    enum class Placement : int64_t {
+        // first touch
+        Default = 0,
+        // pages are spread round-robin over all nodes
+        Interleaved = 1,
+        // pages are bound to node (or to the node of the calling thread)
+        Local = 2,
+        // one node-local copy per node, lookups use the copy of the node they run on
+        Replicated = 3
+    };
+
+    forceinline
+    static size_t n_nodes() {
+        #if defined(HAVE_NUMA)
+        return (numa_available() < 0)
+               ? 1
+               : static_cast<size_t>(numa_num_configured_nodes());
+        #else
+        return 1;
+        #endif
+    }
+
+    /**
+     * node of the calling thread, it is determined once per thread as threads are pinned (task::set_cpu_affinity).
+     * It can be overwritten to access the replica of another node.
+     */
+    forceinline
+    static int &current_node() {
+        #if defined(HAVE_NUMA)
+        static thread_local int node = (numa_available() < 0)
+                                       ? 0
+                                       : numa_node_of_cpu(sched_getcpu());
+        #else
+        static thread_local int node = 0;
+        #endif
+        return node;
+    }
+
+    /**
+     * Describes how the large arrays of a filter (filter bits, fingerprints, buckets) are allocated. Placement only
+     * has an effect if the library is built with HAVE_NUMA. Explicit huge pages fall back to transparent huge pages
+     * if no huge pages are reserved.
+     */
+    struct AllocationPolicy {
+        Pages pages{Pages::Small};
+        Placement placement{Placement::Interleaved};
+        int node{-1};
+
+        static constexpr int64_t n_placements = 4;
+
+        constexpr AllocationPolicy() = default;
+
+        constexpr AllocationPolicy(Pages pages, Placement placement, int node = -1) : pages(pages),
+                                                                                     placement(placement),
+                                                                                     node(node) {
+        }
+
+        /**
+         * encodes pages and placement as a single integer, e.g., as a benchmark argument
+         */
+        constexpr int64_t id() const {
+            return static_cast<int64_t>(pages) * n_placements + static_cast<int64_t>(placement);
+        }
+
+        static constexpr AllocationPolicy from_id(int64_t id) {
+            return AllocationPolicy(static_cast<Pages>(id / n_placements), static_cast<Placement>(id % n_placements));
+        }
+
+        forceinline
+        size_t page_size() const {
+            switch (pages) {
+                case Pages::Huge2M:
+                    return 1ull << 21;
+                case Pages::Huge1G:
+                    return 1ull << 30;
+                default:
+                    return 1ull << 12;
+            }
+        }
+
+        forceinline
+        AllocationPolicy on_node(int node) const {
+            return AllocationPolicy(pages, Placement::Local, node);
+        }
+
+        forceinline
+        int target_node() const {
+            #if defined(HAVE_NUMA)
+            return (node >= 0)
+                   ? node
+                   : numa_node_of_cpu(sched_getcpu());
+            #else
+            return 0;
+            #endif
+        }
+
+        void *allocate(size_t n_bytes) const {
+            void *mem;
+            if (pages == Pages::Small) {
+                #if defined(HAVE_NUMA)
+                switch (placement) {
+                    case Placement::Interleaved:
+                        mem = numa_alloc_interleaved(n_bytes);
+                        break;
+                    case Placement::Local:
+                    case Placement::Replicated:
+                        mem = numa_alloc_onnode(n_bytes, target_node());
+                        break;
+                    default:
+                        mem = aligned_alloc(64, n_bytes);
+                }
+                #else
+                mem = aligned_alloc(64, n_bytes);
+                #endif
+            } else {
+                const size_t n_mapped_bytes = math::align_number(n_bytes, page_size());
+                const int huge_page_flag = (pages == Pages::Huge2M)
+                                           ? (21 << MAP_HUGE_SHIFT)
+                                           : (30 << MAP_HUGE_SHIFT);
+                mem = mmap(nullptr, n_mapped_bytes, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | huge_page_flag, -1, 0);
+                if (mem == MAP_FAILED) {
+                    // no reserved huge pages, ask for transparent huge pages instead
+                    mem = mmap(nullptr, n_mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                    if (mem != MAP_FAILED) {
+                        madvise(mem, n_mapped_bytes, MADV_HUGEPAGE);
+                    }
+                }
+                if (mem == MAP_FAILED) {
+                    mem = nullptr;
+                }
+
+                #if defined(HAVE_NUMA)
+                // the policy has to be set before the pages are touched for the first time
+                if (mem and placement == Placement::Interleaved) {
+                    numa_interleave_memory(mem, n_mapped_bytes, numa_all_nodes_ptr);
+                } else if (mem and placement != Placement::Default) {
+                    numa_tonode_memory(mem, n_mapped_bytes, target_node());
+                }
+                #endif
+            }
+
+            if (not mem) {
+                throw std::bad_alloc{};
+            }
+            return mem;
+        }
+
+        void release(void *mem, size_t n_bytes) const {
+            if (pages == Pages::Small) {
+                #if defined(HAVE_NUMA)
+                if (placement != Placement::Default) {
+                    numa_free(mem, n_bytes);
+                    return;
+                }
+                #endif
+                free(mem);
+            } else {
+                munmap(mem, math::align_number(n_bytes, page_size()));
+            }
+        }
+
+        std::string to_string() const {
+            static constexpr const char *page_names[] = {"Small", "Huge2M", "Huge1G"};
+            static constexpr const char *placement_names[] = {"Default", "Interleaved", "Local", "Replicated"};
+
+            std::string s = "{\"pages\": \"" + std::string(page_names[static_cast<size_t>(pages)]) + "\", ";
+            s += "\"placement\": \"" + std::string(placement_names[static_cast<size_t>(placement)]) + "\", ";
+            s += "\"node\": " + std::to_string(node) + "}";
+            return s;
+        }
+    };
+
+} // filters::memory
@@ -10,11 +10,15 @@ namespace filters::parameter {
     };
 
     enum class HashingMode : size_t {
-        Identity, Murmur, Fasthash, TwoIndependentMultiplyShift, Mul, SimpleTabulation, Cityhash
+        Identity, Murmur, Fasthash, TwoIndependentMultiplyShift, Mul, SimpleTabulation, Cityhash, XXHash
     };
 
+    /**
+     * Enabled partitions on the low bits of the key, Hashed on the high bits of a multiplicative hash of the key,
+     * which is computed in addition to the hash of the filter (see partition::Partitioner)
+     */
     enum class Partitioning : size_t {
-        Enabled = 1, Disabled = 0
+        Enabled = 1, Disabled = 0, Hashed = 2
     };
 
     enum class RegisterSize : size_t {
@@ -29,7 +33,15 @@ namespace filters::parameter {
         Enabled = 1, Disabled = 0
     };
 
-    template<AddressingMode _addressingMode, HashingMode _hashingMode, Partitioning _partitioning, RegisterSize _registerSize, SIMD _simd, MultiThreading _multiThreading>
+    /**
+     * Enabled drops duplicate keys while partitioning, duplicates would otherwise overflow cuckoo buckets and can
+     * never be peeled by xor filters
+     */
+    enum class Deduplication : size_t {
+        Enabled = 1, Disabled = 0
+    };
+
+    template<AddressingMode _addressingMode, HashingMode _hashingMode, Partitioning _partitioning, RegisterSize _registerSize, SIMD _simd, MultiThreading _multiThreading, Deduplication _deduplication = Deduplication::Disabled>
     struct OptimizationParameter {
         static constexpr AddressingMode addressingMode = _addressingMode;
         static constexpr HashingMode hashingMode = _hashingMode;
@@ -37,8 +49,12 @@ namespace filters::parameter {
         static constexpr RegisterSize registerSize = _registerSize;
         static constexpr SIMD simd = _simd;
         static constexpr MultiThreading multiThreading = _multiThreading;
+        static constexpr Deduplication deduplication = _deduplication;
 
-        static std::string to_string() {
+        /**
+         * include_simd = false describes the memory layout only, which is the same for every instruction set
+         */
+        static std::string to_string(bool include_simd = true) {
             std::string s_addressingMode;
             switch (addressingMode) {
                 case AddressingMode::PowerOfTwo:
@@ -75,11 +91,17 @@ namespace filters::parameter {
                 case HashingMode::Mul:
                     s_hashingMode = "Mul";
                     break;
+                case HashingMode::Cityhash:
+                    s_hashingMode = "Cityhash";
+                    break;
+                case HashingMode::XXHash:
+                    s_hashingMode = "XXHash";
+                    break;
             }
 
             std::string s_partitioning = (partitioning == Partitioning::Enabled)
                                          ? "Enabled"
-                                         : "Disabled";
+                                         : (partitioning == Partitioning::Hashed) ? "Hashed" : "Disabled";
             std::string s_registerSize = std::to_string(static_cast<size_t>(registerSize)) + " bits";
 
             std::string s_simd = (partitioning == Partitioning::Enabled)
@@ -101,13 +123,20 @@ namespace filters::parameter {
                                            ? "Enabled"
                                            : "Disabled";
 
+            std::string s_deduplication = (deduplication == Deduplication::Enabled)
+                                          ? "Enabled"
+                                          : "Disabled";
+
             std::string s = "{";
             s += "\"addressing_mode\": \"" + s_addressingMode + "\", ";
             s += "\"hashing_mode\": \"" + s_hashingMode + "\", ";
             s += "\"partitioning\": \"" + s_partitioning + "\", ";
             s += "\"register_size\": \"" + s_registerSize + "\", ";
-            s += "\"simd\": \"" + s_simd + "\", ";
-            s += "\"multi_threading\": \"" + s_multiThreading + "\"}";
+            if (include_simd) {
+                s += "\"simd\": \"" + s_simd + "\", ";
+            }
+            s += "\"multi_threading\": \"" + s_multiThreading + "\", ";
+            s += "\"deduplication\": \"" + s_deduplication + "\"}";
 
             return s;
         }
@@ -917,4 +946,79 @@ namespace filters::parameter {
             Partitioning::Enabled, RegisterSize::_32bit, SIMD::AVX512,
             MultiThreading::Disabled>;
 
+
+    /*
+     * Murmur, Hashed Partitioning
+     */
+
+    using PowerOfTwoMurmurScalar64Hashed = OptimizationParameter<AddressingMode::PowerOfTwo, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_64bit, SIMD::Scalar, MultiThreading::Disabled>;
+    using MagicMurmurScalar64Hashed = OptimizationParameter<AddressingMode::Magic, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_64bit, SIMD::Scalar, MultiThreading::Disabled>;
+    using LemireMurmurScalar64Hashed = OptimizationParameter<AddressingMode::Lemire, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_64bit, SIMD::Scalar, MultiThreading::Disabled>;
+
+    using PowerOfTwoMurmurAVX264Hashed = OptimizationParameter<AddressingMode::PowerOfTwo, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_64bit, SIMD::AVX2, MultiThreading::Disabled>;
+    using MagicMurmurAVX264Hashed = OptimizationParameter<AddressingMode::Magic, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_64bit, SIMD::AVX2, MultiThreading::Disabled>;
+    using LemireMurmurAVX264Hashed = OptimizationParameter<AddressingMode::Lemire, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_64bit, SIMD::AVX2, MultiThreading::Disabled>;
+
+    using PowerOfTwoMurmurAVX51264Hashed = OptimizationParameter<AddressingMode::PowerOfTwo, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_64bit, SIMD::AVX512, MultiThreading::Disabled>;
+    using MagicMurmurAVX51264Hashed = OptimizationParameter<AddressingMode::Magic, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_64bit, SIMD::AVX512, MultiThreading::Disabled>;
+    using LemireMurmurAVX51264Hashed = OptimizationParameter<AddressingMode::Lemire, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_64bit, SIMD::AVX512, MultiThreading::Disabled>;
+
+    using PowerOfTwoMurmurScalar32HashedMT = OptimizationParameter<AddressingMode::PowerOfTwo, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::Scalar, MultiThreading::Enabled>;
+    using MagicMurmurScalar32HashedMT = OptimizationParameter<AddressingMode::Magic, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::Scalar, MultiThreading::Enabled>;
+    using LemireMurmurScalar32HashedMT = OptimizationParameter<AddressingMode::Lemire, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::Scalar, MultiThreading::Enabled>;
+
+    using PowerOfTwoMurmurAVX232HashedMT = OptimizationParameter<AddressingMode::PowerOfTwo, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::AVX2, MultiThreading::Enabled>;
+    using MagicMurmurAVX232HashedMT = OptimizationParameter<AddressingMode::Magic, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::AVX2, MultiThreading::Enabled>;
+    using LemireMurmurAVX232HashedMT = OptimizationParameter<AddressingMode::Lemire, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::AVX2, MultiThreading::Enabled>;
+
+    using PowerOfTwoMurmurAVX51232HashedMT = OptimizationParameter<AddressingMode::PowerOfTwo, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::AVX512, MultiThreading::Enabled>;
+    using MagicMurmurAVX51232HashedMT = OptimizationParameter<AddressingMode::Magic, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::AVX512, MultiThreading::Enabled>;
+    using LemireMurmurAVX51232HashedMT = OptimizationParameter<AddressingMode::Lemire, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::AVX512, MultiThreading::Enabled>;
+
+    /*
+     * Murmur, Deduplication
+     */
+
+    using PowerOfTwoMurmurScalar64Dedup = OptimizationParameter<AddressingMode::PowerOfTwo, HashingMode::Murmur,
+            Partitioning::Disabled, RegisterSize::_64bit, SIMD::Scalar, MultiThreading::Disabled,
+            Deduplication::Enabled>;
+    using LemireMurmurScalar64Dedup = OptimizationParameter<AddressingMode::Lemire, HashingMode::Murmur,
+            Partitioning::Disabled, RegisterSize::_64bit, SIMD::Scalar, MultiThreading::Disabled,
+            Deduplication::Enabled>;
+
+    using PowerOfTwoMurmurAVX51264PartitionedDedup = OptimizationParameter<AddressingMode::PowerOfTwo,
+            HashingMode::Murmur, Partitioning::Enabled, RegisterSize::_64bit, SIMD::AVX512, MultiThreading::Disabled,
+            Deduplication::Enabled>;
+    using MagicMurmurAVX51264PartitionedDedup = OptimizationParameter<AddressingMode::Magic,
+            HashingMode::Murmur, Partitioning::Enabled, RegisterSize::_64bit, SIMD::AVX512, MultiThreading::Disabled,
+            Deduplication::Enabled>;
+    using LemireMurmurAVX51264PartitionedDedup = OptimizationParameter<AddressingMode::Lemire,
+            HashingMode::Murmur, Partitioning::Enabled, RegisterSize::_64bit, SIMD::AVX512, MultiThreading::Disabled,
+            Deduplication::Enabled>;
+
+    using PowerOfTwoMurmurAVX232HashedMTDedup = OptimizationParameter<AddressingMode::PowerOfTwo, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::AVX2, MultiThreading::Enabled, Deduplication::Enabled>;
+    using MagicMurmurAVX232HashedMTDedup = OptimizationParameter<AddressingMode::Magic, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::AVX2, MultiThreading::Enabled, Deduplication::Enabled>;
+    using LemireMurmurAVX232HashedMTDedup = OptimizationParameter<AddressingMode::Lemire, HashingMode::Murmur,
+            Partitioning::Hashed, RegisterSize::_32bit, SIMD::AVX2, MultiThreading::Enabled, Deduplication::Enabled>;
+
 } // filters::parameter
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <algorithm>
+#include <simd/helper.hpp>
+#include <math/math.hpp>
+#include "partitioner.hpp"
+
+namespace filters::partition {
+
+    /**
+     * Partitions the input chunk by chunk into a reusable buffer and remembers the original row of every key, so
+     * lookups on partitioned filters can report their results in input order. Memory use is bounded by the chunk
+     * size instead of the input size.
+     */
+    template<parameter::Partitioning partitioning, typename Vector>
+    struct PartitionChunk {
+        using T = typename Vector::T;
+        using M = typename Vector::M;
+
+        static constexpr size_t default_chunk_size = 1ull << 14;
+
+        size_t n_partitions;
+        Partitioner<partitioning, T> partitioner;
+        size_t capacity;
+
+        T *values;
+        uint32_t *positions;
+        T *histogram;
+        T *offsets;
+        uint64_t *bitmap;
+
+        explicit PartitionChunk(size_t n_partitions) : n_partitions(n_partitions), partitioner(n_partitions) {
+            // keep enough keys per partition to fill a few registers
+            capacity = math::align_number(std::max(default_chunk_size, n_partitions * Vector::n_elements * 4), 64ul);
+
+            // every partition is padded to full registers
+            const size_t n_slots = capacity + n_partitions * Vector::n_elements;
+            values = simd::valloc<Vector>(simd::valign<Vector>(n_slots * sizeof(T)));
+            positions = reinterpret_cast<uint32_t *>(simd::valloc<Vector>(
+                    simd::valign<Vector>(n_slots * sizeof(uint32_t))));
+            histogram = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)));
+            offsets = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)));
+            bitmap = reinterpret_cast<uint64_t *>(simd::valloc<Vector>(capacity / 8));
+        }
+
+        PartitionChunk(const PartitionChunk &) = delete;
+
+        PartitionChunk &operator=(const PartitionChunk &) = delete;
+
+        ~PartitionChunk() {
+            free(values);
+            free(positions);
+            free(histogram);
+            free(offsets);
+            free(bitmap);
+        }
+
+        /**
+         * returns the buffer of the calling thread, it is reused by all lookups with the same number of partitions
+         */
+        static PartitionChunk &local(size_t n_partitions) {
+            static thread_local std::unique_ptr<PartitionChunk> chunk;
+            if (not chunk or chunk->n_partitions != n_partitions) {
+                chunk = std::make_unique<PartitionChunk>(n_partitions);
+            }
+            return *chunk;
+        }
+
+        forceinline
+        void init(const T *v, size_t l) {
+            std::memset(histogram, 0, n_partitions * sizeof(T));
+            std::memset(bitmap, 0, capacity / 8);
+
+            for (size_t i = 0; i < l; i++) {
+                histogram[partitioner(v[i])]++;
+            }
+
+            T last_offset = 0;
+            for (size_t partition = 0; partition < n_partitions; partition++) {
+                offsets[partition] = last_offset;
+                last_offset += math::align_number(histogram[partition], static_cast<T>(Vector::n_elements));
+            }
+
+            // the chunk stays in cache, so plain stores are sufficient here
+            T write_offsets[n_partitions];
+            std::memcpy(write_offsets, offsets, n_partitions * sizeof(T));
+            for (size_t i = 0; i < l; i++) {
+                const T offset = write_offsets[partitioner(v[i])]++;
+                values[offset] = v[i];
+                positions[offset] = i;
+            }
+        }
+
+        forceinline
+        void mark(uint64_t mask, const uint32_t *rows) {
+            for (; mask; mask &= mask - 1) {
+                const uint32_t row = rows[simd::tzcount64(mask)];
+                bitmap[row / 64] |= 1ull << (row % 64);
+            }
+        }
+
+        /**
+         * probes values in chunks, contains(keys, mask, partition) has to return the matches of a register and
+         * sink(mask, position) receives the matches in input order, 64 rows at a time
+         */
+        template<typename Contains, typename Sink>
+        forceinline
+        void probe(const T *v, size_t l, Contains &&contains, Sink &&sink) {
+            for (size_t begin = 0; begin < l; begin += capacity) {
+                const size_t length = std::min(capacity, l - begin);
+                init(v + begin, length);
+
+                for (size_t partition = 0; partition < n_partitions; partition++) {
+                    const T *keys = values + offsets[partition];
+                    const uint32_t *rows = positions + offsets[partition];
+                    const T *end = keys + histogram[partition];
+
+                    for (; keys + Vector::n_elements <= end; keys += Vector::n_elements, rows += Vector::n_elements) {
+                        mark(simd::lane_mask<Vector>(contains(Vector::load(keys), Vector::mask(1), partition)), rows);
+                    }
+
+                    if constexpr (Vector::avx) {
+                        if (keys < end) {
+                            const M mask = (1 << (end - keys)) - 1;
+                            mark(simd::lane_mask<Vector>(contains(Vector::load(keys), mask, partition)), rows);
+                        }
+                    }
+                }
+
+                for (size_t word = 0; word * 64 < length; word++) {
+                    sink(bitmap[word], begin + word * 64);
+                }
+            }
+        }
+
+        /**
+         * counts values in chunks, count(chunk) has to return the matches of a partitioned chunk, which has the layout
+         * of a PartitionSet (n_partitions, values, offsets, histogram)
+         */
+        template<typename Count>
+        forceinline
+        size_t count(const T *v, size_t l, Count &&count) {
+            size_t counter = 0;
+            for (size_t begin = 0; begin < l; begin += capacity) {
+                init(v + begin, std::min(capacity, l - begin));
+                counter += count(*this);
+            }
+            return counter;
+        }
+
+        /**
+         * like count(), but the input is split into one slice per task and every thread partitions its slices into
+         * its own chunk
+         */
+        template<typename TaskQueue, typename Count>
+        static size_t count(const T *v, size_t l, size_t n_partitions, TaskQueue &queue, Count &&count) {
+            std::atomic<size_t> counter{0};
+            const size_t n_tasks = std::max(queue.get_n_tasks_per_level(), 1ul);
+            for (size_t j = 0; j < n_tasks; j++) {
+                queue.add_task([&, j](size_t) {
+                    const size_t begin = l * j / n_tasks;
+                    const size_t end = l * (j + 1) / n_tasks;
+                    counter += local(n_partitions).count(v + begin, end - begin, count);
+                });
+            }
+            queue.execute_tasks();
+            return counter;
+        }
+    };
+
+}
@@ -1,21 +1,43 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
 #include <simd/helper.hpp>
 #include <math/math.hpp>
 #include "cache_line_buffer.hpp"
+#include "partitioner.hpp"
 
 namespace filters::partition {
 
-    template<parameter::Partitioning, typename>
-    struct PartitionSet {
-    };
-
-    template<typename Vector>
-    struct PartitionSet<parameter::Partitioning::Disabled, Vector> {
+    /**
+     * removes duplicates from a partition in place and returns the number of distinct keys, the partition is sorted
+     * afterwards
+     */
+    template<typename T>
+    forceinline
+    size_t deduplicate(T *begin, size_t n_keys) {
+        std::sort(begin, begin + n_keys);
+        return std::unique(begin, begin + n_keys) - begin;
+    }
+
+    /**
+     * partitions the keys with Partitioner (Enabled or Hashed), with deduplication enabled every partition is
+     * deduplicated as soon as it is complete, partitions are small enough to be sorted within the cache. Only keys
+     * to build from may be deduplicated, counts of lookups have to include duplicates.
+     *
+     * Without partitioning there is a single partition: deduplication sorts a copy of all keys, which takes
+     * O(n log n) and is not cache-resident for large inputs.
+     */
+    template<parameter::Partitioning partitioning, typename Vector,
+            parameter::Deduplication deduplication = parameter::Deduplication::Disabled>
+    struct PartitionSet;
+
+    template<typename Vector, parameter::Deduplication deduplication>
+    struct PartitionSet<parameter::Partitioning::Disabled, Vector, deduplication> {
         using T = typename Vector::T;
+        static constexpr bool dedup = deduplication == parameter::Deduplication::Enabled;
 
         size_t n_partitions;
 
@@ -25,7 +47,7 @@ namespace filters::partition {
         T *histogram;
         T *offsets;
 
-        PartitionSet(size_t) : n_partitions(1) {
+        PartitionSet(size_t) : n_partitions(1), values(nullptr) {
             size_t n_bytes = simd::valign<Vector>(sizeof(T));
             histogram = simd::valloc<Vector>(n_bytes, 0);
             offsets = simd::valloc<Vector>(n_bytes, 0);
@@ -34,8 +56,18 @@ namespace filters::partition {
         forceinline
         void init(T *v, size_t l) {
             this->length = l;
-            this->values = v;
-            histogram[0] = l;
+            if constexpr (dedup) {
+                // the keys of the caller must not be reordered, thus a copy is deduplicated
+                if (values) {
+                    free(values);
+                }
+                values = reinterpret_cast<T *>(aligned_alloc(64, (l * sizeof(T) + 63) / 64 * 64));
+                std::memcpy(values, v, l * sizeof(T));
+                histogram[0] = deduplicate(values, l);
+            } else {
+                this->values = v;
+                histogram[0] = l;
+            }
         }
 
         template<typename TaskQueue>
@@ -45,15 +77,19 @@ namespace filters::partition {
         }
 
         ~PartitionSet() {
+            if (dedup and values) {
+                free(values);
+            }
             free(histogram);
             free(offsets);
         }
     };
 
-    template<typename Vector>
-    struct PartitionSet<parameter::Partitioning::Enabled, Vector> {
+    template<parameter::Partitioning partitioning, typename Vector, parameter::Deduplication deduplication>
+    struct PartitionSet {
         using T = typename Vector::T;
         using CLB = CacheLineBuffer<T>;
+        static constexpr bool dedup = deduplication == parameter::Deduplication::Enabled;
 
         size_t n_partitions;
 
@@ -77,13 +113,10 @@ namespace filters::partition {
 
         forceinline
         void init(T *v, size_t l) {
-            size_t partitioning_mask = 0;
-            if (n_partitions > 1) {
-                partitioning_mask = (1ull << math::get_number_of_bits(n_partitions)) - 1;
-            }
+            const Partitioner<partitioning, T> partitioner(n_partitions);
 
             for (size_t i = 0; i < l; i++) {
-                auto bucket = v[i] & partitioning_mask;
+                auto bucket = partitioner(v[i]);
                 histogram[bucket]++;
             }
 
@@ -104,7 +137,7 @@ namespace filters::partition {
 
             CLB *cacheLineBuffer = new CLB[n_partitions];
             for (size_t i = 0; i < l; i++) {
-                auto partition = v[i] & partitioning_mask;
+                auto partition = partitioner(v[i]);
                 cacheLineBuffer[partition].tuples[buffer_offset[partition]++] = v[i];
 
                 if (buffer_offset[partition] == CLB::n_tuples_per_cache_line_buffer) {
@@ -118,6 +151,9 @@ namespace filters::partition {
                 if (buffer_offset[i] != 0) {
                     cacheLineBuffer[i].store_non_temporal(start_pos[i]);
                 }
+                if constexpr (dedup) {
+                    histogram[i] = deduplicate(values + offsets[i], histogram[i]);
+                }
             }
 
             delete[](cacheLineBuffer);
@@ -126,10 +162,7 @@ namespace filters::partition {
         template<typename TaskQueue>
         forceinline
         void init(T *v, size_t l, TaskQueue &queue) {
-            size_t partitioning_mask = 0;
-            if (n_partitions > 1) {
-                partitioning_mask = (1ull << math::get_number_of_bits(n_partitions)) - 1;
-            }
+            const Partitioner<partitioning, T> partitioner(n_partitions);
 
             T **local_histograms = new T *[queue.get_n_tasks_per_level()];
             T **local_offsets = new T *[queue.get_n_tasks_per_level()];
@@ -144,13 +177,13 @@ namespace filters::partition {
 
             for (size_t i = 0, begin = 0; i < queue.get_n_tasks_per_level(); i++) {
                 size_t end = begin + (l - begin) / (queue.get_n_tasks_per_level() - i);
-                queue.add_task([this, i, begin, end, local_histograms, local_offsets, v, partitioning_mask](size_t) {
+                queue.add_task([this, i, begin, end, local_histograms, local_offsets, v, partitioner](size_t) {
                     local_histograms[i] = new T[n_partitions];
                     local_offsets[i] = new T[n_partitions];
                     std::memset(local_histograms[i], 0, n_partitions * sizeof(T));
 
                     for (T *iterator = v + begin; iterator < v + end; iterator++) {
-                        auto bucket = *iterator & partitioning_mask;
+                        auto bucket = partitioner(*iterator);
                         local_histograms[i][bucket]++;
                     }
                 });
@@ -183,11 +216,11 @@ namespace filters::partition {
             for (size_t i = 0, begin = 0; i < queue.get_n_tasks_per_level(); i++) {
                 size_t end = begin + (l - begin) / (queue.get_n_tasks_per_level() - i);
                 queue.add_task(
-                        [this, i, begin, end, cacheLineBuffers, buffer_offsets, local_offsets, partitioning_mask, v, local_histograms](
+                        [this, i, begin, end, cacheLineBuffers, buffer_offsets, local_offsets, partitioner, v, local_histograms](
                                 size_t thread) {
 
                             for (T *iterator = v + begin; iterator < v + end; iterator++) {
-                                auto partition = *iterator & partitioning_mask;
+                                auto partition = partitioner(*iterator);
                                 cacheLineBuffers[thread][partition].tuples[buffer_offsets[thread][partition]++] = *iterator;
 
                                 if (buffer_offsets[thread][partition] == CLB::n_tuples_per_cache_line_buffer) {
@@ -213,6 +246,20 @@ namespace filters::partition {
 
             queue.add_barrier();
 
+            if constexpr (dedup) {
+                for (size_t i = 0, begin = 0; i < queue.get_n_tasks_per_level(); i++) {
+                    size_t end = begin + (n_partitions - begin) / (queue.get_n_tasks_per_level() - i);
+                    queue.add_task([this, begin, end](size_t) {
+                        for (size_t partition = begin; partition < end; partition++) {
+                            histogram[partition] = deduplicate(values + offsets[partition], histogram[partition]);
+                        }
+                    });
+                    begin = end;
+                }
+
+                queue.add_barrier();
+            }
+
             queue.add_task([&queue, cacheLineBuffers, buffer_offsets, local_histograms, local_offsets](size_t) {
                 for (size_t i = 0; i < queue.get_n_threads(); i++) {
                     delete[](cacheLineBuffers[i]);
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <compiler/compiler_hints.hpp>
+#include <vqf/container/vqf_block.hpp>
+
+namespace filters::prefix {
+
+    /**
+     * first level bin of a prefix filter (a one cache line mini filter). A full bin only keeps the smallest
+     * (bucket, fingerprint) pairs that were inserted into it, larger ones are forwarded to the spare. Thus, a key
+     * whose bucket is smaller than the last bucket of a full bin can not be in the spare.
+     */
+    template<size_t k, parameter::SIMD simd>
+    struct alignas(64) PrefixBin : public vqf::VQFBlock<k, simd> {
+
+        using Block = vqf::VQFBlock<k, simd>;
+        using Fingerprint = typename Block::Fingerprint;
+
+        static_assert(Block::n_slots + Block::n_buckets == 64 * Block::n_words);
+
+        /**
+         * a bin is full iff the terminator of its last bucket is the last metadata bit
+         */
+        forceinline
+        bool full() const {
+            return this->metadata[Block::n_words - 1] >> 63;
+        }
+
+        /**
+         * bucket of the last fingerprint of a full bin, all following metadata bits terminate (empty) buckets
+         */
+        forceinline
+        size_t last_bucket() const {
+            for (size_t i = Block::n_words; i-- > 0;) {
+                const uint64_t zeros = ~this->metadata[i];
+                if (zeros) {
+                    return 64 * i + 63 - __builtin_clzll(zeros) - (Block::n_slots - 1);
+                }
+            }
+            return 0;
+        }
+
+        /**
+         * true if the spare has to be probed for a key with bucket
+         */
+        forceinline
+        bool overflows(const size_t bucket) const {
+            return full() and bucket >= last_bucket();
+        }
+
+        /**
+         * removes the largest fingerprint of the last bucket of a full bin
+         */
+        forceinline
+        std::pair<size_t, Fingerprint> remove_max() {
+            const size_t bucket = last_bucket();
+            const size_t begin = (bucket == 0) ? 0 : this->select(bucket - 1) - (bucket - 1);
+
+            size_t slot = begin;
+            for (size_t i = begin + 1; i < Block::n_slots; i++) {
+                if (this->fingerprints[i] > this->fingerprints[slot]) {
+                    slot = i;
+                }
+            }
+            const Fingerprint fingerprint = this->fingerprints[slot];
+
+            std::memmove(this->fingerprints + slot, this->fingerprints + slot + 1,
+                    (Block::n_slots - slot - 1) * sizeof(Fingerprint));
+            this->fingerprints[Block::n_slots - 1] = 0;
+
+            // drops the metadata bit of the slot, the bin was full, so a 0 is shifted in at the top
+            const size_t position = slot + bucket;
+            const size_t word = position / 64;
+            const uint64_t low = (1ull << (position % 64)) - 1;
+            uint64_t high = (this->metadata[word] >> 1) & ~low;
+            if (word + 1 < Block::n_words) {
+                high |= this->metadata[word + 1] << 63;
+            }
+            this->metadata[word] = (this->metadata[word] & low) | high;
+            for (size_t i = word + 1; i < Block::n_words; i++) {
+                this->metadata[i] = (this->metadata[i] >> 1) |
+                                    ((i + 1 < Block::n_words) ? this->metadata[i + 1] << 63 : 0);
+            }
+
+            return {bucket, fingerprint};
+        }
+
+        /**
+         * inserts (bucket, fingerprint) and returns the pair that has to go to the spare (if any)
+         */
+        forceinline
+        bool insert_or_evict(size_t &bucket, Fingerprint &fingerprint) {
+            if (not full()) {
+                this->insert(bucket, fingerprint);
+                return false;
+            }
+
+            const size_t max_bucket = last_bucket();
+            if (bucket > max_bucket) {
+                return true;
+            }
+            std::pair<size_t, Fingerprint> max = remove_max();
+            if (bucket == max.first and fingerprint >= max.second) {
+                // the new pair is the largest one, undo the removal
+                this->insert(max.first, max.second);
+                return true;
+            }
+            this->insert(bucket, fingerprint);
+            bucket = max.first;
+            fingerprint = max.second;
+            return true;
+        }
+    };
+
+    static_assert(sizeof(PrefixBin<8, parameter::SIMD::Scalar>) == 64);
+    static_assert(sizeof(PrefixBin<16, parameter::SIMD::Scalar>) == 64);
+
+} // filters::prefix
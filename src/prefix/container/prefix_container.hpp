@@ -0,0 +1,320 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <simd/helper.hpp>
+#include <simd/prefetch.hpp>
+#include <serialize/serializer.hpp>
+#include "prefix_bin.hpp"
+
+namespace filters::prefix {
+
+    /**
+     * bins of all partitions and the spare, a key is mapped to a single bin of its partition. Pairs that do not fit
+     * into their bin are inserted into the spare (a cuckoo filter) as key (bin, bucket, fingerprint). The spare keys
+     * have 64 bits, so the bin (relative to its partition) keeps 64 - 7 - k bits and pairs of different bins never
+     * share a key.
+     */
+    template<size_t spare_size, size_t spare_s, size_t k, parameter::Partitioning partitioning, parameter::SIMD simd,
+            typename Hasher, typename Vector, typename Addresser, typename Spare>
+    struct PrefixContainer {
+
+        using T = typename Vector::T;
+        using M = typename Vector::M;
+        using O = std::conditional_t<partitioning != parameter::Partitioning::Disabled, T *, T>;
+        using Bin = PrefixBin<k, simd>;
+        using Fingerprint = typename Bin::Fingerprint;
+        using SpareVector = typename Spare::Vector;
+        using SpareT = typename Spare::T;
+
+        // bits of the bucket in a spare key
+        static constexpr size_t bucket_bits = 7;
+        static_assert(Bin::n_buckets <= (1ull << bucket_bits));
+        static_assert(sizeof(SpareT) == 8, "spare keys need 64 bits!");
+
+        Addresser addresser;
+        Bin *bins;
+        size_t n_bytes;
+        // first bin of every partition
+        O offsets;
+        Spare spare;
+        memory::AllocationPolicy policy;
+        // set if the bins are used in place from a mapped file
+        std::shared_ptr<serialize::MappedFile> mapping;
+
+        struct Tag {
+            Vector bin;
+            Vector bucket;
+            Vector fingerprint;
+        };
+
+        PrefixContainer() : bins(nullptr), n_bytes(0), offsets(0) {
+        };
+
+        PrefixContainer(PrefixContainer &&other) noexcept: addresser(std::move(other.addresser)), bins(other.bins),
+                                                           n_bytes(other.n_bytes), offsets(other.offsets),
+                                                           spare(std::move(other.spare)), policy(other.policy),
+                                                           mapping(std::move(other.mapping)) {
+            other.bins = nullptr;
+            other.offsets = 0;
+        }
+
+        PrefixContainer &operator=(PrefixContainer &&other) noexcept {
+            if (this != &other) {
+                if (bins and n_bytes > 0 and not mapping) {
+                    simd::vfree(bins, n_bytes, policy);
+                }
+                if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                    if (offsets) {
+                        free(offsets);
+                    }
+                }
+
+                addresser = std::move(other.addresser);
+                bins = other.bins;
+                n_bytes = other.n_bytes;
+                offsets = other.offsets;
+                spare = std::move(other.spare);
+                policy = other.policy;
+                mapping = std::move(other.mapping);
+
+                other.bins = nullptr;
+                other.offsets = 0;
+            }
+
+            return *this;
+        }
+
+        PrefixContainer(size_t s, size_t n_partitions, const T *histogram, const memory::AllocationPolicy &policy = {})
+                : policy(policy) {
+            T *h = new T[n_partitions];
+            for (size_t i = 0; i < n_partitions; i++) {
+                h[i] = std::max((histogram[i] * s / 100 + Bin::n_slots - 1) / Bin::n_slots, 1ul);
+            }
+            addresser = std::move(Addresser(h, n_partitions));
+
+            delete[](h);
+
+            // the spare of a partition has room for at least a few overflowing pairs
+            const double overflow = spare_size / (100 * std::sqrt(2 * M_PI * Bin::n_slots));
+            SpareT *spare_histogram = new SpareT[n_partitions];
+            for (size_t i = 0; i < n_partitions; i++) {
+                spare_histogram[i] = static_cast<SpareT>(histogram[i] * overflow) + 16;
+            }
+            spare = std::move(Spare(spare_s, n_partitions, spare_histogram, policy));
+            delete[](spare_histogram);
+
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                offsets = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)), 0);
+            } else {
+                offsets = 0;
+            }
+
+            T last_offset = 0;
+            for (size_t i = 0; i < n_partitions; i++) {
+                if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                    offsets[i] = last_offset;
+                }
+                last_offset += addresser.get_size(i);
+            }
+
+            n_bytes = last_offset * sizeof(Bin);
+            bins = reinterpret_cast<Bin *>(simd::valloc<Vector>(n_bytes, 0, policy));
+            for (size_t i = 0; i < last_offset; i++) {
+                bins[i].init();
+            }
+        }
+
+        /**
+         * copies other into memory allocated with policy, e.g., a replica on another node
+         */
+        PrefixContainer(const PrefixContainer &other, const size_t n_partitions, const memory::AllocationPolicy &policy)
+                : addresser(other.addresser.copy(n_partitions)), n_bytes(other.n_bytes),
+                  spare(other.spare, n_partitions, policy), policy(policy) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                offsets = simd::vcopy<Vector>(other.offsets, n_partitions * sizeof(T));
+            } else {
+                offsets = other.offsets;
+            }
+            bins = reinterpret_cast<Bin *>(simd::valloc<Vector>(n_bytes, 0, policy));
+            std::memcpy(bins, other.bins, n_bytes);
+        }
+
+        ~PrefixContainer() {
+            if (bins and n_bytes > 0 and not mapping) {
+                simd::vfree(bins, n_bytes, policy);
+            }
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                if (offsets) {
+                    free(offsets);
+                }
+            }
+        }
+
+        void save(serialize::Writer &writer, const size_t n_partitions) const {
+            addresser.save(writer, n_partitions);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                writer.array(offsets, n_partitions * sizeof(T));
+            } else {
+                writer.value(offsets);
+            }
+            writer.array(bins, n_bytes);
+            spare.save(writer, n_partitions);
+        }
+
+        void load(serialize::Reader &reader) {
+            PrefixContainer loaded;
+            loaded.addresser.load(reader);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                loaded.offsets = reader.copy<T>();
+            } else {
+                loaded.offsets = reader.value<T>();
+            }
+            loaded.bins = reader.array<Bin>(loaded.n_bytes);
+            loaded.spare.load(reader);
+            loaded.mapping = reader.mapping();
+            *this = std::move(loaded);
+        }
+
+        forceinline
+        size_t length() const {
+            return n_bytes + spare.length();
+        }
+
+        forceinline
+        size_t offset(const size_t index) const {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                return offsets[index];
+            } else {
+                return offsets;
+            }
+        }
+
+        forceinline
+        Tag tag(const Vector &values, const size_t index) const {
+            const Vector hash0 = Hasher::hash(values);
+            const Vector hash1 = Hasher::template rehash<1>(hash0, values);
+
+            Tag tag;
+            tag.bin = Vector(offset(index)) +
+                      addresser.compute_address_vertical(index, simd::extractAddressBits(hash0));
+            tag.bucket = ((hash1 & Vector(0xffff)) * Vector(Bin::n_buckets)) >> 16;
+            tag.fingerprint = (hash1 >> 16) & Vector((1ull << k) - 1);
+            return tag;
+        }
+
+        /**
+         * key of a pair in the spare, the bin is relative to the partition
+         */
+        forceinline
+        SpareVector spare_key(const size_t bin, const size_t bucket, const size_t fingerprint,
+                              const size_t index) const {
+            return SpareVector(((static_cast<SpareT>(bin - offset(index)) << bucket_bits | bucket) << k) | fingerprint);
+        }
+
+        forceinline
+        size_t spare_index(const size_t index) const {
+            return (partitioning != parameter::Partitioning::Disabled) ? index : 0;
+        }
+
+        /**
+         * looks up all lanes in two passes: first the fingerprint of every lane is compared with all slots of its bin
+         * (Bin::match), then the bucket is located in the metadata (select) only for the lanes that matched any slot
+         * or whose bin is full and may have forwarded the pair to the spare
+         */
+        forceinline
+        M contains(const Vector &values, const size_t index, const M mask) const {
+            const Tag tag = this->tag(values, index);
+
+            uint64_t matches[Vector::n_elements];
+            M candidates = 0;
+            for (size_t lane = 0; lane < Vector::n_elements; lane++) {
+                if ((mask >> lane) & 1) {
+                    const Bin &bin = bins[tag.bin.elements[lane]];
+                    matches[lane] = bin.match(tag.fingerprint.elements[lane]);
+                    candidates |= static_cast<M>(matches[lane] != 0 or bin.full()) << lane;
+                }
+            }
+
+            M found = 0;
+            for (size_t lane = 0; lane < Vector::n_elements; lane++) {
+                if ((candidates >> lane) & 1) {
+                    const Bin &bin = bins[tag.bin.elements[lane]];
+                    const size_t bucket = tag.bucket.elements[lane];
+                    const Fingerprint fingerprint = tag.fingerprint.elements[lane];
+
+                    bool hit = matches[lane] and (matches[lane] & bin.slots(bucket)) != 0;
+                    if (not hit and bin.overflows(bucket)) {
+                        hit = spare.contains(spare_key(tag.bin.elements[lane], bucket, fingerprint, index),
+                                spare_index(index), 1);
+                    }
+                    found |= static_cast<M>(hit) << lane;
+                }
+            }
+            return found;
+        }
+
+        /**
+         * inserts all lanes one after another, pairs evicted from full bins are moved to the spare. If the spare is
+         * full, the bin is restored, so a rejected key does not push out one that was accepted before.
+         */
+        forceinline
+        M insert(const Vector &values, const size_t index, const M mask) {
+            const Tag tag = this->tag(values, index);
+
+            M inserted = 0;
+            for (size_t lane = 0; lane < Vector::n_elements; lane++) {
+                if ((mask >> lane) & 1) {
+                    Bin &bin = bins[tag.bin.elements[lane]];
+                    size_t bucket = tag.bucket.elements[lane];
+                    Fingerprint fingerprint = tag.fingerprint.elements[lane];
+
+                    bool success = true;
+                    const Bin backup = bin;
+                    if (bin.insert_or_evict(bucket, fingerprint)) {
+                        success = spare.insert(spare_key(tag.bin.elements[lane], bucket, fingerprint, index),
+                                spare_index(index), 1);
+                        if (not success) {
+                            bin = backup;
+                        }
+                    }
+                    inserted |= static_cast<M>(success) << lane;
+                }
+            }
+            return inserted;
+        }
+
+        /**
+         * prefetches the bin of every lane, the spare is rarely accessed
+         */
+        forceinline
+        void prefetch(const Vector &values, const size_t index, const M mask) const {
+            const Tag tag = this->tag(values, index);
+            simd::prefetch(bins, tag.bin * Vector(sizeof(Bin)), mask);
+        }
+
+        size_t count(const T *begin, const T *end, const size_t index) const {
+            size_t counter = 0;
+
+            for (; begin + Vector::n_elements <= end; begin += Vector::n_elements) {
+                const Vector values = Vector::load(begin);
+                counter += Vector::popcount_mask(contains(values, index, Vector::mask(1)));
+            }
+
+            if constexpr (Vector::avx) {
+                if (begin < end) {
+                    const M mask = (1 << (end - begin)) - 1;
+                    const Vector values = Vector::load(begin);
+                    counter += Vector::popcount_mask(contains(values, index, mask));
+                }
+            }
+
+            return counter;
+        }
+    };
+
+} // filters::prefix
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include <filter_base.hpp>
+#include <address/addresser.hpp>
+#include <hash/hasher.hpp>
+#include <cuckoo/container/cuckoo_container.hpp>
+#include <prefix/prefix_parameter.hpp>
+#include <prefix/container/prefix_container.hpp>
+#include <partition/partition_chunk.hpp>
+#include <partition/partition_set.hpp>
+#include <task/interleaved_lookup.hpp>
+
+namespace filters {
+
+    template<typename FilterParameter, size_t _k, typename OptimizationParameter>
+    struct Filter<FilterType::Prefix, FilterParameter, _k, OptimizationParameter>
+            : FilterBase<Filter<FilterType::Prefix, FilterParameter, _k, OptimizationParameter>,
+                    OptimizationParameter> {
+
+        using FP = FilterParameter;
+        static constexpr size_t k = _k;
+        using OP = OptimizationParameter;
+        // bins are filled by insertion, so keys can be added at any time (until the spare is full)
+        static constexpr bool supports_add = true;
+        static constexpr bool supports_add_partition = true;
+        // a rejected add leaves the filter unchanged, see PrefixContainer::insert
+        static constexpr bool supports_failsafe_add = true;
+
+        using Vector = simd::Vector<OP::registerSize, OP::simd>;
+        using T = typename Vector::T;
+        using M = typename Vector::M;
+        using Base = FilterBase<Filter, OptimizationParameter>;
+        using Base::local_container;
+        using Base::replicate;
+        using Hasher = hash::Hasher<OP::hashingMode, Vector, 1>;
+        using Addresser = addresser::Addresser<OP::addressingMode, Vector>;
+        using PartitionSet = typename partition::PartitionSet<OP::partitioning, Vector>;
+        using BuildPartitionSet = typename partition::PartitionSet<OP::partitioning, Vector, OP::deduplication>;
+
+        // the spare is a scalar standard cuckoo filter with 64-bit keys (see PrefixContainer), at most a few keys per
+        // bin are inserted into it. It evicts with a bounded BFS, a failed insert into it has to leave every accepted
+        // key in place
+        static constexpr size_t spare_associativity = std::min(FP::spare_associativity, 64 / k);
+        static constexpr size_t spare_bfs_depth = 5;
+        using Spare = cuckoo::CuckooContainer<false, cuckoo::Variant::Standard, spare_associativity, 0, 0, k,
+                OP::partitioning, parameter::RegisterSize::_64bit, parameter::SIMD::Scalar, OP::addressingMode,
+                OP::hashingMode, spare_bfs_depth>;
+        using Container = prefix::PrefixContainer<FP::spare_size, FP::spare_s, k, OP::partitioning, OP::simd, Hasher,
+                Vector, Addresser, Spare>;
+
+        size_t s;
+        size_t n_partitions;
+        Container container;
+        task::TaskQueue<OP::multiThreading> queue;
+        memory::AllocationPolicy policy;
+        std::vector<Container> replicas;
+        // lookahead of unpartitioned lookups in vectors, 0 disables software prefetching
+        size_t prefetch_distance{0};
+
+        Filter(size_t s, size_t n_partitions, size_t n_threads, size_t n_tasks_per_level,
+               const memory::AllocationPolicy &policy = {}) : s(s), n_partitions(n_partitions),
+                                                              queue(n_threads, n_tasks_per_level), policy(policy) {
+        }
+
+        forceinline
+        void init(const T *histogram) {
+            n_partitions = std::max(n_partitions, 1ul);
+            container = std::move(Container(s, n_partitions, histogram, policy));
+            replicas.clear();
+            prefetch_distance = simd::prefetch_distance(size());
+        }
+
+        forceinline
+        bool contains(const T &value) const {
+            return contains(value, partition::partition_of<OP::partitioning>(value, n_partitions));
+        }
+
+        forceinline
+        bool contains(const T &value, size_t index) const {
+            if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
+                return local_container().contains(Vector(value), 0, 1);
+            } else {
+                return local_container().contains(Vector(value), index, 1);
+            }
+        }
+
+        forceinline
+        bool add_all(const T *values, size_t length) {
+            return add_partition(values, length, 0);
+        }
+
+        forceinline
+        bool add_partition(const T *values, size_t length, size_t index) {
+            replicas.clear();
+            if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
+                return _construct(values, length, 0);
+            } else {
+                return _construct(values, length, index);
+            }
+        }
+
+        forceinline
+        bool add(const T &value) {
+            return add(value, partition::partition_of<OP::partitioning>(value, n_partitions));
+        }
+
+        forceinline
+        bool add(const T &value, size_t index) {
+            replicas.clear();
+            if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
+                return container.insert(Vector(value), 0, 1);
+            } else {
+                return container.insert(Vector(value), index, 1);
+            }
+        }
+
+        /**
+         * inserts the keys of a partition a vector at a time (hashing and addressing is vectorized)
+         */
+        bool _construct(const T *values, const size_t length, const size_t index) {
+            bool success = true;
+            for (size_t i = 0; i < length; i += Vector::n_elements) {
+                M mask = Vector::mask(1);
+                if constexpr (Vector::avx) {
+                    if (length - i < Vector::n_elements) {
+                        mask = (1 << (length - i)) - 1;
+                    }
+                }
+                success &= (container.insert(Vector::loadu(values + i, mask), index, mask) == mask);
+            }
+            return success;
+        }
+
+        bool construct(T *values, size_t length) {
+            replicas.clear();
+            BuildPartitionSet partitions(n_partitions);
+            n_partitions = partitions.n_partitions;
+
+            if constexpr (OP::multiThreading == parameter::MultiThreading::Disabled) {
+                bool success = true;
+                partitions.init(values, length);
+                container = std::move(Container(s, n_partitions, partitions.histogram, policy));
+
+                for (size_t i = 0; i < partitions.n_partitions; i++) {
+                    success &= _construct(partitions.values + partitions.offsets[i], partitions.histogram[i], i);
+                }
+
+                prefetch_distance = simd::prefetch_distance(size());
+                if (success and policy.placement == memory::Placement::Replicated) {
+                    replicate();
+                }
+                return success;
+            } else {
+                partitions.init(values, length, queue);
+                std::atomic<uint8_t> success{1};
+
+                queue.add_task([&](size_t) {
+                    container = std::move(Container(s, n_partitions, partitions.histogram, policy));
+                });
+                queue.add_barrier();
+                for (size_t i = 0; i < partitions.n_partitions; i++) {
+                    queue.add_task([this, &partitions, &success, i](size_t) {
+                        success &= _construct(partitions.values + partitions.offsets[i], partitions.histogram[i], i);
+                    });
+                }
+                queue.execute_tasks();
+
+                prefetch_distance = simd::prefetch_distance(size());
+                if (success and policy.placement == memory::Placement::Replicated) {
+                    replicate();
+                }
+                return success;
+            }
+        }
+
+        forceinline
+        M _contains(const Container &local, const Vector &keys, const M mask, const size_t index) const {
+            return local.contains(keys, index, mask);
+        }
+
+        forceinline
+        void _prefetch(const Container &local, const Vector &keys, const M mask, const size_t index) const {
+            local.prefetch(keys, index, mask);
+        }
+
+        static std::string signature() {
+            return "Prefix;" + std::to_string(k) + ";" + FP::to_string() + ";" + OP::to_string();
+        }
+
+        size_t size() const {
+            return container.length();
+        }
+
+        size_t avg_size() const {
+            return size() / n_partitions;
+        }
+
+        size_t retries() {
+            return 0;
+        }
+
+        std::string to_string() {
+            std::string s = "\n{\n";
+            s += "\t\"k\": " + std::to_string(k) + ",\n";
+            s += "\t\"size\": " + std::to_string(size() * 8) + " bits,\n";
+            s += "\t\"n_partitions\": " + std::to_string(n_partitions) + ",\n";
+            s += "\t\"allocation\": " + policy.to_string() + ",\n";
+            s += "\t\"filter_params\": " + FP::to_string() + ",\n";
+            s += "\t\"optimization_params\": " + OP::to_string() + "\n";
+            s += "}\n";
+
+            return s;
+        }
+    };
+
+} // filters
\ No newline at end of file
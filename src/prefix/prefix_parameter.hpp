@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <parameter/parameter.hpp>
+
+namespace filters::prefix {
+
+    /**
+     * the spare is a cuckoo filter that holds the pairs overflowing from full bins. It is sized for spare_size percent
+     * of the expected overflow of bins at 100% load, i.e., 1 / sqrt(2 * pi * n_slots) of the keys.
+     */
+    template<size_t _spare_size>
+    struct PrefixParameter {
+        static constexpr size_t spare_size = _spare_size;
+        static constexpr size_t spare_associativity = 4;
+        // load of the spare if it holds spare_size percent of the expected overflow
+        static constexpr size_t spare_s = 105;
+
+        static std::string to_string() {
+            std::string s = "{";
+            s += "\"spare_size\": " + std::to_string(spare_size) + ", ";
+            s += "\"spare_associativity\": " + std::to_string(spare_associativity) + ", ";
+            s += "\"spare_s\": " + std::to_string(spare_s) + "}";
+            return s;
+        }
+    };
+
+    template<size_t> using Standard = PrefixParameter<150>;
+    template<size_t> using Compact = PrefixParameter<110>;
+
+} // filters::prefix
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <compiler/compiler_hints.hpp>
+#include "ribbon_helper.hpp"
+
+namespace filters::ribbon {
+
+    /**
+     * banding of a single partition: every slot holds at most one row whose first coefficient is set (the pivot).
+     * Rows are added by eliminating them with the pivots they hit, which keeps the band at width coefficients.
+     */
+    template<Variant variant, size_t width, size_t k>
+    struct RibbonBanding {
+
+        static_assert(k <= 32, "ribbon filters support at most 32-bit fingerprints!");
+
+        using R = Row<width>;
+
+        std::vector<R> rows;
+        std::vector<uint32_t> results;
+        // slots of the rows added since the last commit()
+        std::vector<size_t> added;
+
+        explicit RibbonBanding(const size_t n_slots) : rows(n_slots, 0), results(n_slots, 0) {
+        }
+
+        forceinline
+        static size_t count_trailing_zeros(const R &row) {
+            if constexpr (width == 64) {
+                return __builtin_ctzll(row);
+            } else {
+                const uint64_t low = static_cast<uint64_t>(row);
+                return low ? __builtin_ctzll(low) : 64 + __builtin_ctzll(static_cast<uint64_t>(row >> 64));
+            }
+        }
+
+        /**
+         * adds the equation row * solution[start, start + width) = result, fails if it contradicts the equations
+         * added before (never happens for homogeneous ribbons). Logged rows can be removed again by rollback().
+         */
+        template<bool log = false>
+        forceinline
+        bool add(size_t start, R row, uint32_t result) {
+            while (true) {
+                if (rows[start] == 0) {
+                    rows[start] = row;
+                    results[start] = result;
+                    if constexpr (log) {
+                        added.push_back(start);
+                    }
+                    return true;
+                }
+
+                row ^= rows[start];
+                result ^= results[start];
+                if (row == 0) {
+                    return result == 0;
+                }
+
+                const size_t shift = count_trailing_zeros(row);
+                row >>= shift;
+                start += shift;
+            }
+        }
+
+        void commit() {
+            added.clear();
+        }
+
+        /**
+         * removes the logged rows added since the last commit(), a failed add() has not changed any row
+         */
+        void rollback() {
+            for (const size_t slot : added) {
+                rows[slot] = 0;
+                results[slot] = 0;
+            }
+            added.clear();
+        }
+
+        /**
+         * solves the banded equations from the last slot to the first and writes the solution interleaved: the
+         * k bits of a slot are spread over k words, one per fingerprint bit, of its 64-slot block
+         */
+        void back_substitute(uint64_t *solution, uint64_t seed) const {
+            R state[k] = {0};
+            uint64_t words[k] = {0};
+
+            for (size_t i = rows.size(); i-- > 0;) {
+                // free slots are random, otherwise the solution of a homogeneous ribbon would be 0
+                seed = seed * 0x5851f42d4c957f2d + 0x14057b7ef767814f;
+                const uint32_t random = seed >> 32;
+
+                for (size_t b = 0; b < k; b++) {
+                    state[b] <<= 1;
+                    const uint64_t bit = (rows[i] == 0)
+                                         ? (random >> b) & 0b1
+                                         : ((results[i] >> b) & 0b1) ^ ribbon_parity(rows[i] & state[b]);
+                    state[b] |= bit;
+                    words[b] |= bit << (i & 63);
+                }
+
+                if ((i & 63) == 0) {
+                    for (size_t b = 0; b < k; b++) {
+                        solution[(i / 64) * k + b] = words[b];
+                        words[b] = 0;
+                    }
+                }
+            }
+        }
+    };
+
+} // filters::ribbon
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <simd/helper.hpp>
+#include <simd/prefetch.hpp>
+#include <serialize/serializer.hpp>
+#include "ribbon_helper.hpp"
+
+namespace filters::ribbon {
+
+    /**
+     * solutions of all partitions, a partition is a sequence of 64-slot blocks and a block consists of k words (one
+     * per fingerprint bit). A key starting in slot s of a partition combines the slots [s, s + width).
+     */
+    template<Variant variant, size_t width, size_t k, parameter::Partitioning partitioning, typename Hasher,
+            typename Vector, typename Addresser>
+    struct RibbonContainer {
+
+        static_assert(Vector::registerSize == parameter::RegisterSize::_64bit,
+                "ribbon filters need 64-bit registers for their coefficients!");
+
+        using T = typename Vector::T;
+        using M = typename Vector::M;
+        using O = std::conditional_t<partitioning != parameter::Partitioning::Disabled, T *, T>;
+
+        Addresser addresser;
+        uint64_t *solution;
+        size_t n_bytes;
+        // first block of every partition
+        O offsets;
+        O seeds;
+        memory::AllocationPolicy policy;
+        // set if the solution is used in place from a mapped file
+        std::shared_ptr<serialize::MappedFile> mapping;
+
+        RibbonContainer() : solution(nullptr), n_bytes(0), offsets(0), seeds(0) {
+        };
+
+        RibbonContainer(RibbonContainer &&other) noexcept: addresser(std::move(other.addresser)),
+                                                           solution(other.solution), n_bytes(other.n_bytes),
+                                                           offsets(other.offsets), seeds(other.seeds),
+                                                           policy(other.policy), mapping(std::move(other.mapping)) {
+            other.solution = nullptr;
+            other.offsets = 0;
+            other.seeds = 0;
+        }
+
+        RibbonContainer &operator=(RibbonContainer &&other) noexcept {
+            if (this != &other) {
+                if (solution and n_bytes > 0 and not mapping) {
+                    simd::vfree(solution, n_bytes, policy);
+                }
+                if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                    if (offsets) {
+                        free(offsets);
+                    }
+                    if (seeds) {
+                        free(seeds);
+                    }
+                }
+
+                addresser = std::move(other.addresser);
+                solution = other.solution;
+                n_bytes = other.n_bytes;
+                offsets = other.offsets;
+                seeds = other.seeds;
+                policy = other.policy;
+                mapping = std::move(other.mapping);
+
+                other.solution = nullptr;
+                other.offsets = 0;
+                other.seeds = 0;
+            }
+
+            return *this;
+        }
+
+        RibbonContainer(size_t s, size_t n_partitions, const T *histogram, const memory::AllocationPolicy &policy = {})
+                : policy(policy) {
+            T *h = new T[n_partitions];
+            for (size_t i = 0; i < n_partitions; i++) {
+                h[i] = ribbon_n_starts(histogram[i], s);
+            }
+            addresser = std::move(Addresser(h, n_partitions));
+            delete[](h);
+
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                offsets = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)), 0);
+                seeds = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)), 0);
+            } else {
+                offsets = 0;
+                seeds = 0;
+            }
+
+            T last_offset = 0;
+            for (size_t i = 0; i < n_partitions; i++) {
+                if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                    offsets[i] = last_offset;
+                }
+                last_offset += ribbon_n_blocks<width>(addresser.get_size(i));
+            }
+
+            n_bytes = simd::valign<Vector>(last_offset * k * sizeof(uint64_t));
+            solution = simd::valloc<Vector>(n_bytes, 0, policy);
+        }
+
+        /**
+         * copies other into memory allocated with policy, e.g., a replica on another node
+         */
+        RibbonContainer(const RibbonContainer &other, const size_t n_partitions,
+                        const memory::AllocationPolicy &policy) : addresser(other.addresser.copy(n_partitions)),
+                                                                  n_bytes(other.n_bytes), policy(policy) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                offsets = simd::vcopy<Vector>(other.offsets, n_partitions * sizeof(T));
+                seeds = simd::vcopy<Vector>(other.seeds, n_partitions * sizeof(T));
+            } else {
+                offsets = other.offsets;
+                seeds = other.seeds;
+            }
+            solution = simd::valloc<Vector>(n_bytes, 0, policy);
+            std::memcpy(solution, other.solution, n_bytes);
+        }
+
+        ~RibbonContainer() {
+            if (solution and n_bytes > 0 and not mapping) {
+                simd::vfree(solution, n_bytes, policy);
+            }
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                if (offsets) {
+                    free(offsets);
+                }
+                if (seeds) {
+                    free(seeds);
+                }
+            }
+        }
+
+        void save(serialize::Writer &writer, const size_t n_partitions) const {
+            addresser.save(writer, n_partitions);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                writer.array(offsets, n_partitions * sizeof(T));
+                writer.array(seeds, n_partitions * sizeof(T));
+            } else {
+                writer.value(offsets);
+                writer.value(seeds);
+            }
+            writer.array(solution, n_bytes);
+        }
+
+        void load(serialize::Reader &reader) {
+            RibbonContainer loaded;
+            loaded.addresser.load(reader);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                loaded.offsets = reader.copy<T>();
+                loaded.seeds = reader.copy<T>();
+            } else {
+                loaded.offsets = reader.value<T>();
+                loaded.seeds = reader.value<T>();
+            }
+            loaded.solution = reader.array<uint64_t>(loaded.n_bytes);
+            loaded.mapping = reader.mapping();
+            *this = std::move(loaded);
+        }
+
+        forceinline
+        size_t length() const {
+            return n_bytes;
+        }
+
+        forceinline
+        size_t offset(const size_t index) const {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                return offsets[index];
+            } else {
+                return offsets;
+            }
+        }
+
+        forceinline
+        size_t n_slots(const size_t index) const {
+            return ribbon_n_blocks<width>(addresser.get_size(index)) * 64;
+        }
+
+        forceinline
+        Vector seed_vertical(const size_t index) const {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                return Vector(seeds[index]);
+            } else {
+                return Vector(seeds);
+            }
+        }
+
+        forceinline
+        void set_seed(const T &seed, const size_t index) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                seeds[index] = seed;
+            } else {
+                seeds = seed;
+            }
+        }
+
+        forceinline
+        Vector start(const Vector &hash, const size_t index) const {
+            return addresser.compute_address_vertical(index, simd::extractAddressBits(hash));
+        }
+
+        /**
+         * solution words of the fingerprint bit b at 64-bit slot offset shift of the blocks starting at address
+         */
+        forceinline
+        Vector window(const Vector &address, const Vector &shift, const size_t b, const M mask) const {
+            const Vector low = (address + Vector(b)).gather(solution, mask);
+            const Vector high = (address + Vector(k + b)).gather(solution, mask);
+            // shifts by 64 are not defined for scalar vectors
+            return (low >> shift) | ((high << 1) << (Vector(63) - shift));
+        }
+
+        forceinline
+        M contains_hash(const Vector &hash, const size_t index, const M mask) const {
+            const Vector start = this->start(hash, index);
+            const Vector shift = start & Vector(63);
+            const Vector address = (Vector(offset(index)) + (start >> 6)) * Vector(k);
+
+            const Vector coefficients0 = ribbon_coefficients<0>(hash);
+            Vector coefficients1(0);
+            if constexpr (width == 128) {
+                coefficients1 = ribbon_coefficients<1>(hash);
+            }
+
+            Vector result(0);
+            for (size_t b = 0; b < k; b++) {
+                Vector product = window(address, shift, b, mask) & coefficients0;
+                if constexpr (width == 128) {
+                    product = product ^ (window(address + Vector(k), shift, b, mask) & coefficients1);
+                }
+                result = result | ((product.popcount() & Vector(1)) << b);
+            }
+
+            return mask & (result == ribbon_result<variant, k>(hash));
+        }
+
+        forceinline
+        size_t contains(const T &value, const size_t index) const {
+            const Vector hash = Hasher::hash(Vector(value) ^ seed_vertical(index));
+            return contains_hash(hash, index, 1);
+        }
+
+        forceinline
+        M contains(const Vector &values, const size_t index, const M mask) const {
+            const Vector hash = Hasher::hash(values ^ seed_vertical(index));
+            return contains_hash(hash, index, mask);
+        }
+
+        /**
+         * prefetches the blocks of every lane
+         */
+        forceinline
+        void prefetch(const Vector &values, const size_t index, const M mask) const {
+            const Vector hash = Hasher::hash(values ^ seed_vertical(index));
+            const Vector address = (Vector(offset(index)) + (start(hash, index) >> 6)) * Vector(k * sizeof(uint64_t));
+
+            for (size_t line = 0; line < (width / 64 + 1) * k * sizeof(uint64_t); line += 64) {
+                simd::prefetch(solution, address + Vector(line), mask);
+            }
+        }
+
+        size_t count(const T *begin, const T *end, const size_t index) const {
+            const Vector seed = seed_vertical(index);
+
+            size_t counter = 0;
+
+            for (; begin + Vector::n_elements <= end; begin += Vector::n_elements) {
+                const Vector values = Vector::load(begin);
+                const Vector hash = Hasher::hash(values ^ seed);
+
+                counter += Vector::popcount_mask(contains_hash(hash, index, Vector::mask(1)));
+            }
+
+            if constexpr (Vector::avx) {
+                if (begin < end) {
+                    const M mask = (1 << (end - begin)) - 1;
+                    const Vector values = Vector::load(begin);
+                    const Vector hash = Hasher::hash(values ^ seed);
+
+                    counter += Vector::popcount_mask(contains_hash(hash, index, mask));
+                }
+            }
+
+            return counter;
+        }
+    };
+
+} // filters::ribbon
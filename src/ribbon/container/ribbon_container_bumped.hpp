@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <simd/helper.hpp>
+#include <serialize/serializer.hpp>
+#include "ribbon_container.hpp"
+
+namespace filters::ribbon {
+
+    /**
+     * bumped ribbon (BuRR): every 64-slot block of the layer has a 2-bit threshold code, keys starting in a block
+     * below its threshold are bumped to the fallback, a standard ribbon of the bumped keys only. Bumping keys instead
+     * of retrying the whole partition lets the layer run with almost no spare slots.
+     */
+    template<size_t width, size_t k, parameter::Partitioning partitioning, typename Hasher, typename Vector,
+            typename Addresser>
+    struct BumpedRibbonContainer {
+
+        using T = typename Vector::T;
+        using M = typename Vector::M;
+        using Layer = RibbonContainer<Variant::Standard, width, k, partitioning, Hasher, Vector, Addresser>;
+
+        static constexpr size_t n_codes = 4;
+        // the fallback holds a few percent of the keys, its spare slots hardly add to the size of the filter
+        static constexpr size_t fallback_s = 120;
+
+        Layer layer;
+        Layer fallback;
+        // 32 codes per word
+        uint64_t *thresholds;
+        size_t n_threshold_bytes;
+        memory::AllocationPolicy policy;
+        // set if the thresholds are used in place from a mapped file
+        std::shared_ptr<serialize::MappedFile> mapping;
+
+        /**
+         * first slot of a block that is not bumped by code: 0, 16, 32 and 64 (the whole block)
+         */
+        forceinline
+        static constexpr size_t threshold(const size_t code) {
+            return (8ul << code) & ~15ul;
+        }
+
+        BumpedRibbonContainer() : thresholds(nullptr), n_threshold_bytes(0) {
+        };
+
+        BumpedRibbonContainer(BumpedRibbonContainer &&other) noexcept: layer(std::move(other.layer)),
+                                                                       fallback(std::move(other.fallback)),
+                                                                       thresholds(other.thresholds),
+                                                                       n_threshold_bytes(other.n_threshold_bytes),
+                                                                       policy(other.policy),
+                                                                       mapping(std::move(other.mapping)) {
+            other.thresholds = nullptr;
+        }
+
+        BumpedRibbonContainer &operator=(BumpedRibbonContainer &&other) noexcept {
+            if (this != &other) {
+                if (thresholds and n_threshold_bytes > 0 and not mapping) {
+                    simd::vfree(thresholds, n_threshold_bytes, policy);
+                }
+
+                layer = std::move(other.layer);
+                fallback = std::move(other.fallback);
+                thresholds = other.thresholds;
+                n_threshold_bytes = other.n_threshold_bytes;
+                policy = other.policy;
+                mapping = std::move(other.mapping);
+
+                other.thresholds = nullptr;
+            }
+
+            return *this;
+        }
+
+        /**
+         * the fallback is allocated by init_fallback() once the number of bumped keys is known
+         */
+        BumpedRibbonContainer(size_t s, size_t n_partitions, const T *histogram,
+                              const memory::AllocationPolicy &policy = {}) : layer(s, n_partitions, histogram, policy),
+                                                                             policy(policy) {
+            const size_t n_blocks = layer.n_bytes / (k * sizeof(uint64_t));
+            n_threshold_bytes = simd::valign<Vector>((n_blocks / 32 + 1) * sizeof(uint64_t));
+            thresholds = simd::valloc<Vector>(n_threshold_bytes, 0, policy);
+        }
+
+        /**
+         * copies other into memory allocated with policy, e.g., a replica on another node
+         */
+        BumpedRibbonContainer(const BumpedRibbonContainer &other, const size_t n_partitions,
+                              const memory::AllocationPolicy &policy) : layer(other.layer, n_partitions, policy),
+                                                                        fallback(other.fallback, n_partitions, policy),
+                                                                        n_threshold_bytes(other.n_threshold_bytes),
+                                                                        policy(policy) {
+            thresholds = simd::valloc<Vector>(n_threshold_bytes, 0, policy);
+            std::memcpy(thresholds, other.thresholds, n_threshold_bytes);
+        }
+
+        ~BumpedRibbonContainer() {
+            if (thresholds and n_threshold_bytes > 0 and not mapping) {
+                simd::vfree(thresholds, n_threshold_bytes, policy);
+            }
+        }
+
+        void init_fallback(size_t n_partitions, const T *histogram) {
+            fallback = std::move(Layer(fallback_s, n_partitions, histogram, policy));
+        }
+
+        /**
+         * partitions are built concurrently and may share a word of codes
+         */
+        forceinline
+        void set_threshold(const size_t block, const size_t code) {
+            if (code > 0) {
+                std::atomic_ref<uint64_t>(thresholds[block / 32]).fetch_or(static_cast<uint64_t>(code)
+                        << ((block % 32) * 2), std::memory_order_relaxed);
+            }
+        }
+
+        void save(serialize::Writer &writer, const size_t n_partitions) const {
+            layer.save(writer, n_partitions);
+            fallback.save(writer, n_partitions);
+            writer.array(thresholds, n_threshold_bytes);
+        }
+
+        void load(serialize::Reader &reader) {
+            BumpedRibbonContainer loaded;
+            loaded.layer.load(reader);
+            loaded.fallback.load(reader);
+            loaded.thresholds = reader.array<uint64_t>(loaded.n_threshold_bytes);
+            loaded.mapping = reader.mapping();
+            *this = std::move(loaded);
+        }
+
+        forceinline
+        size_t length() const {
+            return layer.length() + fallback.length() + n_threshold_bytes;
+        }
+
+        /**
+         * lanes whose key starts below the threshold of its block
+         */
+        forceinline
+        M bumped(const Vector &start, const size_t index, const M mask) const {
+            const Vector block = Vector(layer.offset(index)) + (start >> 6);
+            const Vector code = ((block >> 5).gather(thresholds, mask) >> ((block & Vector(31)) << 1)) & Vector(3);
+            return mask & ((start & Vector(63)) < ((Vector(8) << code) & Vector(~15ul)));
+        }
+
+        forceinline
+        M contains(const Vector &values, const size_t index, const M mask) const {
+            const Vector hash = Hasher::hash(values ^ layer.seed_vertical(index));
+            const M bumped = this->bumped(layer.start(hash, index), index, mask);
+
+            if constexpr (Vector::avx) {
+                M found = layer.contains_hash(hash, index, mask & ~bumped);
+                if (bumped) {
+                    found |= fallback.contains(values, index, bumped);
+                }
+                return found;
+            } else {
+                return bumped ? fallback.contains(values, index, mask) : layer.contains_hash(hash, index, mask);
+            }
+        }
+
+        forceinline
+        size_t contains(const T &value, const size_t index) const {
+            return contains(Vector(value), index, 1);
+        }
+
+        /**
+         * prefetches the blocks of every lane in the layer, the fallback is small and rarely probed
+         */
+        forceinline
+        void prefetch(const Vector &values, const size_t index, const M mask) const {
+            layer.prefetch(values, index, mask);
+        }
+
+        size_t count(const T *begin, const T *end, const size_t index) const {
+            size_t counter = 0;
+
+            for (; begin + Vector::n_elements <= end; begin += Vector::n_elements) {
+                counter += Vector::popcount_mask(contains(Vector::load(begin), index, Vector::mask(1)));
+            }
+
+            if constexpr (Vector::avx) {
+                if (begin < end) {
+                    const M mask = (1 << (end - begin)) - 1;
+                    counter += Vector::popcount_mask(contains(Vector::load(begin), index, mask));
+                }
+            }
+
+            return counter;
+        }
+    };
+
+} // filters::ribbon
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <compiler/compiler_hints.hpp>
+#include <hash/hash.hpp>
+#include <math/math.hpp>
+#include <ribbon/ribbon_parameter.hpp>
+
+namespace filters::ribbon {
+
+    template<size_t width>
+    using Row = std::conditional_t<width == 64, uint64_t, unsigned __int128>;
+
+    /**
+     * number of start positions of a partition with n_keys keys
+     */
+    forceinline
+    static size_t ribbon_n_starts(const size_t n_keys, const size_t s) {
+        return std::max(n_keys * s / 100, 1ul);
+    }
+
+    /**
+     * number of 64-slot blocks of a partition, the last block is read (and ignored) by lookups starting at the end
+     */
+    template<size_t width>
+    forceinline
+    static size_t ribbon_n_blocks(const size_t n_starts) {
+        return (n_starts - 1) / 64 + width / 64 + 1;
+    }
+
+    /**
+     * j-th 64 coefficients of a key, the first coefficient is always set
+     */
+    template<size_t j, typename Vector>
+    forceinline
+    static Vector ribbon_coefficients(const Vector &hash) {
+        const Vector coefficients = hash::murmur(hash ^ Vector(0x9e3779b97f4a7c15));
+        if constexpr (j == 0) {
+            return coefficients | Vector(1);
+        } else {
+            return hash::murmur(coefficients ^ Vector(0xbf58476d1ce4e5b9));
+        }
+    }
+
+    template<Variant variant, size_t k, typename Vector>
+    forceinline
+    static Vector ribbon_result(const Vector &hash) {
+        if constexpr (variant == Variant::Homogeneous) {
+            return Vector(0);
+        } else {
+            return (hash * Vector(0x94d049bb133111eb)) >> (64 - k);
+        }
+    }
+
+    template<size_t width, typename Vector>
+    forceinline
+    static Row<width> ribbon_row(const Vector &coefficients0, const Vector &coefficients1, const size_t lane) {
+        if constexpr (width == 64) {
+            return coefficients0.elements[lane];
+        } else {
+            return (static_cast<Row<width>>(coefficients1.elements[lane]) << 64) | coefficients0.elements[lane];
+        }
+    }
+
+    template<typename R>
+    forceinline
+    static uint64_t ribbon_parity(const R &row) {
+        if constexpr (sizeof(R) == 8) {
+            return __builtin_parityll(row);
+        } else {
+            return __builtin_parityll(static_cast<uint64_t>(row) ^ static_cast<uint64_t>(row >> 64));
+        }
+    }
+
+} // filters::ribbon
@@ -0,0 +1,385 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include <filter_base.hpp>
+#include <address/addresser.hpp>
+#include <hash/hasher.hpp>
+#include <hash/seed.hpp>
+#include <ribbon/ribbon_parameter.hpp>
+#include <ribbon/container/ribbon_banding.hpp>
+#include <ribbon/container/ribbon_container.hpp>
+#include <ribbon/container/ribbon_container_bumped.hpp>
+#include <partition/partition_chunk.hpp>
+#include <partition/partition_set.hpp>
+#include <task/interleaved_lookup.hpp>
+
+namespace filters {
+
+    template<typename FilterParameter, size_t _k, typename OptimizationParameter>
+    struct Filter<FilterType::Ribbon, FilterParameter, _k, OptimizationParameter>
+            : FilterBase<Filter<FilterType::Ribbon, FilterParameter, _k, OptimizationParameter>,
+                    OptimizationParameter> {
+
+        using FP = FilterParameter;
+        static constexpr size_t k = _k;
+        static constexpr ribbon::Variant variant = FP::variant;
+        static constexpr size_t width = FP::width;
+        static constexpr size_t max_n_retries = FP::max_n_retries;
+        using OP = OptimizationParameter;
+        static constexpr bool supports_add = false;
+        static constexpr bool supports_failsafe_add = false;
+        // a bumped ribbon sizes its fallback after banding all partitions
+        static constexpr bool supports_add_partition = variant != ribbon::Variant::Bumped;
+
+        using Vector = simd::Vector<OP::registerSize, OP::simd>;
+        using T = typename Vector::T;
+        using M = typename Vector::M;
+        using Base = FilterBase<Filter, OptimizationParameter>;
+        using Base::local_container;
+        using Base::replicate;
+        using Hasher = hash::Hasher<OP::hashingMode, Vector, 1>;
+        using Addresser = addresser::Addresser<OP::addressingMode, Vector>;
+        using PartitionSet = typename partition::PartitionSet<OP::partitioning, Vector>;
+        using BuildPartitionSet = typename partition::PartitionSet<OP::partitioning, Vector, OP::deduplication>;
+
+        using Banding = ribbon::RibbonBanding<variant, width, k>;
+        // the layers of a bumped ribbon are standard ribbons
+        static constexpr ribbon::Variant layer_variant = (variant == ribbon::Variant::Bumped)
+                                                         ? ribbon::Variant::Standard
+                                                         : variant;
+        using Layer = ribbon::RibbonContainer<layer_variant, width, k, OP::partitioning, Hasher, Vector, Addresser>;
+        using Container = std::conditional_t<variant == ribbon::Variant::Bumped,
+                ribbon::BumpedRibbonContainer<width, k, OP::partitioning, Hasher, Vector, Addresser>, Layer>;
+
+        size_t s;
+        size_t n_partitions;
+        size_t n_retries;
+        Container container;
+        task::TaskQueue<OP::multiThreading> queue;
+        memory::AllocationPolicy policy;
+        std::vector<Container> replicas;
+        // keys bumped by every partition of a bumped ribbon, only used during construct()
+        std::vector<std::vector<T>> bumped;
+        // lookahead of unpartitioned lookups in vectors, 0 disables software prefetching
+        size_t prefetch_distance{0};
+
+        Filter(size_t s, size_t n_partitions, size_t n_threads, size_t n_tasks_per_level,
+               const memory::AllocationPolicy &policy = {}) : s(s), n_partitions(n_partitions), n_retries(0),
+                                                              queue(n_threads, n_tasks_per_level), policy(policy) {
+        }
+
+        forceinline
+        void init(const T *histogram) {
+            n_partitions = std::max(n_partitions, 1ul);
+            container = std::move(Container(s, n_partitions, histogram, policy));
+            replicas.clear();
+            prefetch_distance = simd::prefetch_distance(size());
+        }
+
+        forceinline
+        bool contains(const T &value) const {
+            return contains(value, partition::partition_of<OP::partitioning>(value, n_partitions));
+        }
+
+        forceinline
+        bool contains(const T &value, size_t index) const {
+            if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
+                return local_container().contains(value, 0);
+            } else {
+                return local_container().contains(value, index);
+            }
+        }
+
+        forceinline
+        bool add_all(const T *values, size_t length) {
+            return add_partition(values, length, 0);
+        }
+
+        forceinline
+        bool add_partition(const T *values, size_t length, size_t index) {
+            static_assert(supports_add_partition, "not supported!");
+            replicas.clear();
+
+            if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
+                return _construct(container, values, length, 0);
+            } else {
+                return _construct(container, values, length, index);
+            }
+        }
+
+        /**
+         * bands the keys of a partition (hashed vector-wise, inserted row by row) and solves it, a standard ribbon
+         * retries with a new seed if its equations are inconsistent. first_seed skips seeds, e.g., those of another
+         * layer.
+         */
+        bool _construct(Layer &layer, const T *values, const size_t length, const size_t index,
+                        const size_t first_seed = 0) {
+            for (size_t j = first_seed; j <= first_seed + max_n_retries; j++) {
+                const T seed = (j == 0) ? 0 : hash::single_seed<Vector>(j - 1).elements[0];
+                n_retries += (j > first_seed);
+                layer.set_seed(seed, index);
+
+                Banding banding(layer.n_slots(index));
+                bool success = true;
+                for (size_t i = 0; i < length and success; i += Vector::n_elements) {
+                    const size_t n = std::min(Vector::n_elements, length - i);
+                    M mask = Vector::mask(1);
+                    if constexpr (Vector::avx) {
+                        if (n < Vector::n_elements) {
+                            mask = (1 << n) - 1;
+                        }
+                    }
+
+                    const Vector hash = Hasher::hash(Vector::loadu(values + i, mask) ^ Vector(seed));
+                    const Vector start = layer.start(hash, index);
+                    const Vector coefficients0 = ribbon::ribbon_coefficients<0>(hash);
+                    Vector coefficients1(0);
+                    if constexpr (width == 128) {
+                        coefficients1 = ribbon::ribbon_coefficients<1>(hash);
+                    }
+                    const Vector result = ribbon::ribbon_result<variant, k>(hash);
+
+                    for (size_t lane = 0; lane < n; lane++) {
+                        success &= banding.add(start.elements[lane],
+                                ribbon::ribbon_row<width>(coefficients0, coefficients1, lane),
+                                result.elements[lane]);
+                    }
+                }
+
+                if (success) {
+                    banding.back_substitute(layer.solution + layer.offset(index) * k, seed ^ index);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /**
+         * bands the keys of a partition of a bumped ribbon block by block. A block takes the lowest threshold for
+         * which its remaining keys fit, the keys starting below the threshold are appended to bumped_keys.
+         */
+        void _construct_bumped(const T *values, const size_t length, const size_t index,
+                               std::vector<T> &bumped_keys) {
+            struct Key {
+                ribbon::Row<width> row;
+                T value;
+                T start;
+                T result;
+            };
+
+            Layer &layer = container.layer;
+            layer.set_seed(0, index);
+            const size_t n_blocks = layer.n_slots(index) / 64;
+
+            // the keys are sorted by block, so the keys of a block can be banded again with a higher threshold
+            std::vector<Key> keys(length);
+            std::vector<size_t> block_offsets(n_blocks + 1, 0);
+            for (size_t i = 0; i < length; i += Vector::n_elements) {
+                const size_t n = std::min(Vector::n_elements, length - i);
+                M mask = Vector::mask(1);
+                if constexpr (Vector::avx) {
+                    if (n < Vector::n_elements) {
+                        mask = (1 << n) - 1;
+                    }
+                }
+
+                const Vector hash = Hasher::hash(Vector::loadu(values + i, mask));
+                const Vector start = layer.start(hash, index);
+                const Vector coefficients0 = ribbon::ribbon_coefficients<0>(hash);
+                Vector coefficients1(0);
+                if constexpr (width == 128) {
+                    coefficients1 = ribbon::ribbon_coefficients<1>(hash);
+                }
+                const Vector result = ribbon::ribbon_result<variant, k>(hash);
+
+                for (size_t lane = 0; lane < n; lane++) {
+                    keys[i + lane] = {ribbon::ribbon_row<width>(coefficients0, coefficients1, lane), values[i + lane],
+                                      start.elements[lane], result.elements[lane]};
+                    block_offsets[(start.elements[lane] >> 6) + 1]++;
+                }
+            }
+            for (size_t block = 0; block < n_blocks; block++) {
+                block_offsets[block + 1] += block_offsets[block];
+            }
+            std::vector<Key> sorted(length);
+            std::vector<size_t> write_offsets(block_offsets.begin(), block_offsets.end() - 1);
+            for (const Key &key : keys) {
+                sorted[write_offsets[key.start >> 6]++] = key;
+            }
+
+            Banding banding(layer.n_slots(index));
+            for (size_t block = 0; block < n_blocks; block++) {
+                const Key *begin = sorted.data() + block_offsets[block];
+                const Key *end = sorted.data() + block_offsets[block + 1];
+
+                // the last code bumps the whole block, so a block always fits
+                for (size_t code = 0; code < Container::n_codes; code++) {
+                    const size_t threshold = Container::threshold(code);
+                    bool success = true;
+                    for (const Key *key = begin; key < end and success; key++) {
+                        if ((key->start & 63) >= threshold) {
+                            success = banding.template add<true>(key->start, key->row, key->result);
+                        }
+                    }
+
+                    if (success) {
+                        banding.commit();
+                        container.set_threshold(layer.offset(index) + block, code);
+                        for (const Key *key = begin; key < end; key++) {
+                            if ((key->start & 63) < threshold) {
+                                bumped_keys.push_back(key->value);
+                            }
+                        }
+                        break;
+                    }
+                    banding.rollback();
+                }
+            }
+
+            banding.back_substitute(layer.solution + layer.offset(index) * k, index);
+        }
+
+        /**
+         * allocates the fallback of a bumped ribbon for the bumped keys of all partitions
+         */
+        void _init_fallback() {
+            T *histogram = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)), 0);
+            for (size_t i = 0; i < n_partitions; i++) {
+                histogram[i] = bumped[i].size();
+            }
+            container.init_fallback(n_partitions, histogram);
+            free(histogram);
+        }
+
+        /**
+         * bands the keys of partition i, a bumped ribbon only builds its layer here
+         */
+        bool _construct_partition(const T *values, const size_t length, const size_t index) {
+            if constexpr (variant == ribbon::Variant::Bumped) {
+                _construct_bumped(values, length, index, bumped[index]);
+                return true;
+            } else {
+                return _construct(container, values, length, index);
+            }
+        }
+
+        bool construct(T *values, size_t length) {
+            replicas.clear();
+            BuildPartitionSet partitions(n_partitions);
+            n_partitions = partitions.n_partitions;
+
+            if constexpr (OP::multiThreading == parameter::MultiThreading::Disabled) {
+                bool success = true;
+                partitions.init(values, length);
+                container = std::move(Container(s, n_partitions, partitions.histogram, policy));
+
+                bumped.assign((variant == ribbon::Variant::Bumped) ? n_partitions : 0, std::vector<T>());
+                for (size_t i = 0; i < partitions.n_partitions; i++) {
+                    success &= _construct_partition(partitions.values + partitions.offsets[i], partitions.histogram[i],
+                            i);
+                }
+                if constexpr (variant == ribbon::Variant::Bumped) {
+                    _init_fallback();
+                    for (size_t i = 0; i < partitions.n_partitions; i++) {
+                        success &= _construct(container.fallback, bumped[i].data(), bumped[i].size(), i, 1);
+                    }
+                    bumped.clear();
+                }
+
+                prefetch_distance = simd::prefetch_distance(size());
+                if (success and policy.placement == memory::Placement::Replicated) {
+                    replicate();
+                }
+                return success;
+            } else {
+                partitions.init(values, length, queue);
+                std::atomic<uint8_t> success{1};
+
+                bumped.assign((variant == ribbon::Variant::Bumped) ? n_partitions : 0, std::vector<T>());
+                queue.add_task([&](size_t) {
+                    container = std::move(Container(s, n_partitions, partitions.histogram, policy));
+                });
+                queue.add_barrier();
+                for (size_t i = 0; i < partitions.n_partitions; i++) {
+                    queue.add_task([this, &partitions, &success, i](size_t) {
+                        success &= _construct_partition(partitions.values + partitions.offsets[i],
+                                partitions.histogram[i], i);
+                    });
+                }
+                if constexpr (variant == ribbon::Variant::Bumped) {
+                    queue.add_barrier();
+                    queue.add_task([this](size_t) {
+                        _init_fallback();
+                    });
+                    queue.add_barrier();
+                    for (size_t i = 0; i < partitions.n_partitions; i++) {
+                        queue.add_task([this, &success, i](size_t) {
+                            success &= _construct(container.fallback, bumped[i].data(), bumped[i].size(), i, 1);
+                        });
+                    }
+                }
+                queue.execute_tasks();
+                bumped.clear();
+
+                prefetch_distance = simd::prefetch_distance(size());
+                if (success and policy.placement == memory::Placement::Replicated) {
+                    replicate();
+                }
+                return success;
+            }
+        }
+
+        forceinline
+        M _contains(const Container &local, const Vector &keys, const M mask, const size_t index) const {
+            return local.contains(keys, index, mask);
+        }
+
+        forceinline
+        void _prefetch(const Container &local, const Vector &keys, const M mask, const size_t index) const {
+            local.prefetch(keys, index, mask);
+        }
+
+        void _save(serialize::Writer &writer) const {
+            writer.value(n_retries);
+        }
+
+        void _load(serialize::Reader &reader) {
+            n_retries = reader.value<size_t>();
+        }
+
+        static std::string signature() {
+            return "Ribbon;" + std::to_string(k) + ";" + FP::to_string() + ";" + OP::to_string();
+        }
+
+        size_t size() const {
+            return container.length();
+        }
+
+        size_t avg_size() const {
+            return size() / n_partitions;
+        }
+
+        size_t retries() {
+            return n_retries;
+        }
+
+        std::string to_string() {
+            std::string s = "\n{\n";
+            s += "\t\"k\": " + std::to_string(k) + ",\n";
+            s += "\t\"size\": " + std::to_string(size() * 8) + " bits,\n";
+            s += "\t\"n_partitions\": " + std::to_string(n_partitions) + ",\n";
+            s += "\t\"n_retries\": " + std::to_string(n_retries) + ",\n";
+            s += "\t\"allocation\": " + policy.to_string() + ",\n";
+            s += "\t\"filter_params\": " + FP::to_string() + ",\n";
+            s += "\t\"optimization_params\": " + OP::to_string() + "\n";
+            s += "}\n";
+
+            return s;
+        }
+    };
+
+} // filters
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <parameter/parameter.hpp>
+
+namespace filters::ribbon {
+
+    /**
+     * Bumped (BuRR) bumps the keys of overfull blocks to a standard fallback ribbon instead of retrying
+     */
+    enum class Variant : size_t {
+        Standard, Homogeneous, Bumped
+    };
+
+    /**
+     * width is the number of coefficients of a row (64 or 128)
+     */
+    template<Variant _variant, size_t _width>
+    struct RibbonParameter {
+        static_assert(_width == 64 or _width == 128, "only 64 and 128-bit coefficient rows are supported!");
+
+        static constexpr size_t max_n_retries = 16;
+        static constexpr Variant variant = _variant;
+        static constexpr size_t width = _width;
+
+        static std::string to_string() {
+            std::string s_variant;
+            switch (variant) {
+                case Variant::Standard:
+                    s_variant = "Standard";
+                    break;
+                case Variant::Homogeneous:
+                    s_variant = "Homogeneous";
+                    break;
+                case Variant::Bumped:
+                    s_variant = "Bumped";
+                    break;
+            }
+
+            std::string s = "{";
+            s += "\"variant\": \"" + s_variant + "\", ";
+            s += "\"width\": " + std::to_string(width) + ", ";
+            s += "\"max_n_retries\": " + std::to_string(max_n_retries) + "}";
+            return s;
+        }
+    };
+
+    template<size_t> using Standard64 = RibbonParameter<Variant::Standard, 64>;
+    template<size_t> using Standard128 = RibbonParameter<Variant::Standard, 128>;
+    template<size_t> using Homogeneous64 = RibbonParameter<Variant::Homogeneous, 64>;
+    template<size_t> using Homogeneous128 = RibbonParameter<Variant::Homogeneous, 128>;
+    template<size_t> using Bumped64 = RibbonParameter<Variant::Bumped, 64>;
+    template<size_t> using Bumped128 = RibbonParameter<Variant::Bumped, 128>;
+
+} // filters::ribbon
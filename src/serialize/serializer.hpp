@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <compiler/compiler_hints.hpp>
+#include <math/math.hpp>
+
+namespace filters::serialize {
+
+    // "PFILTERS" in little endian
+    static constexpr uint64_t magic = 0x5352455446494c50;
+    static constexpr uint32_t version = 1;
+
+    // sections are aligned so that mapped arrays can be used with aligned SIMD loads
+    static constexpr size_t alignment = 64;
+
+    /**
+     * File layout: magic, version, description (filter type and parameters), then the state of the filter as a
+     * sequence of scalar values and 64-byte aligned arrays, each array preceded by its length in bytes.
+     */
+    class Writer {
+      private:
+        std::ofstream out;
+        size_t offset{0};
+
+        void write(const void *data, size_t n_bytes) {
+            out.write(reinterpret_cast<const char *>(data), n_bytes);
+            if (not out) {
+                throw std::runtime_error{"could not write filter!"};
+            }
+            offset += n_bytes;
+        }
+
+        void pad() {
+            static constexpr char zeros[alignment] = {0};
+            write(zeros, math::align_number(offset, alignment) - offset);
+        }
+
+      public:
+        Writer(const std::string &path, const std::string &description) : out(path, std::ios::binary |
+                                                                                    std::ios::trunc) {
+            if (not out) {
+                throw std::runtime_error{"could not open " + path + "!"};
+            }
+            value(magic);
+            value(version);
+            string(description);
+        }
+
+        template<typename T>
+        forceinline
+        void value(const T &v) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            write(&v, sizeof(T));
+        }
+
+        forceinline
+        void string(const std::string &s) {
+            value(static_cast<uint64_t>(s.size()));
+            write(s.data(), s.size());
+        }
+
+        forceinline
+        void array(const void *data, size_t n_bytes) {
+            value(static_cast<uint64_t>(n_bytes));
+            pad();
+            write(data, n_bytes);
+        }
+    };
+
+    class MappedFile {
+      private:
+        void *base;
+        size_t n_bytes;
+
+      public:
+        explicit MappedFile(const std::string &path) {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error{"could not open " + path + "!"};
+            }
+
+            struct stat info{};
+            if (fstat(fd, &info) != 0) {
+                close(fd);
+                throw std::runtime_error{"could not stat " + path + "!"};
+            }
+            n_bytes = info.st_size;
+
+            // private mapping: pages are shared with the page cache until the filter is modified
+            base = mmap(nullptr, n_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (base == MAP_FAILED) {
+                throw std::runtime_error{"could not map " + path + "!"};
+            }
+        }
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        ~MappedFile() {
+            munmap(base, n_bytes);
+        }
+
+        forceinline
+        uint8_t *data() const {
+            return reinterpret_cast<uint8_t *>(base);
+        }
+
+        forceinline
+        size_t size() const {
+            return n_bytes;
+        }
+    };
+
+    class Reader {
+      private:
+        std::shared_ptr<MappedFile> file;
+        size_t offset{0};
+
+        uint8_t *read(size_t n_bytes) {
+            if (offset + n_bytes > file->size()) {
+                throw std::runtime_error{"filter file is truncated!"};
+            }
+            uint8_t *position = file->data() + offset;
+            offset += n_bytes;
+            return position;
+        }
+
+      public:
+        Reader(const std::string &path, const std::string &description) : file(std::make_shared<MappedFile>(path)) {
+            if (value<uint64_t>() != magic) {
+                throw std::runtime_error{path + " is not a filter file!"};
+            }
+            if (value<uint32_t>() != version) {
+                throw std::runtime_error{path + " has an unsupported version!"};
+            }
+            if (string() != description) {
+                throw std::runtime_error{path + " contains a different filter type!"};
+            }
+        }
+
+        template<typename T>
+        forceinline
+        T value() {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T v;
+            std::memcpy(&v, read(sizeof(T)), sizeof(T));
+            return v;
+        }
+
+        forceinline
+        std::string string() {
+            const size_t n_bytes = value<uint64_t>();
+            return std::string(reinterpret_cast<const char *>(read(n_bytes)), n_bytes);
+        }
+
+        /**
+         * returns a pointer into the mapped file, no data is copied
+         */
+        template<typename T>
+        forceinline
+        T *array(size_t &n_bytes) {
+            n_bytes = value<uint64_t>();
+            read(math::align_number(offset, alignment) - offset);
+            return reinterpret_cast<T *>(read(n_bytes));
+        }
+
+        /**
+         * returns an aligned copy of a (small) array, it has to be released with free()
+         */
+        template<typename T>
+        forceinline
+        T *copy() {
+            size_t n_bytes;
+            const T *source = array<T>(n_bytes);
+            const size_t n_aligned_bytes = math::align_number(n_bytes, alignment);
+            // an empty array still gets a block, so nullptr always means the allocation failed
+            T *destination = reinterpret_cast<T *>(aligned_alloc(alignment, std::max(n_aligned_bytes, alignment)));
+            if (destination == nullptr) {
+                throw std::runtime_error{"could not allocate " + std::to_string(n_aligned_bytes) + " bytes!"};
+            }
+            std::memcpy(destination, source, n_bytes);
+            std::memset(reinterpret_cast<uint8_t *>(destination) + n_bytes, 0, n_aligned_bytes - n_bytes);
+            return destination;
+        }
+
+        forceinline
+        const std::shared_ptr<MappedFile> &mapping() const {
+            return file;
+        }
+    };
+
+} // filters::serialize
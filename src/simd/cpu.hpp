@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdlib>
+#include <string>
+#include <parameter/parameter.hpp>
+
+namespace filters::simd {
+
+    /**
+     * widest instruction set the translation unit is compiled for
+     */
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__) && defined(__AVX512VL__)
+    static constexpr parameter::SIMD compiled_simd = parameter::SIMD::AVX512;
+#elif defined(__AVX2__)
+    static constexpr parameter::SIMD compiled_simd = parameter::SIMD::AVX2;
+#else
+    static constexpr parameter::SIMD compiled_simd = parameter::SIMD::Scalar;
+#endif
+
+    /**
+     * checks with CPUID whether code compiled for simd runs on this cpu, the AVX2 code also uses BMI1/2 and the
+     * AVX-512 code additionally requires BW, DQ and VL
+     */
+    inline bool cpu_supports(parameter::SIMD simd) {
+        __builtin_cpu_init();
+        switch (simd) {
+            case parameter::SIMD::Scalar:
+                return __builtin_cpu_supports("popcnt");
+            case parameter::SIMD::AVX2:
+                return cpu_supports(parameter::SIMD::Scalar) and __builtin_cpu_supports("avx2") and
+                       __builtin_cpu_supports("bmi") and __builtin_cpu_supports("bmi2");
+            case parameter::SIMD::AVX512:
+                return cpu_supports(parameter::SIMD::AVX2) and __builtin_cpu_supports("avx512f") and
+                       __builtin_cpu_supports("avx512bw") and __builtin_cpu_supports("avx512dq") and
+                       __builtin_cpu_supports("avx512vl");
+        }
+        return false;
+    }
+
+    /**
+     * widest instruction set of this cpu, the environment variable FILTERS_SIMD (scalar, avx2 or avx512) lowers it,
+     * e.g., to run the fallbacks on a machine with AVX-512
+     */
+    inline parameter::SIMD cpu_simd() {
+        static const parameter::SIMD simd = [] {
+            size_t limit = static_cast<size_t>(parameter::SIMD::AVX512);
+            if (const char *env = std::getenv("FILTERS_SIMD")) {
+                const std::string s_env{env};
+                if (s_env == "scalar") {
+                    limit = static_cast<size_t>(parameter::SIMD::Scalar);
+                } else if (s_env == "avx2") {
+                    limit = static_cast<size_t>(parameter::SIMD::AVX2);
+                }
+            }
+
+            for (parameter::SIMD candidate : {parameter::SIMD::AVX512, parameter::SIMD::AVX2}) {
+                if (static_cast<size_t>(candidate) <= limit and cpu_supports(candidate)) {
+                    return candidate;
+                }
+            }
+            return parameter::SIMD::Scalar;
+        }();
+        return simd;
+    }
+
+} // filters::simd
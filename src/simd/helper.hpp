@@ -5,10 +5,7 @@
 #include <compiler/compiler_hints.hpp>
 #include <x86intrin.h>
 #include <math/math.hpp>
-
-#if defined(HAVE_NUMA)
-#include <numa.h>
-#endif
+#include <memory/allocation_policy.hpp>
 
 namespace filters::simd {
 
@@ -90,6 +87,21 @@ namespace filters::simd {
         #endif
     }
 
+    /**
+     * position of the rank-th (starting at 0) set bit of a, a must have more than rank set bits
+     */
+    forceinline
+    static uint64_t select64(uint64_t a, uint64_t rank) {
+        #ifdef __BMI2__
+        return _tzcnt_u64(_pdep_u64(1ull << rank, a));
+        #else
+        for (uint64_t i = 0; i < rank; i++) {
+            a &= a - 1;
+        }
+        return __builtin_ctzll(a);
+        #endif
+    }
+
     template<typename T>
     static T tzcount(T a) {
         if constexpr (sizeof(T) == sizeof(uint64_t)) {
@@ -118,35 +130,32 @@ namespace filters::simd {
 
     template<typename Vector>
     forceinline
-    static typename Vector::T *valloc(size_t n_bytes, uint8_t val, bool numa = false) {
+    static typename Vector::T *valloc(size_t n_bytes, uint8_t val) {
         static constexpr size_t alignment = 64;
-        void *mem;
-        #if defined(HAVE_NUMA)
-        if (numa){
-            mem = numa_alloc_interleaved(n_bytes);
-        } else {
-            mem = aligned_alloc(alignment, n_bytes);
-        }
-        #else
-        mem = aligned_alloc(alignment, n_bytes);
-        #endif
+        void *mem = aligned_alloc(alignment, n_bytes);
         std::memset(mem, val, n_bytes);
         return reinterpret_cast<typename Vector::T *>(mem);
     }
 
+    template<typename Vector>
     forceinline
-    static void vfree(void *mem, size_t n_bytes, bool numa = false) {
-        #if defined(HAVE_NUMA)
-        if (numa){
-            numa_free(mem, n_bytes);
-        } else {
-            free(mem);
-        }
-        #else
-        static_cast<void>(n_bytes);
-        static_cast<void>(numa);
-        free(mem);
-        #endif
+    static typename Vector::T *valloc(size_t n_bytes, uint8_t val, const memory::AllocationPolicy &policy) {
+        void *mem = policy.allocate(n_bytes);
+        std::memset(mem, val, n_bytes);
+        return reinterpret_cast<typename Vector::T *>(mem);
+    }
+
+    template<typename Vector>
+    forceinline
+    static typename Vector::T *vcopy(const typename Vector::T *source, size_t n_bytes) {
+        auto *destination = valloc<Vector>(valign<Vector>(n_bytes), 0);
+        std::memcpy(destination, source, n_bytes);
+        return destination;
+    }
+
+    forceinline
+    static void vfree(void *mem, size_t n_bytes, const memory::AllocationPolicy &policy) {
+        policy.release(mem, n_bytes);
     }
 
     template<size_t n_bits, bool _nbit_aligned, typename Vector>
@@ -269,4 +278,78 @@ namespace filters::simd {
         }
         return counter;
     }
+
+    struct CompressTable {
+        // byte indices of the set bits for every 8-bit mask, used for AVX2 left-packing
+        uint64_t indices[256];
+
+        constexpr CompressTable() : indices() {
+            for (uint64_t mask = 0; mask < 256; mask++) {
+                uint64_t n_set = 0;
+                for (uint64_t bit = 0; bit < 8; bit++) {
+                    if ((mask >> bit) & 0b1) {
+                        indices[mask] |= bit << (8 * n_set++);
+                    }
+                }
+            }
+        }
+    };
+
+    static constexpr CompressTable compress_table{};
+
+    template<typename Vector>
+    forceinline
+    static uint64_t lane_mask(const typename Vector::M mask) {
+        if constexpr (Vector::avx) {
+            return static_cast<uint64_t>(mask) & ((1ull << Vector::n_elements) - 1);
+        } else {
+            return mask;
+        }
+    }
+
+    /**
+     * writes position + i for every set bit i of mask to positions (left-packed, ascending) and returns the
+     * number of written positions, never writes more than the number of set bits
+     */
+    forceinline
+    static size_t compress_positions(uint64_t mask, const uint32_t position, uint32_t *positions) {
+        size_t n_positions = 0;
+        #ifdef __AVX512F__
+        const __m512i iota = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+        for (uint32_t offset = position; mask; mask >>= 16, offset += 16) {
+            const __mmask16 m = mask & 0xFFFF;
+            _mm512_mask_compressstoreu_epi32(positions + n_positions, m,
+                    _mm512_add_epi32(iota, _mm512_set1_epi32(offset)));
+            n_positions += __builtin_popcount(m);
+        }
+        #else
+        #ifdef __AVX2__
+        const __m256i iota = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        for (uint32_t offset = position; mask; mask >>= 8, offset += 8) {
+            const uint32_t m = mask & 0xFF;
+            const int n_set = __builtin_popcount(m);
+            const __m256i permutation = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(compress_table.indices[m]));
+            const __m256i index = _mm256_permutevar8x32_epi32(_mm256_add_epi32(iota, _mm256_set1_epi32(offset)),
+                    permutation);
+            const __m256i store_mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(n_set), iota);
+            _mm256_maskstore_epi32(reinterpret_cast<int *>(positions + n_positions), store_mask, index);
+            n_positions += n_set;
+        }
+        #else
+        for (; mask; mask &= mask - 1) {
+            positions[n_positions++] = position + tzcount64(mask);
+        }
+        #endif
+        #endif
+        return n_positions;
+    }
+
+    /**
+     * sets bit (position + i) in bitmap for every set bit i of mask, the mask must not cross a 64-bit word of the
+     * bitmap and the bitmap has to be zero-initialized
+     */
+    forceinline
+    static void compress_bitmap(const uint64_t mask, const size_t position, uint64_t *bitmap) {
+        bitmap[position / 64] |= mask << (position % 64);
+    }
 }
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <unistd.h>
+#include <compiler/compiler_hints.hpp>
+#include <simd/helper.hpp>
+
+namespace filters::simd {
+
+    // prefetch distance in vectors, enough to cover the memory latency with AVX-512 and 64-bit keys
+    static constexpr size_t default_prefetch_distance = 16;
+
+    /**
+     * issues a software prefetch for the cache line at base + byte_offset of every lane
+     */
+    template<typename Vector>
+    forceinline
+    static void prefetch(const void *base, const Vector &byte_offset, const typename Vector::M mask) {
+        if constexpr (Vector::avx) {
+            for (size_t i = 0; i < Vector::n_elements; i++) {
+                if ((mask >> i) & 0b1) {
+                    _mm_prefetch(reinterpret_cast<const char *>(base) + byte_offset.elements[i], _MM_HINT_T0);
+                }
+            }
+        } else {
+            _mm_prefetch(reinterpret_cast<const char *>(base) + byte_offset.vector, _MM_HINT_T0);
+        }
+    }
+
+    /**
+     * prefetching only pays off if the filter does not fit into the last level cache
+     */
+    forceinline
+    static size_t prefetch_distance(const size_t filter_size) {
+        static const long llc_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+        return (llc_size > 0 and filter_size > static_cast<size_t>(llc_size))
+               ? default_prefetch_distance
+               : 0;
+    }
+
+    /**
+     * Software pipelined lookup: the keys distance vectors ahead are hashed and their cache lines are prefetched
+     * (prefetch(keys, mask)) before the current keys are probed (visit(keys, mask, position)). Thereby, the cache
+     * misses of consecutive lookups overlap instead of being resolved one after another.
+     */
+    template<typename Vector, typename Prefetch, typename Visit>
+    forceinline
+    static void prefetched(const typename Vector::T *values, const size_t length, const size_t distance,
+                           Prefetch &&prefetch, Visit &&visit) {
+        using M = typename Vector::M;
+        const size_t lookahead = distance * Vector::n_elements;
+
+        for (size_t i = 0; i < lookahead and i + Vector::n_elements <= length; i += Vector::n_elements) {
+            prefetch(Vector::loadu(values + i, Vector::mask(1)), Vector::mask(1));
+        }
+
+        size_t i = 0;
+        for (; i + Vector::n_elements <= length; i += Vector::n_elements) {
+            if (lookahead > 0 and i + lookahead + Vector::n_elements <= length) {
+                prefetch(Vector::loadu(values + i + lookahead, Vector::mask(1)), Vector::mask(1));
+            }
+            visit(Vector::loadu(values + i, Vector::mask(1)), Vector::mask(1), i);
+        }
+
+        if constexpr (Vector::avx) {
+            if (i < length) {
+                const M mask = (1 << (length - i)) - 1;
+                visit(Vector::loadu(values + i, mask), mask, i);
+            }
+        }
+    }
+
+} // filters::simd
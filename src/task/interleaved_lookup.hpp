@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <utility>
+#include <vector>
+#include <compiler/compiler_hints.hpp>
+
+namespace filters::task {
+
+    // number of lookups in flight per thread, enough to cover the memory latency with one miss per lookup
+    static constexpr size_t default_n_in_flight = 16;
+
+    /**
+     * Recycles coroutine frames of the calling thread. All lookups of a filter have the same frame size, so a free
+     * list of the last used size avoids a heap allocation per lookup.
+     */
+    class FramePool {
+      private:
+        static constexpr size_t max_frames = 256;
+
+        struct Frames {
+            size_t frame_size{0};
+            std::vector<void *> frames;
+
+            ~Frames() {
+                for (void *frame : frames) {
+                    ::operator delete(frame);
+                }
+            }
+        };
+
+        static Frames &local() {
+            static thread_local Frames frames;
+            return frames;
+        }
+
+      public:
+        forceinline
+        static void *allocate(size_t n_bytes) {
+            Frames &pool = local();
+            if (pool.frame_size == n_bytes and not pool.frames.empty()) {
+                void *frame = pool.frames.back();
+                pool.frames.pop_back();
+                return frame;
+            }
+            return ::operator new(n_bytes);
+        }
+
+        forceinline
+        static void release(void *frame, size_t n_bytes) {
+            Frames &pool = local();
+            if (pool.frame_size != n_bytes and pool.frames.empty()) {
+                pool.frame_size = n_bytes;
+            }
+            if (pool.frame_size == n_bytes and pool.frames.size() < max_frames) {
+                pool.frames.push_back(frame);
+            } else {
+                ::operator delete(frame);
+            }
+        }
+    };
+
+    /**
+     * Coroutine of a single lookup. It runs eagerly until it has issued the prefetches for its key and suspends
+     * (co_await std::suspend_always{}) before touching the filter, the result is returned with co_return.
+     */
+    class Lookup {
+      public:
+        struct promise_type {
+            bool result{false};
+
+            Lookup get_return_object() {
+                return Lookup(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_never initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept {
+                return {};
+            }
+
+            void return_value(bool found) {
+                result = found;
+            }
+
+            void unhandled_exception() {
+                std::terminate();
+            }
+
+            static void *operator new(size_t n_bytes) {
+                return FramePool::allocate(n_bytes);
+            }
+
+            static void operator delete(void *frame, size_t n_bytes) {
+                FramePool::release(frame, n_bytes);
+            }
+        };
+
+      private:
+        std::coroutine_handle<promise_type> handle;
+
+      public:
+        Lookup() = default;
+
+        explicit Lookup(std::coroutine_handle<promise_type> handle) : handle(handle) {
+        }
+
+        Lookup(Lookup &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {
+        }
+
+        Lookup &operator=(Lookup &&other) noexcept {
+            if (this != &other) {
+                if (handle) {
+                    handle.destroy();
+                }
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        Lookup(const Lookup &) = delete;
+
+        Lookup &operator=(const Lookup &) = delete;
+
+        ~Lookup() {
+            if (handle) {
+                handle.destroy();
+            }
+        }
+
+        forceinline
+        bool valid() const {
+            return static_cast<bool>(handle);
+        }
+
+        forceinline
+        bool done() const {
+            return handle.done();
+        }
+
+        forceinline
+        void resume() const {
+            handle.resume();
+        }
+
+        forceinline
+        bool result() const {
+            return handle.promise().result;
+        }
+    };
+
+    /**
+     * Interleaves the lookups of [0, length) in the style of AMAC: up to n_in_flight lookups are kept in a ring and
+     * resumed round-robin, so the cache miss of one lookup is overlapped with the work of the others. A finished
+     * lookup is replaced by the next one in the same slot, sink(position, found) is called in completion order.
+     */
+    template<typename MakeLookup, typename Sink>
+    static void interleave(const size_t length, const size_t n_in_flight, MakeLookup &&make_lookup, Sink &&sink) {
+        const size_t n_slots = std::max(std::min(n_in_flight, length), static_cast<size_t>(1));
+        std::vector<Lookup> slots(n_slots);
+        std::vector<size_t> positions(n_slots);
+
+        size_t next = 0;
+        size_t n_active = 0;
+        for (; next < n_slots and next < length; next++, n_active++) {
+            slots[next] = make_lookup(next);
+            positions[next] = next;
+        }
+
+        for (size_t i = 0; n_active > 0; i = (i + 1 == n_slots) ? 0 : i + 1) {
+            Lookup &lookup = slots[i];
+            if (not lookup.valid()) {
+                continue;
+            }
+
+            if (not lookup.done()) {
+                lookup.resume();
+            }
+            if (lookup.done()) {
+                sink(positions[i], lookup.result());
+                if (next < length) {
+                    lookup = make_lookup(next);
+                    positions[i] = next++;
+                } else {
+                    lookup = Lookup();
+                    n_active--;
+                }
+            }
+        }
+    }
+
+} // filters::task
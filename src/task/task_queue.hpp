@@ -2,10 +2,11 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <thread>
 #include <vector>
 #include <parameter/parameter.hpp>
-#include "barrier.hpp"
+#include "thread_pool.hpp"
 
 namespace filters::task {
 
@@ -43,47 +44,112 @@ namespace filters::task {
         }
     };
 
+    /**
+     * Tasks are grouped into phases separated by add_barrier(). The tasks of a phase are split into one range per
+     * thread, threads take tasks from the front of their own range and steal from the back of the others. The thread
+     * that completes the last task of a phase publishes the next one, so no thread blocks inside a barrier.
+     */
     template<>
     class TaskQueue<parameter::MultiThreading::Enabled> {
       private:
+        struct alignas(64) Range {
+            // [begin, end) of task indices, packed into one word so that owner and thieves can use a single CAS
+            std::atomic<uint64_t> range{0};
+        };
+
         std::vector<std::function<void(size_t)>> tasks;
-        std::atomic<size_t> pos{0};
+        std::vector<size_t> phases{0};
+        std::unique_ptr<Range[]> ranges;
+        std::atomic<size_t> phase{0};
+        std::atomic<size_t> remaining{0};
         size_t n_threads, n_tasks_per_level;
-        Barrier barrier;
+        ThreadPool &pool;
         std::vector<std::thread> threads;
 
         forceinline
-        static void set_cpu_affinity(int cpu_id) {
-            cpu_set_t mask;
-            CPU_ZERO(&mask);
-            CPU_SET(cpu_id % std::thread::hardware_concurrency(), &mask);
-            pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+        static uint64_t pack(uint64_t begin, uint64_t end) {
+            return (begin << 32) | end;
+        }
+
+        forceinline
+        bool pop(size_t thread_id, size_t &task) {
+            uint64_t range = ranges[thread_id].range.load();
+            while ((range >> 32) < (range & 0xFFFFFFFF)) {
+                if (ranges[thread_id].range.compare_exchange_weak(range, range + (1ull << 32))) {
+                    task = range >> 32;
+                    return true;
+                }
+            }
+            return false;
         }
 
         forceinline
-        bool execute_next_task(size_t thread_id) {
-            size_t p = pos++;
-            if (p >= tasks.size()) {
-                return false;
-            } else {
-                tasks.at(p)(thread_id);
-                return true;
+        bool steal(size_t thread_id, size_t &task) {
+            for (size_t i = 1; i < n_threads; i++) {
+                Range &victim = ranges[(thread_id + i) % n_threads];
+                uint64_t range = victim.range.load();
+                while ((range >> 32) < (range & 0xFFFFFFFF)) {
+                    if (victim.range.compare_exchange_weak(range, range - 1)) {
+                        task = (range & 0xFFFFFFFF) - 1;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        forceinline
+        void publish(size_t next_phase) {
+            // skip empty phases
+            while (next_phase + 1 < phases.size() and phases[next_phase] == phases[next_phase + 1]) {
+                next_phase++;
+            }
+
+            // phase and remaining have to be visible before the first task of the phase can be taken
+            phase = next_phase;
+            if (next_phase + 1 < phases.size()) {
+                const size_t begin = phases[next_phase];
+                const size_t length = phases[next_phase + 1] - begin;
+
+                remaining = length;
+                for (size_t i = 0; i < n_threads; i++) {
+                    ranges[i].range = pack(begin + length * i / n_threads, begin + length * (i + 1) / n_threads);
+                }
+            }
+        }
+
+        forceinline
+        void work(size_t thread_id) {
+            const size_t n_phases = phases.size() - 1;
+            while (true) {
+                size_t task;
+                if (pop(thread_id, task) or steal(thread_id, task)) {
+                    tasks[task](thread_id);
+                    if (--remaining == 0) {
+                        publish(phase + 1);
+                    }
+                } else if (phase >= n_phases) {
+                    return;
+                } else {
+                    std::this_thread::yield();
+                }
             }
         }
 
         forceinline
         void reset() {
             tasks.clear();
-            barrier.reset();
+            phases.assign(1, 0);
             threads.clear();
-            pos = 0;
+            phase = 0;
+            remaining = 0;
         }
 
       public:
 
-        TaskQueue(size_t n_threads, size_t n_tasks_per_level) : n_threads(n_threads),
-                                                                n_tasks_per_level(n_tasks_per_level),
-                                                                barrier(n_threads) {
+        TaskQueue(size_t n_threads, size_t n_tasks_per_level, ThreadPool &pool = ThreadPool::global())
+                : ranges(new Range[n_threads]), n_threads(n_threads), n_tasks_per_level(n_tasks_per_level),
+                  pool(pool) {
         }
 
         forceinline
@@ -101,26 +167,35 @@ namespace filters::task {
             tasks.push_back(f);
         }
 
+        /**
+         * all tasks added afterwards start once every task added before has completed
+         */
         forceinline
         void add_barrier() {
-            for (size_t i = 0; i < n_threads; i++) {
-                tasks.emplace_back([&](size_t) {
-                    barrier.wait();
-                });
-            }
+            phases.push_back(tasks.size());
         }
 
         forceinline
         void execute_tasks() {
-            for (size_t i = 0; i < n_threads; i++) {
-                threads.emplace_back([i, this] {
-                    set_cpu_affinity(i);
-                    while (this->execute_next_task(i));
-                });
-            }
-
-            for (auto &thread : threads) {
-                thread.join();
+            phases.push_back(tasks.size());
+            publish(0);
+
+            const std::function<void(size_t)> worker = [this](size_t thread_id) {
+                this->work(thread_id);
+            };
+
+            // the pool is busy with another queue (or we are nested in one of its tasks), fall back to own threads
+            if (not pool.try_execute(n_threads, worker)) {
+                for (size_t i = 0; i < n_threads; i++) {
+                    threads.emplace_back([i, &worker] {
+                        set_cpu_affinity(i);
+                        worker(i);
+                    });
+                }
+
+                for (auto &thread : threads) {
+                    thread.join();
+                }
             }
 
             reset();
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include <compiler/compiler_hints.hpp>
+
+namespace filters::task {
+
+    forceinline
+    static void set_cpu_affinity(size_t cpu_id) {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(cpu_id % std::thread::hardware_concurrency(), &mask);
+        pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+    }
+
+    /**
+     * Long-lived pool of pinned workers, worker i is pinned to cpu i and parked between jobs. A single pool can be
+     * shared by any number of TaskQueues, but only runs one job at a time.
+     */
+    class ThreadPool {
+      private:
+        std::mutex latch;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::mutex execute_latch;
+
+        std::vector<std::thread> workers;
+        const std::function<void(size_t)> *job{nullptr};
+        size_t n_active{0};
+        size_t n_running{0};
+        size_t generation{0};
+        bool stop{false};
+
+        static bool &is_worker() {
+            static thread_local bool worker = false;
+            return worker;
+        }
+
+        void work(size_t thread_id, size_t last_generation) {
+            is_worker() = true;
+            set_cpu_affinity(thread_id);
+
+            std::unique_lock<std::mutex> lock(latch);
+            while (true) {
+                wake.wait(lock, [this, last_generation] {
+                    return stop or generation != last_generation;
+                });
+                if (stop) {
+                    return;
+                }
+                last_generation = generation;
+                if (thread_id >= n_active) {
+                    continue;
+                }
+
+                const auto *f = job;
+                lock.unlock();
+                (*f)(thread_id);
+                lock.lock();
+
+                if (--n_running == 0) {
+                    done.notify_one();
+                }
+            }
+        }
+
+      public:
+
+        ThreadPool() = default;
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(latch);
+                stop = true;
+            }
+            wake.notify_all();
+            for (auto &worker : workers) {
+                worker.join();
+            }
+        }
+
+        static ThreadPool &global() {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        forceinline
+        size_t get_n_workers() {
+            std::lock_guard<std::mutex> lock(latch);
+            return workers.size();
+        }
+
+        /**
+         * runs f(thread_id) on the workers 0..n_threads-1 concurrently and waits for all of them, the pool grows on
+         * demand. Returns false without running anything if the pool is busy or called from one of its workers.
+         */
+        bool try_execute(size_t n_threads, const std::function<void(size_t)> &f) {
+            if (is_worker()) {
+                return false;
+            }
+            std::unique_lock<std::mutex> guard(execute_latch, std::try_to_lock);
+            if (not guard.owns_lock()) {
+                return false;
+            }
+
+            std::unique_lock<std::mutex> lock(latch);
+            for (size_t i = workers.size(); i < n_threads; i++) {
+                workers.emplace_back([this, i, g = generation] {
+                    work(i, g);
+                });
+            }
+
+            job = &f;
+            n_active = n_threads;
+            n_running = n_threads;
+            generation++;
+            wake.notify_all();
+
+            done.wait(lock, [this] {
+                return n_running == 0;
+            });
+            job = nullptr;
+            return true;
+        }
+    };
+
+}  // namespace filters::task
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <x86intrin.h>
+#include <compiler/compiler_hints.hpp>
+#include <parameter/parameter.hpp>
+#include <simd/helper.hpp>
+
+namespace filters::vqf {
+
+    /**
+     * mini filter of a cache line: the fingerprints of all buckets are stored sorted by bucket and the metadata bits
+     * encode the bucket sizes in unary (a 0 per fingerprint, a 1 terminates a bucket). The fingerprints of bucket b
+     * are the slots [select(b - 1) - (b - 1), select(b) - b).
+     */
+    template<size_t k, parameter::SIMD simd>
+    struct alignas(64) VQFBlock {
+
+        static_assert(k == 8 or k == 16, "vector quotient filters support 8 and 16-bit fingerprints only!");
+
+        using Fingerprint = std::conditional_t<k == 8, uint8_t, uint16_t>;
+
+        static constexpr size_t n_slots = (k == 8) ? 48 : 28;
+        static constexpr size_t n_buckets = (k == 8) ? 80 : 36;
+        static constexpr size_t n_words = (n_slots + n_buckets) / 64;
+        static_assert(n_slots * k % 64 == 0);
+
+        uint64_t metadata[n_words];
+        Fingerprint fingerprints[n_slots];
+
+        forceinline
+        void init() {
+            for (size_t i = 0; i < n_words; i++) {
+                metadata[i] = (n_buckets >= 64 * (i + 1))
+                              ? ~0ull
+                              : (n_buckets > 64 * i) ? (1ull << (n_buckets - 64 * i)) - 1 : 0;
+            }
+            std::memset(fingerprints, 0, sizeof(fingerprints));
+        }
+
+        forceinline
+        size_t select(size_t rank) const {
+            for (size_t i = 0; i < n_words - 1; i++) {
+                const size_t n_ones = __builtin_popcountll(metadata[i]);
+                if (rank < n_ones) {
+                    return 64 * i + simd::select64(metadata[i], rank);
+                }
+                rank -= n_ones;
+            }
+            return 64 * (n_words - 1) + simd::select64(metadata[n_words - 1], rank);
+        }
+
+        forceinline
+        size_t n_fingerprints() const {
+            return select(n_buckets - 1) - (n_buckets - 1);
+        }
+
+        /**
+         * bit i is set if slot i holds fingerprint, the 64-byte compare covers the metadata as well and is shifted out
+         */
+        forceinline
+        uint64_t match(const Fingerprint fingerprint) const {
+            if constexpr (simd == parameter::SIMD::AVX512) {
+                #if defined(__AVX512BW__)
+                const __m512i block = _mm512_load_si512(this);
+                if constexpr (k == 8) {
+                    return _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8(fingerprint)) >> (n_words * 8);
+                } else {
+                    return _mm512_cmpeq_epi16_mask(block, _mm512_set1_epi16(fingerprint)) >> (n_words * 4);
+                }
+                #endif
+            }
+            if constexpr (simd != parameter::SIMD::Scalar) {
+                #if defined(__AVX2__)
+                const __m256i low = _mm256_load_si256(reinterpret_cast<const __m256i *>(this));
+                const __m256i high = _mm256_load_si256(reinterpret_cast<const __m256i *>(this) + 1);
+                if constexpr (k == 8) {
+                    const __m256i f = _mm256_set1_epi8(fingerprint);
+                    const uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, f))) |
+                                          (static_cast<uint64_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, f)))
+                                                  << 32);
+                    return mask >> (n_words * 8);
+                } else {
+                    // movemask yields two bits per 16-bit fingerprint
+                    const __m256i f = _mm256_set1_epi16(fingerprint);
+                    const uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(low, f))) |
+                                          (static_cast<uint64_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(high, f)))
+                                                  << 32);
+                    return simd::pext64(mask, 0x5555555555555555ull) >> (n_words * 4);
+                }
+                #endif
+            }
+
+            // compares 64 bits of fingerprints at once, the high bit of a fingerprint stays clear iff it is equal
+            constexpr size_t n_per_word = 64 / k;
+            constexpr uint64_t low = (k == 8) ? 0x7f7f7f7f7f7f7f7full : 0x7fff7fff7fff7fffull;
+            const uint64_t broadcast = ((k == 8) ? 0x0101010101010101ull : 0x0001000100010001ull) * fingerprint;
+
+            uint64_t mask = 0;
+            for (size_t i = 0; i < n_slots / n_per_word; i++) {
+                uint64_t word;
+                std::memcpy(&word, fingerprints + i * n_per_word, sizeof(word));
+                const uint64_t x = word ^ broadcast;
+                const uint64_t equal = ~(((x & low) + low) | x | low);
+                mask |= simd::pext64(equal, ~low) << (i * n_per_word);
+            }
+            return mask;
+        }
+
+        /**
+         * bit i is set if slot i belongs to bucket
+         */
+        forceinline
+        uint64_t slots(const size_t bucket) const {
+            const size_t begin = (bucket == 0) ? 0 : select(bucket - 1) - (bucket - 1);
+            const size_t end = select(bucket) - bucket;
+            return ((1ull << end) - 1) & ~((1ull << begin) - 1);
+        }
+
+        forceinline
+        bool contains(const size_t bucket, const Fingerprint fingerprint) const {
+            const uint64_t matches = match(fingerprint);
+            return matches and (matches & slots(bucket)) != 0;
+        }
+
+        /**
+         * inserts fingerprint at the end of its bucket, fails if the block is full
+         */
+        forceinline
+        bool insert(const size_t bucket, const Fingerprint fingerprint) {
+            const size_t n = n_fingerprints();
+            if (n == n_slots) {
+                return false;
+            }
+
+            const size_t position = select(bucket);
+            const size_t slot = position - bucket;
+            std::memmove(fingerprints + slot + 1, fingerprints + slot, (n - slot) * sizeof(Fingerprint));
+            fingerprints[slot] = fingerprint;
+
+            // shift the metadata bits from position on by one, the last bit is always 0 as the block was not full
+            const size_t word = position / 64;
+            for (size_t i = n_words - 1; i > word; i--) {
+                metadata[i] = (metadata[i] << 1) | (metadata[i - 1] >> 63);
+            }
+            const uint64_t low = (1ull << (position % 64)) - 1;
+            metadata[word] = (metadata[word] & low) | ((metadata[word] & ~low) << 1);
+            return true;
+        }
+    };
+
+    static_assert(sizeof(VQFBlock<8, parameter::SIMD::Scalar>) == 64);
+    static_assert(sizeof(VQFBlock<16, parameter::SIMD::Scalar>) == 64);
+
+} // filters::vqf
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <simd/helper.hpp>
+#include <simd/prefetch.hpp>
+#include <serialize/serializer.hpp>
+#include <vqf/vqf_parameter.hpp>
+#include "vqf_block.hpp"
+
+namespace filters::vqf {
+
+    /**
+     * blocks of all partitions, a key may be stored in two blocks of its partition (one per hash). The bucket and
+     * fingerprint of a key are the same in both blocks.
+     */
+    template<Variant variant, size_t shortcut_fill, size_t k, parameter::Partitioning partitioning,
+            parameter::SIMD simd, typename Hasher, typename Vector, typename Addresser>
+    struct VQFContainer {
+
+        using T = typename Vector::T;
+        using M = typename Vector::M;
+        using O = std::conditional_t<partitioning != parameter::Partitioning::Disabled, T *, T>;
+        using Block = VQFBlock<k, simd>;
+        using Fingerprint = typename Block::Fingerprint;
+
+        Addresser addresser;
+        Block *blocks;
+        size_t n_bytes;
+        // first block of every partition
+        O offsets;
+        memory::AllocationPolicy policy;
+        // set if the blocks are used in place from a mapped file
+        std::shared_ptr<serialize::MappedFile> mapping;
+
+        struct Tag {
+            Vector block0;
+            Vector block1;
+            Vector bucket;
+            Vector fingerprint;
+        };
+
+        VQFContainer() : blocks(nullptr), n_bytes(0), offsets(0) {
+        };
+
+        VQFContainer(VQFContainer &&other) noexcept: addresser(std::move(other.addresser)), blocks(other.blocks),
+                                                     n_bytes(other.n_bytes), offsets(other.offsets),
+                                                     policy(other.policy), mapping(std::move(other.mapping)) {
+            other.blocks = nullptr;
+            other.offsets = 0;
+        }
+
+        VQFContainer &operator=(VQFContainer &&other) noexcept {
+            if (this != &other) {
+                if (blocks and n_bytes > 0 and not mapping) {
+                    simd::vfree(blocks, n_bytes, policy);
+                }
+                if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                    if (offsets) {
+                        free(offsets);
+                    }
+                }
+
+                addresser = std::move(other.addresser);
+                blocks = other.blocks;
+                n_bytes = other.n_bytes;
+                offsets = other.offsets;
+                policy = other.policy;
+                mapping = std::move(other.mapping);
+
+                other.blocks = nullptr;
+                other.offsets = 0;
+            }
+
+            return *this;
+        }
+
+        VQFContainer(size_t s, size_t n_partitions, const T *histogram, const memory::AllocationPolicy &policy = {})
+                : policy(policy) {
+            T *h = new T[n_partitions];
+            for (size_t i = 0; i < n_partitions; i++) {
+                h[i] = std::max((histogram[i] * s / 100 + Block::n_slots - 1) / Block::n_slots, 1ul);
+            }
+            addresser = std::move(Addresser(h, n_partitions));
+            delete[](h);
+
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                offsets = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)), 0);
+            } else {
+                offsets = 0;
+            }
+
+            T last_offset = 0;
+            for (size_t i = 0; i < n_partitions; i++) {
+                if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                    offsets[i] = last_offset;
+                }
+                last_offset += addresser.get_size(i);
+            }
+
+            n_bytes = last_offset * sizeof(Block);
+            blocks = reinterpret_cast<Block *>(simd::valloc<Vector>(n_bytes, 0, policy));
+            for (size_t i = 0; i < last_offset; i++) {
+                blocks[i].init();
+            }
+        }
+
+        /**
+         * copies other into memory allocated with policy, e.g., a replica on another node
+         */
+        VQFContainer(const VQFContainer &other, const size_t n_partitions, const memory::AllocationPolicy &policy)
+                : addresser(other.addresser.copy(n_partitions)), n_bytes(other.n_bytes), policy(policy) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                offsets = simd::vcopy<Vector>(other.offsets, n_partitions * sizeof(T));
+            } else {
+                offsets = other.offsets;
+            }
+            blocks = reinterpret_cast<Block *>(simd::valloc<Vector>(n_bytes, 0, policy));
+            std::memcpy(blocks, other.blocks, n_bytes);
+        }
+
+        ~VQFContainer() {
+            if (blocks and n_bytes > 0 and not mapping) {
+                simd::vfree(blocks, n_bytes, policy);
+            }
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                if (offsets) {
+                    free(offsets);
+                }
+            }
+        }
+
+        void save(serialize::Writer &writer, const size_t n_partitions) const {
+            addresser.save(writer, n_partitions);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                writer.array(offsets, n_partitions * sizeof(T));
+            } else {
+                writer.value(offsets);
+            }
+            writer.array(blocks, n_bytes);
+        }
+
+        void load(serialize::Reader &reader) {
+            VQFContainer loaded;
+            loaded.addresser.load(reader);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                loaded.offsets = reader.copy<T>();
+            } else {
+                loaded.offsets = reader.value<T>();
+            }
+            loaded.blocks = reader.array<Block>(loaded.n_bytes);
+            loaded.mapping = reader.mapping();
+            *this = std::move(loaded);
+        }
+
+        forceinline
+        size_t length() const {
+            return n_bytes;
+        }
+
+        forceinline
+        size_t offset(const size_t index) const {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                return offsets[index];
+            } else {
+                return offsets;
+            }
+        }
+
+        /**
+         * blocks, bucket and fingerprint of all lanes, the fingerprint is taken from a third hash as the addresses
+         * consume the high bits of 32-bit hashes
+         */
+        forceinline
+        Tag tag(const Vector &values, const size_t index) const {
+            const Vector offset(this->offset(index));
+            const Vector hash0 = Hasher::hash(values);
+            const Vector hash1 = Hasher::template rehash<1>(hash0, values);
+            const Vector hash2 = Hasher::template rehash<2>(hash1, values);
+
+            Tag tag;
+            tag.block0 = offset + addresser.compute_address_vertical(index, simd::extractAddressBits(hash0));
+            tag.block1 = offset + addresser.compute_address_vertical(index, simd::extractAddressBits(hash1));
+            tag.bucket = ((hash2 & Vector(0xffff)) * Vector(Block::n_buckets)) >> 16;
+            tag.fingerprint = (hash2 >> 16) & Vector((1ull << k) - 1);
+            return tag;
+        }
+
+        /**
+         * looks up all lanes in two passes: first the fingerprint of every lane is compared with all slots of both
+         * blocks (Block::match), then the bucket is located in the metadata (select) only for the lanes that matched
+         * any slot. Most lanes of negative lookups end after the first pass.
+         */
+        forceinline
+        M contains(const Vector &values, const size_t index, const M mask) const {
+            const Tag tag = this->tag(values, index);
+
+            uint64_t matches0[Vector::n_elements];
+            uint64_t matches1[Vector::n_elements];
+            M candidates = 0;
+            for (size_t lane = 0; lane < Vector::n_elements; lane++) {
+                if ((mask >> lane) & 1) {
+                    const Fingerprint fingerprint = tag.fingerprint.elements[lane];
+                    matches0[lane] = blocks[tag.block0.elements[lane]].match(fingerprint);
+                    matches1[lane] = blocks[tag.block1.elements[lane]].match(fingerprint);
+                    candidates |= static_cast<M>((matches0[lane] | matches1[lane]) != 0) << lane;
+                }
+            }
+
+            M found = 0;
+            for (size_t lane = 0; lane < Vector::n_elements; lane++) {
+                if ((candidates >> lane) & 1) {
+                    const size_t bucket = tag.bucket.elements[lane];
+                    const bool hit = (matches0[lane] and
+                                      (matches0[lane] & blocks[tag.block0.elements[lane]].slots(bucket)) != 0) or
+                                     (matches1[lane] and
+                                      (matches1[lane] & blocks[tag.block1.elements[lane]].slots(bucket)) != 0);
+                    found |= static_cast<M>(hit) << lane;
+                }
+            }
+            return found;
+        }
+
+        /**
+         * inserts all lanes one after another, so the blocks are filled like by scalar inserts
+         */
+        forceinline
+        M insert(const Vector &values, const size_t index, const M mask) {
+            const Tag tag = this->tag(values, index);
+
+            M inserted = 0;
+            for (size_t lane = 0; lane < Vector::n_elements; lane++) {
+                if ((mask >> lane) & 1) {
+                    Block &block0 = blocks[tag.block0.elements[lane]];
+                    Block &block1 = blocks[tag.block1.elements[lane]];
+                    const size_t n0 = block0.n_fingerprints();
+
+                    Block *block = &block0;
+                    if (variant == Variant::Standard or n0 * 100 >= Block::n_slots * shortcut_fill) {
+                        if (block1.n_fingerprints() < n0) {
+                            block = &block1;
+                        }
+                    }
+                    const bool success = block->insert(tag.bucket.elements[lane], tag.fingerprint.elements[lane]);
+                    inserted |= static_cast<M>(success) << lane;
+                }
+            }
+            return inserted;
+        }
+
+        /**
+         * prefetches both blocks of every lane
+         */
+        forceinline
+        void prefetch(const Vector &values, const size_t index, const M mask) const {
+            const Tag tag = this->tag(values, index);
+            simd::prefetch(blocks, tag.block0 * Vector(sizeof(Block)), mask);
+            simd::prefetch(blocks, tag.block1 * Vector(sizeof(Block)), mask);
+        }
+
+        size_t count(const T *begin, const T *end, const size_t index) const {
+            size_t counter = 0;
+
+            for (; begin + Vector::n_elements <= end; begin += Vector::n_elements) {
+                const Vector values = Vector::load(begin);
+                counter += Vector::popcount_mask(contains(values, index, Vector::mask(1)));
+            }
+
+            if constexpr (Vector::avx) {
+                if (begin < end) {
+                    const M mask = (1 << (end - begin)) - 1;
+                    const Vector values = Vector::load(begin);
+                    counter += Vector::popcount_mask(contains(values, index, mask));
+                }
+            }
+
+            return counter;
+        }
+    };
+
+} // filters::vqf
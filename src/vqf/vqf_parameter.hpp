@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <parameter/parameter.hpp>
+
+namespace filters::vqf {
+
+    enum class Variant : size_t {
+        Standard, Shortcut
+    };
+
+    /**
+     * Standard inserts into the emptier of both blocks of a key, Shortcut only looks at the second block if the first
+     * one is at least shortcut_fill percent full
+     */
+    template<Variant _variant>
+    struct VQFParameter {
+        static constexpr Variant variant = _variant;
+        static constexpr size_t shortcut_fill = 75;
+
+        static std::string to_string() {
+            std::string s_variant;
+            switch (variant) {
+                case Variant::Standard:
+                    s_variant = "Standard";
+                    break;
+                case Variant::Shortcut:
+                    s_variant = "Shortcut";
+                    break;
+            }
+
+            std::string s = "{";
+            s += "\"variant\": \"" + s_variant + "\", ";
+            s += "\"shortcut_fill\": " + std::to_string(shortcut_fill) + "}";
+            return s;
+        }
+    };
+
+    template<size_t> using Standard = VQFParameter<Variant::Standard>;
+    template<size_t> using Shortcut = VQFParameter<Variant::Shortcut>;
+
+} // filters::vqf
@@ -1,58 +1,90 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <cstddef>
 #include <bloom/bloom_parameter.hpp>
 #include <array>
+#include <vector>
 #include <partition/partition_set.hpp>
+#include <simd/prefetch.hpp>
+#include <serialize/serializer.hpp>
 #include "xor_stack.hpp"
 
 namespace filters::nxor {
 
     template<Variant variant, size_t k, parameter::Partitioning partitioning, typename Hasher, typename Vector,
-            typename Addresser>
+            typename Addresser, bool stash = false>
     struct XorContainer {
 
         using Stack = XorStack<variant, Hasher, Vector, Addresser>;
         using T = typename Vector::T;
         using M = typename Vector::M;
         using Fingerprint = std::conditional_t<k <= 8, uint8_t, std::conditional_t<k <= 16, uint16_t, uint32_t>>;
-        using O = std::conditional_t<partitioning == parameter::Partitioning::Enabled, T *, T>;
+        using O = std::conditional_t<partitioning != parameter::Partitioning::Disabled, T *, T>;
+        static constexpr size_t arity = xor_arity<variant>();
 
         Addresser addresser;
         uint8_t *fingerprints;
         size_t n_bytes;
         std::array<O, 3> offsets{0};
         O seeds;
+        // number of segments a key can start in, only stored for binary fuse variants
+        O segment_counts;
         Vector base;
-
-        XorContainer() : fingerprints(nullptr), n_bytes(0), seeds(0) {
+        memory::AllocationPolicy policy;
+        // set if the fingerprints are used in place from a mapped file
+        std::shared_ptr<serialize::MappedFile> mapping;
+        // keys that could not be peeled, only used with stash: sorted per partition, the keys of partition i are
+        // stashed_keys[stash_offsets[i], stash_offsets[i + 1])
+        std::vector<T> stashed_keys;
+        std::vector<size_t> stash_offsets;
+        // blocked bloom filter over the stashed keys (two bits in one word), checked before the binary search
+        std::vector<T> stash_filter;
+        size_t stash_shift{0};
+
+        XorContainer() : fingerprints(nullptr), n_bytes(0), seeds(0), segment_counts(0) {
         };
 
         XorContainer(XorContainer &&other) noexcept: addresser(std::move(other.addresser)),
                                                      fingerprints(other.fingerprints), n_bytes(other.n_bytes),
-                                                     seeds(other.seeds), base(other.base) {
+                                                     seeds(other.seeds), segment_counts(other.segment_counts),
+                                                     base(other.base), policy(other.policy),
+                                                     mapping(std::move(other.mapping)),
+                                                     stashed_keys(std::move(other.stashed_keys)),
+                                                     stash_offsets(std::move(other.stash_offsets)),
+                                                     stash_filter(std::move(other.stash_filter)),
+                                                     stash_shift(other.stash_shift) {
             other.fingerprints = nullptr;
+            other.seeds = 0;
+            other.segment_counts = 0;
             for (size_t i = 0; i < offsets.size(); i++) {
-                this->offsets[i] = other.sets[i];
+                this->offsets[i] = other.offsets[i];
                 other.offsets[i] = 0;
             }
         }
 
         XorContainer &operator=(XorContainer &&other) noexcept {
             if (this != &other) {
+                if (this->fingerprints and n_bytes > 0 and not mapping) {
+                    simd::vfree(this->fingerprints, n_bytes, policy);
+                }
+
                 addresser = std::move(other.addresser);
                 n_bytes = other.n_bytes;
                 base = other.base;
+                policy = other.policy;
+                mapping = std::move(other.mapping);
+                stashed_keys = std::move(other.stashed_keys);
+                stash_offsets = std::move(other.stash_offsets);
+                stash_filter = std::move(other.stash_filter);
+                stash_shift = other.stash_shift;
 
-                if (this->fingerprints) {
-                    simd::vfree(this->fingerprints, n_bytes, true);
-                }
                 this->fingerprints = other.fingerprints;
                 other.fingerprints = nullptr;
 
                 for (size_t i = 0; i < offsets.size(); i++) {
-                    if constexpr (partitioning == parameter::Partitioning::Enabled) {
+                    if constexpr (partitioning != parameter::Partitioning::Disabled) {
                         if (this->offsets[i]) {
                             free(this->offsets[i]);
                         }
@@ -62,7 +94,7 @@ namespace filters::nxor {
                     other.offsets[i] = 0;
                 }
 
-                if constexpr (partitioning == parameter::Partitioning::Enabled) {
+                if constexpr (partitioning != parameter::Partitioning::Disabled) {
                     if (this->seeds) {
                         free(this->seeds);
                     }
@@ -70,43 +102,55 @@ namespace filters::nxor {
 
                 this->seeds = other.seeds;
                 other.seeds = 0;
+
+                if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                    if (this->segment_counts) {
+                        free(this->segment_counts);
+                    }
+                }
+
+                this->segment_counts = other.segment_counts;
+                other.segment_counts = 0;
             }
 
             return *this;
         }
 
-        XorContainer(size_t s, size_t n_partitions, const T *histogram) {
+        XorContainer(size_t s, size_t n_partitions, const T *histogram, const memory::AllocationPolicy &policy = {})
+                : policy(policy) {
             T *h = new T[n_partitions];
 
             for (size_t i = 0; i < n_partitions; i++) {
-                if constexpr (variant == Variant::Standard) {
-                    h[i] = math::align_number(histogram[i] * s / 100, 3ul) / 3;
-                } else {
-                    h[i] = math::align_number(histogram[i] * s / 100, FUSE_SEGMENTS + 2) / (FUSE_SEGMENTS + 2);
-                }
-                if (h[i] == 0) {
-                    h[i] = 1;
-                }
+                h[i] = xor_segment_size<variant>(histogram[i], s);
             }
 
             addresser = std::move(Addresser(h, n_partitions));
-            delete[](h);
 
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 for (auto &offset : offsets) {
                     offset = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)));
                 }
                 seeds = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)), 0);
+                segment_counts = 0;
+                if constexpr (xor_binary_fuse<variant>()) {
+                    segment_counts = simd::valloc<Vector>(simd::valign<Vector>(n_partitions * sizeof(T)), 0);
+                    for (size_t i = 0; i < n_partitions; i++) {
+                        segment_counts[i] = xor_segment_count<variant>(histogram[i], s, h[i]);
+                    }
+                }
             } else {
                 seeds = 0;
+                segment_counts = xor_segment_count<variant>(histogram[0], s, h[0]);
             }
+            delete[](h);
 
             T last_offset = 0;
             for (size_t i = 0; i < n_partitions; i++) {
                 size_t n_fingerprints = this->addresser.get_size(i);
+                size_t n_segments = segment_count_vertical(i).elements[0];
 
                 for (auto &offset : offsets) {
-                    if constexpr (partitioning == parameter::Partitioning::Enabled) {
+                    if constexpr (partitioning != parameter::Partitioning::Disabled) {
                         offset[i] = last_offset;
                     } else {
                         offset = last_offset;
@@ -114,9 +158,8 @@ namespace filters::nxor {
                     last_offset += n_fingerprints;
                 }
 
-                if constexpr (variant == Variant::Fuse) {
-                    last_offset += n_fingerprints * (FUSE_SEGMENTS - 1);
-                }
+                // the three offsets cover the first three segments
+                last_offset += n_fingerprints * (n_segments + arity - 1 - offsets.size());
 
                 // unaligned loads access two registers
                 // we need one extra register between next partition to avoid race-conditions
@@ -126,7 +169,7 @@ namespace filters::nxor {
             }
 
             n_bytes = simd::valign<Vector>(math::align_number(static_cast<size_t>(last_offset * k), 8ul) / 8);
-            fingerprints = reinterpret_cast<uint8_t *>(simd::valloc<Vector>(n_bytes, 0, true));
+            fingerprints = reinterpret_cast<uint8_t *>(simd::valloc<Vector>(n_bytes, 0, policy));
 
             for (size_t i = 0; i < Vector::n_elements; i++) {
                 base.elements[i] = i;
@@ -137,15 +180,8 @@ namespace filters::nxor {
                      const T offset2) : fingerprints(fingerprints), n_bytes(0), seeds(0) {
             static_assert(partitioning == parameter::Partitioning::Disabled);
 
-            T histogram;
-            if constexpr (variant == Variant::Standard) {
-                histogram = math::align_number(length * s / 100, 3ul) / 3;
-            } else {
-                histogram = math::align_number(length * s / 100, FUSE_SEGMENTS + 2) / (FUSE_SEGMENTS + 2);
-            }
-            if (histogram == 0) {
-                histogram = 1;
-            }
+            T histogram = xor_segment_size<variant>(length, s);
+            segment_counts = xor_segment_count<variant>(length, s, histogram);
             addresser = std::move(Addresser(&histogram, 1));
 
             offsets[0] = offset0;
@@ -153,14 +189,45 @@ namespace filters::nxor {
             offsets[2] = offset2;
         }
 
+        /**
+         * copies other into memory allocated with policy, e.g., a replica on another node
+         */
+        XorContainer(const XorContainer &other, const size_t n_partitions, const memory::AllocationPolicy &policy)
+                : addresser(other.addresser.copy(n_partitions)), n_bytes(other.n_bytes), base(other.base),
+                  policy(policy), stashed_keys(other.stashed_keys), stash_offsets(other.stash_offsets),
+                  stash_filter(other.stash_filter), stash_shift(other.stash_shift) {
+            for (size_t i = 0; i < offsets.size(); i++) {
+                if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                    offsets[i] = simd::vcopy<Vector>(other.offsets[i], n_partitions * sizeof(T));
+                } else {
+                    offsets[i] = other.offsets[i];
+                }
+            }
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                seeds = simd::vcopy<Vector>(other.seeds, n_partitions * sizeof(T));
+                segment_counts = 0;
+                if constexpr (xor_binary_fuse<variant>()) {
+                    segment_counts = simd::vcopy<Vector>(other.segment_counts, n_partitions * sizeof(T));
+                }
+            } else {
+                seeds = other.seeds;
+                segment_counts = other.segment_counts;
+            }
+            fingerprints = reinterpret_cast<uint8_t *>(simd::valloc<Vector>(n_bytes, 0, policy));
+            std::memcpy(fingerprints, other.fingerprints, n_bytes);
+        }
+
         ~XorContainer() {
-            if (fingerprints && n_bytes > 0) {
-                simd::vfree(fingerprints, n_bytes, true);
+            if (fingerprints && n_bytes > 0 && not mapping) {
+                simd::vfree(fingerprints, n_bytes, policy);
             }
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 if (seeds) {
                     free(seeds);
                 }
+                if (segment_counts) {
+                    free(segment_counts);
+                }
                 for (auto *offset : offsets) {
                     if (offset) {
                         free(offset);
@@ -169,15 +236,178 @@ namespace filters::nxor {
             }
         }
 
+        void save(serialize::Writer &writer, const size_t n_partitions) const {
+            addresser.save(writer, n_partitions);
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                for (auto *offset : offsets) {
+                    writer.array(offset, n_partitions * sizeof(T));
+                }
+                writer.array(seeds, n_partitions * sizeof(T));
+                if constexpr (xor_binary_fuse<variant>()) {
+                    writer.array(segment_counts, n_partitions * sizeof(T));
+                }
+            } else {
+                for (auto offset : offsets) {
+                    writer.value(offset);
+                }
+                writer.value(seeds);
+                if constexpr (xor_binary_fuse<variant>()) {
+                    writer.value(segment_counts);
+                }
+            }
+            writer.array(fingerprints, n_bytes);
+            if constexpr (stash) {
+                writer.array(stashed_keys.data(), stashed_keys.size() * sizeof(T));
+                writer.array(stash_offsets.data(), stash_offsets.size() * sizeof(size_t));
+            }
+        }
+
+        void load(serialize::Reader &reader) {
+            XorContainer loaded;
+            loaded.addresser.load(reader);
+            for (auto &offset : loaded.offsets) {
+                if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                    offset = reader.copy<T>();
+                } else {
+                    offset = reader.value<T>();
+                }
+            }
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                loaded.seeds = reader.copy<T>();
+            } else {
+                loaded.seeds = reader.value<T>();
+            }
+            // the segment counts of the other variants are constant
+            if constexpr (xor_binary_fuse<variant>()) {
+                if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                    loaded.segment_counts = reader.copy<T>();
+                } else {
+                    loaded.segment_counts = reader.value<T>();
+                }
+            }
+            loaded.fingerprints = reader.array<uint8_t>(loaded.n_bytes);
+            if constexpr (stash) {
+                size_t n_stash_bytes;
+                const T *keys = reader.array<T>(n_stash_bytes);
+                loaded.stashed_keys.assign(keys, keys + n_stash_bytes / sizeof(T));
+                const size_t *stash_offsets = reader.array<size_t>(n_stash_bytes);
+                loaded.stash_offsets.assign(stash_offsets, stash_offsets + n_stash_bytes / sizeof(size_t));
+                loaded.build_stash_filter();
+            }
+            loaded.mapping = reader.mapping();
+            for (size_t i = 0; i < Vector::n_elements; i++) {
+                loaded.base.elements[i] = i;
+            }
+            *this = std::move(loaded);
+        }
+
         forceinline
         size_t length() const {
-            return n_bytes;
+            return n_bytes + (stashed_keys.size() + stash_filter.size()) * sizeof(T) +
+                   stash_offsets.size() * sizeof(size_t);
+        }
+
+        /**
+         * adds the keys stashed[i] to the stash of partition i
+         */
+        void add_to_stash(const std::vector<std::vector<T>> &stashed) {
+            std::vector<T> keys;
+            std::vector<size_t> offsets(stashed.size() + 1, 0);
+            for (size_t i = 0; i < stashed.size(); i++) {
+                if (i + 1 < stash_offsets.size()) {
+                    keys.insert(keys.end(), stashed_keys.begin() + stash_offsets[i],
+                            stashed_keys.begin() + stash_offsets[i + 1]);
+                }
+                keys.insert(keys.end(), stashed[i].begin(), stashed[i].end());
+                std::sort(keys.begin() + offsets[i], keys.end());
+                offsets[i + 1] = keys.size();
+            }
+            stashed_keys = std::move(keys);
+            stash_offsets = std::move(offsets);
+            build_stash_filter();
+        }
+
+        /**
+         * sizes the filter to about 16 bits per stashed key (a power of two of at least two words)
+         */
+        void build_stash_filter() {
+            constexpr size_t n_bits = sizeof(T) * 8;
+            constexpr size_t log_n_max_words = n_bits - 2 * log_n_word_bits;
+
+            stash_filter.clear();
+            if (stashed_keys.empty()) {
+                return;
+            }
+            size_t log_n_words = 1;
+            while (log_n_words < log_n_max_words and (1ull << log_n_words) * n_bits < stashed_keys.size() * 16) {
+                log_n_words++;
+            }
+            stash_shift = n_bits - log_n_words;
+            stash_filter.assign(1ull << log_n_words, 0);
+            for (const T key : stashed_keys) {
+                const T product = key * stash_multiplier;
+                stash_filter[product >> stash_shift] |= stash_bits(Vector(product)).elements[0];
+            }
+        }
+
+        static constexpr T stash_multiplier = (sizeof(T) == 4) ? 0x9e3779b1u : 0x9e3779b97f4a7c15ull;
+        static constexpr size_t log_n_word_bits = (sizeof(T) == 4) ? 5 : 6;
+
+        /**
+         * the two bits of the filter word that a key sets, taken from its product below the word index
+         */
+        forceinline
+        Vector stash_bits(const Vector &product) const {
+            const Vector word_bits = Vector(sizeof(T) * 8 - 1);
+            const Vector bit0 = (product >> (stash_shift - log_n_word_bits)) & word_bits;
+            const Vector bit1 = (product >> (stash_shift - 2 * log_n_word_bits)) & word_bits;
+            return (Vector(1) << bit0) | (Vector(1) << bit1);
+        }
+
+        /**
+         * lanes of mask that are not in found, M is a bool for scalar vectors
+         */
+        forceinline
+        static M missing(const M mask, const M found) {
+            if constexpr (Vector::avx) {
+                return mask & ~found;
+            } else {
+                return mask and not found;
+            }
+        }
+
+        /**
+         * lanes of mask whose key is in the stash of partition index: lanes that pass the filter are searched in the
+         * keys of the partition, nothing is done if the partition has no stashed keys
+         */
+        forceinline
+        M stash_contains(const Vector &values, const size_t index, const M mask) const {
+            M found = 0;
+            if constexpr (stash) {
+                if (index + 1 < stash_offsets.size() and stash_offsets[index] < stash_offsets[index + 1] and mask) {
+                    const Vector product = values * Vector(stash_multiplier);
+                    const Vector bits = stash_bits(product);
+                    const Vector words = (product >> stash_shift).gather(stash_filter.data(), mask);
+                    const M candidates = mask & ((words & bits) == bits);
+                    if (candidates) {
+                        const auto begin = stashed_keys.begin() + stash_offsets[index];
+                        const auto end = stashed_keys.begin() + stash_offsets[index + 1];
+                        for (size_t lane = 0; lane < Vector::n_elements; lane++) {
+                            if ((candidates >> lane) & 1) {
+                                const bool hit = std::binary_search(begin, end, values.elements[lane]);
+                                found |= static_cast<M>(hit) << lane;
+                            }
+                        }
+                    }
+                }
+            }
+            return found;
         }
 
         template<size_t a>
         forceinline
         Vector offset_vertical(const size_t index) const {
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 return Vector(std::get<a>(offsets)[index]);
             } else {
                 return Vector(std::get<a>(offsets));
@@ -187,7 +417,7 @@ namespace filters::nxor {
         template<size_t a>
         forceinline
         Vector offset_horizontal(const size_t index) const {
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 return Vector::load(std::get<a>(offsets) + index);
             } else {
                 return Vector(std::get<a>(offsets));
@@ -196,7 +426,7 @@ namespace filters::nxor {
 
         forceinline
         Vector seed_vertical(const size_t index) const {
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 return Vector(seeds[index]);
             } else {
                 return Vector(seeds);
@@ -205,16 +435,38 @@ namespace filters::nxor {
 
         forceinline
         Vector seed_horizontal(const size_t index) const {
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 return Vector::load(seeds + index);
             } else {
                 return Vector(seeds);
             }
         }
 
+        forceinline
+        Vector segment_count_vertical(const size_t index) const {
+            if constexpr (not xor_binary_fuse<variant>()) {
+                return Vector(xor_segment_count<variant>(0, 0, 1));
+            } else if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                return Vector(segment_counts[index]);
+            } else {
+                return Vector(segment_counts);
+            }
+        }
+
+        forceinline
+        Vector segment_count_horizontal(const size_t index) const {
+            if constexpr (not xor_binary_fuse<variant>()) {
+                return Vector(xor_segment_count<variant>(0, 0, 1));
+            } else if constexpr (partitioning != parameter::Partitioning::Disabled) {
+                return Vector::load(segment_counts + index);
+            } else {
+                return Vector(segment_counts);
+            }
+        }
+
         forceinline
         void set_seed(const T &seed, const size_t index) {
-            if constexpr (partitioning == parameter::Partitioning::Enabled) {
+            if constexpr (partitioning != parameter::Partitioning::Disabled) {
                 seeds[index] = seed;
             } else {
                 seeds = seed;
@@ -281,6 +533,7 @@ namespace filters::nxor {
         void assign_fuse(const Stack &stack, const Vector &offset0, const Vector &offset1, const Vector &offset2,
                          const size_t index, M mask) {
             const Vector segment_size = addresser.get_vsize(index);
+            const Vector segment_count = segment_count_horizontal(index);
             const Vector begin = stack.begin;
             Vector end = stack.end;
 
@@ -288,7 +541,7 @@ namespace filters::nxor {
                 end = end.add_mask(Vector(-2), m);
                 const Vector hash = end.gather(stack.stack, m);
                 const Vector address = (end + Vector(1)).gather(stack.stack, m);
-                const Vector segment = xor_segment<Variant::Fuse>(hash) * segment_size;
+                const Vector segment = xor_segment<variant>(hash, segment_count) * segment_size;
 
                 const Vector address0 = segment + compute_address_horizontal<0, rf0>(hash, offset0, index);
                 const Vector address1 = segment + compute_address_horizontal<1, rf1>(hash, offset1, index);
@@ -297,7 +550,13 @@ namespace filters::nxor {
                 const Vector fingerprint0 = get_fingerprint(address0, m);
                 const Vector fingerprint1 = get_fingerprint(address1, m);
                 const Vector fingerprint2 = get_fingerprint(address2, m);
-                const Vector fingerprint = xor_fingerprint(hash) ^fingerprint0 ^fingerprint1 ^fingerprint2;
+                Vector fingerprint = xor_fingerprint(hash) ^fingerprint0 ^fingerprint1 ^fingerprint2;
+
+                if constexpr (arity == 4) {
+                    const Vector offset3 = offset2 + segment_size;
+                    const Vector address3 = segment + compute_address_horizontal<3, RF3>(hash, offset3, index);
+                    fingerprint = fingerprint ^ get_fingerprint(address3, m);
+                }
 
                 set_fingerprint(fingerprint, address + offset0, m);
             }
@@ -323,19 +582,24 @@ namespace filters::nxor {
 
         template<size_t rf0, size_t rf1, size_t rf2>
         forceinline
-        M contains(const Vector &hash, const Vector segment_size, const Vector &offset0, const Vector &offset1,
-                   const Vector &offset2, const size_t index, const M mask) const {
+        M contains(const Vector &hash, const Vector segment_size, const Vector &segment_count, const Vector &offset0,
+                   const Vector &offset1, const Vector &offset2, const size_t index, const M mask) const {
             const Vector fingerprint = xor_fingerprint(hash);
-            const Vector segment = xor_segment<variant>(hash) * segment_size;
+            const Vector segment = xor_segment<variant>(hash, segment_count) * segment_size;
 
             const Vector address0 = segment + compute_address_vertical<0, rf0>(hash, offset0, index);
             const Vector address1 = segment + compute_address_vertical<1, rf1>(hash, offset1, index);
             const Vector address2 = segment + compute_address_vertical<2, rf2>(hash, offset2, index);
 
-            const Vector fingerprint0 = get_fingerprint(address0, mask);
+            Vector fingerprint0 = get_fingerprint(address0, mask);
             const Vector fingerprint1 = get_fingerprint(address1, mask);
             const Vector fingerprint2 = get_fingerprint(address2, mask);
 
+            if constexpr (arity == 4) {
+                const Vector address3 = segment + compute_address_vertical<3, RF3>(hash, offset2 + segment_size, index);
+                fingerprint0 = fingerprint0 ^ get_fingerprint(address3, mask);
+            }
+
             if constexpr (not Vector::avx and (k == 8 || k == 16 || k == 32)) {
                 return (static_cast<Fingerprint>((fingerprint0 ^ fingerprint1 ^ fingerprint2).vector) ==
                         static_cast<Fingerprint>(fingerprint.vector));
@@ -350,6 +614,7 @@ namespace filters::nxor {
             const Vector seed = seed_vertical(index);
 
             const Vector segment_size = Vector(addresser.get_size(index));
+            const Vector segment_count = segment_count_vertical(index);
             const Vector offset0 = offset_vertical<0>(index);
             const Vector offset1 = offset_vertical<1>(index);
             const Vector offset2 = offset_vertical<2>(index);
@@ -357,15 +622,60 @@ namespace filters::nxor {
             const Vector values = Vector(value);
             const Vector hash = Hasher::hash(values ^ seed);
 
-            return contains<rf0, rf1, rf2>(hash, segment_size, offset0, offset1, offset2, index, 1);
+            const M found = contains<rf0, rf1, rf2>(hash, segment_size, segment_count, offset0, offset1, offset2,
+                    index, 1);
+            return found | stash_contains(values, index, found ^ 1);
+        }
+
+        template<size_t rf0, size_t rf1, size_t rf2>
+        forceinline
+        M contains(const Vector &values, const size_t index, const M mask) const {
+            const Vector seed = seed_vertical(index);
+
+            const Vector segment_size = Vector(addresser.get_size(index));
+            const Vector segment_count = segment_count_vertical(index);
+            const Vector offset0 = offset_vertical<0>(index);
+            const Vector offset1 = offset_vertical<1>(index);
+            const Vector offset2 = offset_vertical<2>(index);
+
+            const Vector hash = Hasher::hash(values ^ seed);
+
+            const M found = contains<rf0, rf1, rf2>(hash, segment_size, segment_count, offset0, offset1, offset2,
+                    index, mask);
+            return found | stash_contains(values, index, missing(mask, found));
+        }
+
+        /**
+         * prefetches the fingerprints of every lane
+         */
+        template<size_t rf0, size_t rf1, size_t rf2>
+        forceinline
+        void prefetch(const Vector &values, const size_t index, const M mask) const {
+            const Vector hash = Hasher::hash(values ^ seed_vertical(index));
+            const Vector segment_size = Vector(addresser.get_size(index));
+            const Vector segment = xor_segment<variant>(hash, segment_count_vertical(index)) * segment_size;
+
+            const Vector address0 = segment + compute_address_vertical<0, rf0>(hash, offset_vertical<0>(index), index);
+            const Vector address1 = segment + compute_address_vertical<1, rf1>(hash, offset_vertical<1>(index), index);
+            const Vector address2 = segment + compute_address_vertical<2, rf2>(hash, offset_vertical<2>(index), index);
+
+            simd::prefetch(fingerprints, (address0 * Vector(k)) >> 3, mask);
+            simd::prefetch(fingerprints, (address1 * Vector(k)) >> 3, mask);
+            simd::prefetch(fingerprints, (address2 * Vector(k)) >> 3, mask);
+            if constexpr (arity == 4) {
+                const Vector offset3 = offset_vertical<2>(index) + segment_size;
+                const Vector address3 = segment + compute_address_vertical<3, RF3>(hash, offset3, index);
+                simd::prefetch(fingerprints, (address3 * Vector(k)) >> 3, mask);
+            }
         }
 
         template<size_t rf0, size_t rf1, size_t rf2>
         forceinline
-        size_t count(const T *begin, const T *end, const size_t index) {
+        size_t count(const T *begin, const T *end, const size_t index) const {
             const Vector seed = seed_vertical(index);
 
             const Vector segment_size = Vector(addresser.get_size(index));
+            const Vector segment_count = segment_count_vertical(index);
             const Vector offset0 = offset_vertical<0>(index);
             const Vector offset1 = offset_vertical<1>(index);
             const Vector offset2 = offset_vertical<2>(index);
@@ -377,8 +687,9 @@ namespace filters::nxor {
                 const Vector values = Vector::load(begin);
                 const Vector hash = Hasher::hash(values ^ seed);
 
-                counter += Vector::popcount_mask(
-                        contains<rf0, rf1, rf2>(hash, segment_size, offset0, offset1, offset2, index, mask));
+                const M found = contains<rf0, rf1, rf2>(hash, segment_size, segment_count, offset0, offset1, offset2,
+                        index, mask);
+                counter += Vector::popcount_mask(found | stash_contains(values, index, missing(mask, found)));
             }
 
             if constexpr (Vector::avx) {
@@ -387,8 +698,9 @@ namespace filters::nxor {
                     const Vector values = Vector::load(begin);
                     const Vector hash = Hasher::hash(values ^ seed);
 
-                    counter += Vector::popcount_mask(
-                            contains<rf0, rf1, rf2>(hash, segment_size, offset0, offset1, offset2, index, mask));
+                    const M found = contains<rf0, rf1, rf2>(hash, segment_size, segment_count, offset0, offset1,
+                            offset2, index, mask);
+                    counter += Vector::popcount_mask(found | stash_contains(values, index, missing(mask, found)));
                 }
             }
 
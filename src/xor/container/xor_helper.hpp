@@ -1,6 +1,8 @@
 #pragma once
 
 #include <compiler/compiler_hints.hpp>
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 
 namespace filters::nxor {
@@ -17,29 +19,80 @@ namespace filters::nxor {
         return vector ^ (vector >> (static_cast<size_t>(Vector::registerSize) / 2));
     }
 
+    template<Variant variant>
+    forceinline
+    constexpr size_t xor_arity() {
+        return (variant == Variant::BinaryFuse4) ? 4 : 3;
+    }
+
+    template<Variant variant>
+    forceinline
+    constexpr bool xor_binary_fuse() {
+        return variant == Variant::BinaryFuse3 or variant == Variant::BinaryFuse4;
+    }
+
+    /**
+     * returns the first segment of a key, the key is mapped to xor_arity consecutive segments starting at it
+     */
     template<Variant variant, typename Vector>
     forceinline
-    static Vector xor_segment(const Vector &vector) {
+    static Vector xor_segment(const Vector &vector, const Vector &segment_count) {
+        constexpr size_t half = static_cast<size_t>(Vector::registerSize) / 2;
         if constexpr (variant == Variant::Standard) {
             return Vector(0);
         } else if constexpr (Vector::registerSize == parameter::RegisterSize::_64bit) {
             // taken from http://zimbry.blogspot.com/2011/09/better-bit-mixing-improving-on.html
-            return (vector * Vector(0xbf58476d1ce4e5b9))
-                    >> (static_cast<size_t>(Vector::registerSize) - math::const_log2(FUSE_SEGMENTS));
+            const Vector mixed = vector * Vector(0xbf58476d1ce4e5b9);
+            if constexpr (variant == Variant::Fuse) {
+                return mixed >> (static_cast<size_t>(Vector::registerSize) - math::const_log2(FUSE_SEGMENTS));
+            } else {
+                return ((mixed >> half) * segment_count) >> half;
+            }
         } else {
             // taken from https://github.com/aappleby/smhasher/blob/master/src/MurmurHash2.cpp
-            return (vector * Vector(0x5bd1e995))
-                    >> (static_cast<size_t>(Vector::registerSize) - math::const_log2(FUSE_SEGMENTS));
+            const Vector mixed = vector * Vector(0x5bd1e995);
+            if constexpr (variant == Variant::Fuse) {
+                return mixed >> (static_cast<size_t>(Vector::registerSize) - math::const_log2(FUSE_SEGMENTS));
+            } else {
+                return ((mixed >> half) * segment_count) >> half;
+            }
         }
     }
 
+    /**
+     * Number of fingerprints per segment. Binary fuse filters use power of two segments that grow with the number of
+     * keys (see Graf and Lemire, "Binary Fuse Filters: Fast and Smaller Than Xor Filters"), the segment size of the
+     * standard variant is the size of one of its three blocks.
+     */
     template<Variant variant>
-    forceinline
-    static size_t xor_number_of_segment() {
+    static size_t xor_segment_size(const size_t n_keys, const size_t s) {
+        size_t segment_size;
         if constexpr (variant == Variant::Standard) {
-            return 0;
+            segment_size = math::align_number(n_keys * s / 100, 3ul) / 3;
+        } else if constexpr (variant == Variant::Fuse) {
+            segment_size = math::align_number(n_keys * s / 100, FUSE_SEGMENTS + 2) / (FUSE_SEGMENTS + 2);
         } else {
+            const double n = std::max(static_cast<double>(n_keys), 1.0);
+            const double log_size = (variant == Variant::BinaryFuse3)
+                                    ? std::floor(std::log(n) / std::log(3.33) + 2.25)
+                                    : std::floor(std::log(n) / std::log(2.91) - 0.5);
+            segment_size = 1ul << std::clamp(static_cast<size_t>(std::max(log_size, 0.0)), 2ul, 18ul);
+        }
+        return std::max(segment_size, 1ul);
+    }
+
+    /**
+     * number of segments a key can start in, the filter has xor_segment_count + xor_arity - 1 segments
+     */
+    template<Variant variant>
+    static size_t xor_segment_count(const size_t n_keys, const size_t s, const size_t segment_size) {
+        if constexpr (variant == Variant::Standard) {
+            return 1;
+        } else if constexpr (variant == Variant::Fuse) {
             return FUSE_SEGMENTS;
+        } else {
+            const size_t n_segments = (n_keys * s / 100 + segment_size - 1) / segment_size;
+            return (n_segments > xor_arity<variant>() - 1) ? n_segments - (xor_arity<variant>() - 1) : 1;
         }
     }
 }
\ No newline at end of file
@@ -8,8 +8,7 @@
 namespace filters::nxor {
 
     template<Variant variant, typename Hasher, typename Vector, typename Addresser>
-    struct XorQueue {
-    };
+    struct XorQueue;
 
     template<typename Hasher, typename Vector, typename Addresser>
     struct XorQueue<Variant::Standard, Hasher, Vector, Addresser> {
@@ -22,10 +21,10 @@ namespace filters::nxor {
         std::array<Vector, 3> ends;
         T *queue;
 
-        XorQueue(const Addresser &addresser, const size_t index) {
+        XorQueue(const Set &set) {
             T last_offset = 0;
             for (size_t i = 0; i < Vector::n_elements; i++) {
-                const size_t n_blocks = addresser.get_size(index + i);
+                const size_t n_blocks = set.addresser.get_size(set.index + i);
 
                 for (size_t j = 0; j < begins.size(); j++) {
                     begins[j].elements[i] = last_offset;
@@ -99,10 +98,13 @@ namespace filters::nxor {
         }
     };
 
-    template<typename Hasher, typename Vector, typename Addresser>
-    struct XorQueue<Variant::Fuse, Hasher, Vector, Addresser> {
+    /**
+     * queue of the fuse variants (Fuse, BinaryFuse3 and BinaryFuse4)
+     */
+    template<Variant variant, typename Hasher, typename Vector, typename Addresser>
+    struct XorQueue {
 
-        using Set = XorSet<Variant::Fuse, Hasher, Vector, Addresser>;
+        using Set = XorSet<variant, Hasher, Vector, Addresser>;
         using T = typename Vector::T;
         using M = typename Vector::M;
 
@@ -110,13 +112,14 @@ namespace filters::nxor {
         Vector ends;
         T *queue;
 
-        XorQueue(const Addresser &addresser, const size_t index) {
+        XorQueue(const Set &set) {
+            const Vector set_size = set.size();
+
             T last_offset = 0;
             for (size_t i = 0; i < Vector::n_elements; i++) {
-                const size_t n_blocks = addresser.get_size(index + i);
                 begins.elements[i] = last_offset;
                 ends.elements[i] = last_offset;
-                last_offset += n_blocks * (FUSE_SEGMENTS + 2);
+                last_offset += set_size.elements[i];
             }
 
             size_t n_bytes = simd::valign<Vector>(last_offset * sizeof(T));
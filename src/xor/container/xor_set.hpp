@@ -16,14 +16,17 @@ namespace filters::nxor {
         using T = typename Vector::T;
         using M = typename Vector::M;
 
+        static constexpr size_t arity = xor_arity<variant>();
+
         const Addresser &addresser;
         const size_t index;
-        std::array<Vector, 3> begins;
+        std::array<Vector, arity> begins;
         Vector seed;
+        Vector segment_count;
         T *set;
 
-        XorSet(const Addresser &addresser, const Vector &seed, const size_t index) : addresser(addresser), index(index),
-                                                                                     seed(seed) {
+        XorSet(const Addresser &addresser, const Vector &seed, const size_t index, const Vector &segment_count)
+                : addresser(addresser), index(index), seed(seed), segment_count(segment_count) {
             T last_offset = 0;
             for (size_t i = 0; i < Vector::n_elements; i++) {
                 const size_t n_blocks = addresser.get_size(index + i);
@@ -33,9 +36,7 @@ namespace filters::nxor {
                     last_offset += n_blocks;
                 }
 
-                if constexpr (variant == Variant::Fuse) {
-                    last_offset += n_blocks * (FUSE_SEGMENTS - 1);
-                }
+                last_offset += n_blocks * (segment_count.elements[i] - 1);
             }
 
             // hold hash and counter -> multiply with 2
@@ -52,12 +53,12 @@ namespace filters::nxor {
             if constexpr (variant == Variant::Standard) {
                 return addresser.get_vsize(index);
             } else {
-                return addresser.get_vsize(index) * Vector(FUSE_SEGMENTS + 2);
+                return addresser.get_vsize(index) * (segment_count + Vector(arity - 1));
             }
         }
 
         void print() const {
-            for (size_t i = 0; i < addresser.get_vsize(index).vector * (FUSE_SEGMENTS + 2); i++) {
+            for (size_t i = 0; i < size().elements[0]; i++) {
                 std::cout << i << " | " << std::hex << set[2 * i] << std::dec << " " << set[2 * i + 1] << std::endl;
             }
         }
@@ -80,7 +81,7 @@ namespace filters::nxor {
 
         forceinline
         Vector get_address(const Vector &offset) const {
-            static_assert(variant == Variant::Fuse);
+            static_assert(variant != Variant::Standard);
             if constexpr (Vector::avx) {
                 return offset - begins[0];
             } else {
@@ -89,11 +90,11 @@ namespace filters::nxor {
         }
 
         forceinline
-        Vector get_segment_size() {
+        Vector get_segment(const Vector &hash) const {
             if constexpr (variant == Variant::Standard) {
                 return Vector(0);
             } else {
-                return addresser.get_vsize(index);
+                return xor_segment<variant>(hash, segment_count) * addresser.get_vsize(index);
             }
         }
 
@@ -115,16 +116,18 @@ namespace filters::nxor {
         void fill(const Vector &offset, const Vector &histogram, const T *values) {
             Vector begin = offset;
             const Vector end = begin + histogram;
-            const Vector segment_size = addresser.get_vsize(index);
 
             for (M mask; (mask = begin < end); begin = begin + Vector(1)) {
                 const Vector value = begin.gather(values, mask);
                 const Vector hash = Hasher::hash(value ^ seed);
-                const Vector segment = xor_segment<variant>(hash) * segment_size;
+                const Vector segment = get_segment(hash);
 
                 add<rf0, 0>(hash, segment, mask);
                 add<rf1, 1>(hash, segment, mask);
                 add<rf2, 2>(hash, segment, mask);
+                if constexpr (arity == 4) {
+                    add<RF3, 3>(hash, segment, mask);
+                }
             }
         }
 
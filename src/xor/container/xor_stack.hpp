@@ -7,8 +7,7 @@
 namespace filters::nxor {
 
     template<Variant variant, typename Hasher, typename Vector, typename Addresser>
-    struct XorStack {
-    };
+    struct XorStack;
 
     template<typename Hasher, typename Vector, typename Addresser>
     struct XorStack<Variant::Standard, Hasher, Vector, Addresser> {
@@ -50,6 +49,14 @@ namespace filters::nxor {
             return runs.back() - runs.front();
         }
 
+        /**
+         * hash of the i-th peeled key of a scalar stack
+         */
+        forceinline
+        T hash(const size_t i) const {
+            return stack[runs.front().elements[0] + i];
+        }
+
         template<size_t set0, size_t rf0, size_t set1, size_t rf1, size_t set2, size_t rf2>
         forceinline
         void process_queue(Set &set, Queue &queue) {
@@ -133,13 +140,46 @@ namespace filters::nxor {
                 process_queue<2, rf2, 0, rf0, 1, rf1>(set, queue);
             }
         }
+
+        template<size_t set0, size_t rf0>
+        forceinline
+        void remove(Set &set, Queue &queue, const Vector &hash, const M mask) {
+            const Vector one = Vector(1);
+            const Vector entry_offset = set.template get_offset<set0>(xor_rotate<rf0>(hash)) << 1;
+
+            const Vector entry_hash = (entry_offset.gather(set.set, mask) ^ hash);
+            const Vector entry_counter = ((entry_offset + one).gather(set.set, mask) - one);
+            entry_hash.scatter(set.set, entry_offset, mask);
+            entry_counter.scatter(set.set, entry_offset + one, mask);
+
+            const M entry_mask = mask & (entry_counter == one);
+            if (entry_mask) {
+                entry_hash.scatter(queue.queue, queue.ends[set0], entry_mask);
+                queue.ends[set0] = queue.ends[set0].add_mask(one, entry_mask);
+            }
+        }
+
+        /**
+         * removes an unpeeled key from the set (it goes to the stash) and queues its entries that are left with a
+         * single key, the next fill continues peeling from them
+         */
+        template<size_t rf0, size_t rf1, size_t rf2>
+        forceinline
+        void stash(Set &set, Queue &queue, const Vector &hash, const M mask) {
+            remove<0, rf0>(set, queue, hash, mask);
+            remove<1, rf1>(set, queue, hash, mask);
+            remove<2, rf2>(set, queue, hash, mask);
+        }
     };
 
-    template<typename Hasher, typename Vector, typename Addresser>
-    struct XorStack<Variant::Fuse, Hasher, Vector, Addresser> {
+    /**
+     * stack of the fuse variants (Fuse, BinaryFuse3 and BinaryFuse4)
+     */
+    template<Variant variant, typename Hasher, typename Vector, typename Addresser>
+    struct XorStack {
 
-        using Set = XorSet<Variant::Fuse, Hasher, Vector, Addresser>;
-        using Queue = XorQueue<Variant::Fuse, Hasher, Vector, Addresser>;
+        using Set = XorSet<variant, Hasher, Vector, Addresser>;
+        using Queue = XorQueue<variant, Hasher, Vector, Addresser>;
         using T = typename Vector::T;
         using M = typename Vector::M;
 
@@ -169,10 +209,17 @@ namespace filters::nxor {
             return (end - begin) >> 1;
         }
 
+        /**
+         * hash of the i-th peeled key of a scalar stack
+         */
+        forceinline
+        T hash(const size_t i) const {
+            return stack[begin.elements[0] + 2 * i];
+        }
+
         template<size_t rf0, size_t rf1, size_t rf2>
         forceinline
         void fill(Set &set, Queue &queue) {
-            const Vector segment_size = set.get_segment_size();
             const Vector zero = Vector(0);
             const Vector one = Vector(1);
 
@@ -186,7 +233,7 @@ namespace filters::nxor {
                 const Vector offset = (address + set.begins[0]) << 1;
                 const Vector hash = offset.gather(set.set, mask);
                 const Vector counter = (offset + one).gather(set.set, mask);
-                const Vector segment = xor_segment<Variant::Fuse>(hash) * segment_size;
+                const Vector segment = set.get_segment(hash);
 
                 const Vector entry0_offset = (segment + set.template get_offset<0>(xor_rotate<rf0>(hash))) << 1;
                 const Vector entry1_offset = (segment + set.template get_offset<1>(xor_rotate<rf1>(hash))) << 1;
@@ -230,6 +277,24 @@ namespace filters::nxor {
                 const M entry1_mask = mask & (entry1_counter == one);
                 const M entry2_mask = mask & (entry2_counter == one);
 
+                if constexpr (Set::arity == 4) {
+                    const Vector entry3_offset = (segment + set.template get_offset<3>(xor_rotate<RF3>(hash))) << 1;
+                    const Vector entry3_hash = (entry3_offset.gather(set.set, mask) ^ hash);
+                    const Vector entry3_counter = ((entry3_offset + one).gather(set.set, mask) - one);
+
+                    entry3_hash.scatter(set.set, entry3_offset, mask);
+                    entry3_counter.scatter(set.set, entry3_offset + one, mask);
+
+                    const M entry3_mask = mask & (entry3_counter == one);
+                    if constexpr (Vector::avx) {
+                        set.get_address(entry3_offset >> 1).scatter(queue.queue, queue_end, entry3_mask);
+                        queue_end = queue_end.add_mask(one, entry3_mask);
+                    } else if (entry3_mask) {
+                        set.get_address(entry3_offset >> 1).scatter(queue.queue, queue_end, entry3_mask);
+                        queue_end = queue_end + one;
+                    }
+                }
+
                 if constexpr (Vector::avx) {
                     set.get_address(entry0_offset >> 1).scatter(queue.queue, queue_end, entry0_mask);
                     queue_end = queue_end.add_mask(one, entry0_mask);
@@ -253,6 +318,42 @@ namespace filters::nxor {
                 }
             }
         }
+
+        template<size_t set0, size_t rf0>
+        forceinline
+        void remove(Set &set, Queue &queue, const Vector &hash, const Vector &segment, const M mask) {
+            const Vector one = Vector(1);
+            const Vector entry_offset = (segment + set.template get_offset<set0>(xor_rotate<rf0>(hash))) << 1;
+
+            const Vector entry_hash = (entry_offset.gather(set.set, mask) ^ hash);
+            const Vector entry_counter = ((entry_offset + one).gather(set.set, mask) - one);
+            entry_hash.scatter(set.set, entry_offset, mask);
+            entry_counter.scatter(set.set, entry_offset + one, mask);
+
+            const M entry_mask = mask & (entry_counter == one);
+            if (entry_mask) {
+                set.get_address(entry_offset >> 1).scatter(queue.queue, queue.ends, entry_mask);
+                queue.ends = queue.ends.add_mask(one, entry_mask);
+            }
+        }
+
+        /**
+         * removes an unpeeled key from the set (it goes to the stash) and queues its entries that are left with a
+         * single key, the next fill continues peeling from them. fill does not consume the queue, so it is reset.
+         */
+        template<size_t rf0, size_t rf1, size_t rf2>
+        forceinline
+        void stash(Set &set, Queue &queue, const Vector &hash, const M mask) {
+            const Vector segment = set.get_segment(hash);
+
+            queue.clear();
+            remove<0, rf0>(set, queue, hash, segment, mask);
+            remove<1, rf1>(set, queue, hash, segment, mask);
+            remove<2, rf2>(set, queue, hash, segment, mask);
+            if constexpr (Set::arity == 4) {
+                remove<3, RF3>(set, queue, hash, segment, mask);
+            }
+        }
     };
 
 } // filters::nxor
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <compiler/compiler_hints.hpp>
+#include <math/math.hpp>
+#include <simd/helper.hpp>
+#include <partition/cache_line_buffer.hpp>
+#include <partition/partitioner.hpp>
+
+namespace filters::nxor {
+
+    /**
+     * Streaming construction of a Xor or Fuse filter: keys are added in chunks and spilled to disk, grouped by their
+     * partition (like PartitionSet). finish() builds the partitions group by group, so only one group of
+     * Vector::n_elements partitions (per thread) is kept in memory at a time.
+     *
+     * All groups share one append-only spill file: each group buffers its keys and appends them as fixed-size runs,
+     * remembering the run indices. The buffers of all groups together take at most max(spill_budget, n_groups * 64)
+     * bytes.
+     *
+     * Keys are spilled unhashed, as the fallback construction rehashes a partition with a new seed.
+     */
+    template<typename Filter>
+    class XorBuilder {
+      private:
+        using Vector = typename Filter::Vector;
+        using T = typename Filter::T;
+        using Container = typename Filter::Container;
+        using CLB = partition::CacheLineBuffer<T>;
+
+        // bytes of all group buffers, a run has between 64 and 4096 bytes
+        static constexpr size_t spill_budget = 16 * 1024 * 1024;
+        static constexpr size_t n_max_run_keys = 4096 / sizeof(T);
+
+        /**
+         * temporary file, unlinked on creation and closed on destruction
+         */
+        struct SpillFile {
+            int fd{-1};
+            size_t n_runs{0};
+
+            explicit SpillFile(const std::string &directory) {
+                std::string path = directory + "/xor_builder_XXXXXX";
+                fd = mkstemp(path.data());
+                if (fd < 0) {
+                    throw std::runtime_error{"could not create spill file in " + directory + "!"};
+                }
+                unlink(path.c_str());
+            }
+
+            SpillFile(const SpillFile &) = delete;
+
+            SpillFile &operator=(const SpillFile &) = delete;
+
+            ~SpillFile() {
+                if (fd >= 0) {
+                    close(fd);
+                }
+            }
+        };
+
+        struct Spill {
+            std::vector<T> buffer;
+            std::vector<size_t> runs;
+        };
+
+        Filter &filter;
+        SpillFile file;
+        size_t n_partitions;
+        size_t n_groups;
+        size_t n_run_keys;
+        partition::Partitioner<Filter::OP::partitioning, T> partitioner;
+        T *histogram;
+        std::vector<Spill> spills;
+
+        forceinline
+        static void write_all(int fd, const T *values, size_t length) {
+            const char *data = reinterpret_cast<const char *>(values);
+            size_t n_bytes = length * sizeof(T);
+            while (n_bytes > 0) {
+                ssize_t n_written = ::write(fd, data, n_bytes);
+                if (n_written < 0) {
+                    throw std::runtime_error{"could not write spill file!"};
+                }
+                data += n_written;
+                n_bytes -= n_written;
+            }
+        }
+
+        forceinline
+        static void read_all(int fd, T *values, size_t length, off_t offset) {
+            char *data = reinterpret_cast<char *>(values);
+            size_t n_bytes = length * sizeof(T);
+            while (n_bytes > 0) {
+                ssize_t n_read = ::pread(fd, data, n_bytes, offset);
+                if (n_read <= 0) {
+                    throw std::runtime_error{"could not read spill file!"};
+                }
+                data += n_read;
+                offset += n_read;
+                n_bytes -= n_read;
+            }
+        }
+
+        /**
+         * appends the buffer of a group as a run, a partial run is padded to n_run_keys
+         */
+        forceinline
+        void flush(Spill &spill) {
+            if (spill.buffer.empty()) {
+                return;
+            }
+            spill.buffer.resize(n_run_keys);
+            write_all(file.fd, spill.buffer.data(), n_run_keys);
+            spill.runs.push_back(file.n_runs++);
+            spill.buffer.clear();
+        }
+
+        /**
+         * reads the runs of a group and scatters its keys to the partitions, which are laid out like in
+         * PartitionSet (padded to cache line buffers)
+         */
+        bool construct_group(size_t group) {
+            Spill &spill = spills[group];
+            const size_t first = group * Vector::n_elements;
+
+            T *offsets = simd::valloc<Vector>(simd::valign<Vector>(Vector::n_elements * sizeof(T)), 0);
+            T positions[Vector::n_elements];
+            size_t length = 0;
+            for (size_t i = 0; i < Vector::n_elements; i++) {
+                offsets[i] = positions[i] = length;
+                length += (histogram[first + i] / CLB::n_tuples_per_cache_line_buffer + 1) *
+                          CLB::n_tuples_per_cache_line_buffer;
+            }
+            T *values = reinterpret_cast<T *>(aligned_alloc(64, length * sizeof(T)));
+
+            T chunk[n_max_run_keys];
+            size_t n_keys = 0;
+            for (size_t i = 0; i < Vector::n_elements; i++) {
+                n_keys += histogram[first + i];
+            }
+            for (size_t run = 0; run < spill.runs.size(); run++) {
+                const size_t n = std::min(n_run_keys, n_keys - run * n_run_keys);
+                read_all(file.fd, chunk, n, spill.runs[run] * n_run_keys * sizeof(T));
+                for (size_t i = 0; i < n; i++) {
+                    values[positions[partitioner(chunk[i]) - first]++] = chunk[i];
+                }
+            }
+            std::vector<size_t>().swap(spill.runs);
+
+            const Vector offset = Vector::load(offsets);
+            const Vector group_histogram = Vector::load(histogram + first);
+            bool success = filter._construct(offset, group_histogram, values, first);
+
+            free(values);
+            free(offsets);
+            return success;
+        }
+
+      public:
+        /**
+         * the spill file is created (and immediately unlinked) in directory
+         */
+        XorBuilder(Filter &filter, const std::string &directory = "/tmp") : filter(filter), file(directory) {
+            n_partitions = (Filter::OP::partitioning != parameter::Partitioning::Disabled)
+                           ? std::max(filter.n_partitions, 1ul)
+                           : 1;
+            n_groups = math::align_number(n_partitions, Vector::n_elements) / Vector::n_elements;
+            n_run_keys = std::clamp(spill_budget / n_groups, 64ul, 4096ul) / sizeof(T);
+            partitioner = partition::Partitioner<Filter::OP::partitioning, T>(n_partitions);
+
+            const size_t n_bytes = simd::valign<Vector>(n_groups * Vector::n_elements * sizeof(T));
+            histogram = simd::valloc<Vector>(n_bytes, 0);
+
+            spills.resize(n_groups);
+            for (Spill &spill : spills) {
+                spill.buffer.reserve(n_run_keys);
+            }
+        }
+
+        XorBuilder(const XorBuilder &) = delete;
+
+        XorBuilder &operator=(const XorBuilder &) = delete;
+
+        ~XorBuilder() {
+            free(histogram);
+        }
+
+        void add(const T *values, size_t length) {
+            for (size_t i = 0; i < length; i++) {
+                const size_t partition = partitioner(values[i]);
+                Spill &spill = spills[partition / Vector::n_elements];
+                histogram[partition]++;
+                spill.buffer.push_back(values[i]);
+                if (spill.buffer.size() == n_run_keys) {
+                    flush(spill);
+                }
+            }
+        }
+
+        /**
+         * builds the filter from all added keys, the builder must not be used afterwards
+         */
+        bool finish() {
+            for (Spill &spill : spills) {
+                flush(spill);
+                spill.buffer.shrink_to_fit();
+            }
+
+            filter.n_partitions = n_partitions;
+            filter.stashes.assign(n_partitions, {});
+
+            if constexpr (Filter::OP::multiThreading == parameter::MultiThreading::Disabled) {
+                bool success = true;
+                filter.container = std::move(Container(filter.s, n_partitions, histogram, filter.policy));
+                for (size_t group = 0; group < n_groups; group++) {
+                    success &= construct_group(group);
+                }
+                filter._finish_stash();
+
+                filter.prefetch_distance = simd::prefetch_distance(filter.size());
+                if (success and filter.policy.placement == memory::Placement::Replicated) {
+                    filter.replicate();
+                }
+                return success;
+            } else {
+                std::atomic<uint8_t> success{1};
+
+                filter.queue.add_task([&](size_t) {
+                    filter.container = std::move(Container(filter.s, n_partitions, histogram, filter.policy));
+                });
+                filter.queue.add_barrier();
+                for (size_t group = 0; group < n_groups; group++) {
+                    filter.queue.add_task([this, &success, group](size_t) {
+                        success &= construct_group(group);
+                    });
+                }
+                filter.queue.execute_tasks();
+                filter._finish_stash();
+
+                filter.prefetch_distance = simd::prefetch_distance(filter.size());
+                if (success and filter.policy.placement == memory::Placement::Replicated) {
+                    filter.replicate();
+                }
+                return success;
+            }
+        }
+    };
+
+} // filters::nxor
@@ -1,16 +1,21 @@
 #pragma once
 
 #include <iostream>
+#include <unordered_set>
+#include <vector>
 #include <filter_base.hpp>
 #include <xor/container/xor_set.hpp>
 #include <xor/container/xor_queue.hpp>
 #include <xor/container/xor_stack.hpp>
 #include <xor/container/xor_container.hpp>
+#include <partition/partition_chunk.hpp>
+#include <task/interleaved_lookup.hpp>
 
 namespace filters {
 
     template<typename FilterParameter, size_t _k, typename OptimizationParameter>
-    struct Filter<FilterType::Xor, FilterParameter, _k, OptimizationParameter> {
+    struct Filter<FilterType::Xor, FilterParameter, _k, OptimizationParameter>
+            : FilterBase<Filter<FilterType::Xor, FilterParameter, _k, OptimizationParameter>, OptimizationParameter> {
 
         using FP = FilterParameter;
         static constexpr size_t k = _k;
@@ -18,19 +23,24 @@ namespace filters {
         static constexpr size_t max_n_retries = FP::max_n_retries;
         using OP = OptimizationParameter;
         static constexpr bool supports_add = false;
+        static constexpr bool supports_failsafe_add = false;
         static constexpr bool supports_add_partition = OP::simd == parameter::SIMD::Scalar;
 
         using Vector = simd::Vector<OP::registerSize, OP::simd>;
         using T = typename Vector::T;
         using M = typename Vector::M;
+        using Base = FilterBase<Filter, OptimizationParameter>;
+        using Base::local_container;
+        using Base::replicate;
         using Hasher = hash::Hasher<OP::hashingMode, Vector, 3>;
         using Addresser = addresser::Addresser<OP::addressingMode, Vector>;
         using PartitionSet = typename partition::PartitionSet<OP::partitioning, Vector>;
+        using BuildPartitionSet = typename partition::PartitionSet<OP::partitioning, Vector, OP::deduplication>;
 
         using Set = nxor::XorSet<variant, Hasher, Vector, Addresser>;
         using Queue = nxor::XorQueue<variant, Hasher, Vector, Addresser>;
         using Stack = nxor::XorStack<variant, Hasher, Vector, Addresser>;
-        using Container = nxor::XorContainer<variant, k, OP::partitioning, Hasher, Vector, Addresser>;
+        using Container = nxor::XorContainer<variant, k, OP::partitioning, Hasher, Vector, Addresser, FP::stash>;
 
         // types used for fallback (always scalar)
         using FallbackVector = simd::Vector<OP::registerSize, parameter::SIMD::Scalar>;
@@ -46,13 +56,17 @@ namespace filters {
         size_t n_partitions;
         size_t n_retries;
         Container container;
+        // keys of every partition that could not be peeled, moved to the stash of the container after construction
+        std::vector<std::vector<T>> stashes;
         task::TaskQueue<OP::multiThreading> queue;
-
-        Filter(size_t s, size_t n_partitions, size_t n_threads, size_t n_tasks_per_level) : s(s),
-                                                                                            n_partitions(n_partitions),
-                                                                                            n_retries(0),
-                                                                                            queue(n_threads,
-                                                                                                    n_tasks_per_level) {
+        memory::AllocationPolicy policy;
+        std::vector<Container> replicas;
+        // lookahead of unpartitioned lookups in vectors, 0 disables software prefetching
+        size_t prefetch_distance{0};
+
+        Filter(size_t s, size_t n_partitions, size_t n_threads, size_t n_tasks_per_level,
+               const memory::AllocationPolicy &policy = {}) : s(s), n_partitions(n_partitions), n_retries(0),
+                                                              queue(n_threads, n_tasks_per_level), policy(policy) {
         }
 
         forceinline
@@ -61,20 +75,23 @@ namespace filters {
                     "add_partition function only supported for scalar filters!");
 
             n_partitions = std::max(n_partitions, 1ul);
-            container = std::move(Container(s, n_partitions, histogram));
+            container = std::move(Container(s, n_partitions, histogram, policy));
+            stashes.assign(n_partitions, {});
+            replicas.clear();
+            prefetch_distance = simd::prefetch_distance(size());
         }
 
         forceinline
         bool contains(const T &value) const {
-            return contains(value, value & (n_partitions - 1));
+            return contains(value, partition::partition_of<OP::partitioning>(value, n_partitions));
         }
 
         forceinline
         bool contains(const T &value, size_t index) const {
             if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
-                return container.template contains<nxor::RF0, nxor::RF1, nxor::RF2>(value, 0);
+                return local_container().template contains<nxor::RF0, nxor::RF1, nxor::RF2>(value, 0);
             } else {
-                return container.template contains<nxor::RF0, nxor::RF1, nxor::RF2>(value, index);
+                return local_container().template contains<nxor::RF0, nxor::RF1, nxor::RF2>(value, index);
             }
         }
 
@@ -87,12 +104,13 @@ namespace filters {
         bool add_partition(const T *values, size_t length, size_t index) {
             static_assert(OP::simd == parameter::SIMD::Scalar,
                     "add_partition function only supported for scalar filters!");
+            replicas.clear();
 
             if constexpr (OP::partitioning == parameter::Partitioning::Disabled) {
-                _construct(Vector(0), Vector(length), values, 0);
-            } else {
-                _construct(Vector(0), Vector(length), values, index);
+                index = 0;
             }
+            _construct(Vector(0), Vector(length), values, index);
+            _finish_stash();
             return true;
         }
 
@@ -113,8 +131,9 @@ namespace filters {
                 container.set_seed(hash::single_seed<FallbackVector>(j).vector, index);
 
                 // use scalar Set, Queue and Stack
-                FallbackSet set(fallbackContainer.addresser, hash::single_seed<FallbackVector>(j), 0);
-                FallbackQueue queue(fallbackContainer.addresser, 0);
+                FallbackSet set(fallbackContainer.addresser, hash::single_seed<FallbackVector>(j), 0,
+                        fallbackContainer.segment_count_horizontal(0));
+                FallbackQueue queue(set);
                 FallbackStack stack(histogram);
 
                 // fill them
@@ -134,9 +153,70 @@ namespace filters {
             return (mask == 0);
         }
 
+        /**
+         * builds a partition in a single pass: whenever peeling gets stuck, one of the keys left in the set is moved
+         * to the stash and peeling continues from the entries it leaves with a single key
+         */
+        bool _construct_stash(const FallbackVector &offset, const FallbackVector &histogram, const T *values,
+                              const size_t index) {
+            n_retries++;
+
+            FallbackContainer fallbackContainer(container.fingerprints, histogram.vector, s,
+                    container.template offset_vertical<0>(index).elements[0],
+                    container.template offset_vertical<1>(index).elements[0],
+                    container.template offset_vertical<2>(index).elements[0]);
+
+            const FallbackVector seed = FallbackVector(0);
+            container.set_seed(seed.vector, index);
+
+            FallbackSet set(fallbackContainer.addresser, seed, 0, fallbackContainer.segment_count_horizontal(0));
+            FallbackQueue queue(set);
+            FallbackStack stack(histogram);
+
+            set.template fill<nxor::RF0, nxor::RF1, nxor::RF2>(offset, histogram, values);
+            queue.fill(set);
+            stack.template fill<nxor::RF0, nxor::RF1, nxor::RF2>(set, queue);
+
+            std::vector<T> &stash = stashes[index];
+            const size_t n_keys = histogram.vector;
+            if (stack.size().vector + stash.size() < n_keys) {
+                // a key is peeled iff its hash is on the stack, hashes of different keys only collide if all their
+                // entries collide, then neither key can be peeled
+                std::unordered_set<T> peeled;
+                for (size_t i = 0; i < stack.size().vector; i++) {
+                    peeled.insert(stack.hash(i));
+                }
+
+                std::vector<T> unpeeled;
+                for (size_t i = offset.vector; i < offset.vector + n_keys; i++) {
+                    if (not peeled.contains(FallbackHasher::hash(FallbackVector(values[i]) ^ seed).vector)) {
+                        unpeeled.push_back(values[i]);
+                    }
+                }
+
+                for (const T value : unpeeled) {
+                    const FallbackVector hash = FallbackHasher::hash(FallbackVector(value) ^ seed);
+                    if (peeled.contains(hash.vector)) {
+                        continue;
+                    }
+
+                    stash.push_back(value);
+                    const size_t n_peeled = stack.size().vector;
+                    stack.template stash<nxor::RF0, nxor::RF1, nxor::RF2>(set, queue, hash, 1);
+                    stack.template fill<nxor::RF0, nxor::RF1, nxor::RF2>(set, queue);
+                    for (size_t i = n_peeled; i < stack.size().vector; i++) {
+                        peeled.insert(stack.hash(i));
+                    }
+                }
+            }
+
+            fallbackContainer.template fill<nxor::RF0, nxor::RF1, nxor::RF2>(stack, 0, Vector::mask(1));
+            return stack.size().vector + stash.size() == n_keys;
+        }
+
         bool _construct(const Vector &offset, const Vector &histogram, const T *values, const size_t index) {
-            Set set(container.addresser, Vector(0), index);
-            Queue queue(container.addresser, index);
+            Set set(container.addresser, Vector(0), index, container.segment_count_horizontal(index));
+            Queue queue(set);
             Stack stack(histogram);
 
             set.template fill<nxor::RF0, nxor::RF1, nxor::RF2>(offset, histogram, values);
@@ -154,35 +234,58 @@ namespace filters {
                 size_t set_bit = __builtin_ctz(mask);
                 const FallbackVector fallback_offset = FallbackVector(offset.elements[set_bit]);
                 const FallbackVector fallback_histogram = FallbackVector(histogram.elements[set_bit]);
-                success &= _construct_fallback(fallback_offset, fallback_histogram, values, index + set_bit);
+                if constexpr (FP::stash) {
+                    success &= _construct_stash(fallback_offset, fallback_histogram, values, index + set_bit);
+                } else {
+                    success &= _construct_fallback(fallback_offset, fallback_histogram, values, index + set_bit);
+                }
                 mask ^= (1ull << set_bit);
             }
 
             return success;
         }
 
+        /**
+         * moves the keys stashed during construction into the container
+         */
+        void _finish_stash() {
+            if constexpr (FP::stash) {
+                container.add_to_stash(stashes);
+                for (auto &stash : stashes) {
+                    stash.clear();
+                }
+            }
+        }
+
         bool construct(T *values, size_t length) {
-            PartitionSet partitions(n_partitions);
+            replicas.clear();
+            BuildPartitionSet partitions(n_partitions);
             n_partitions = partitions.n_partitions;
+            stashes.assign(n_partitions, {});
 
             if constexpr (OP::multiThreading == parameter::MultiThreading::Disabled) {
                 bool success = true;
                 partitions.init(values, length);
-                container = std::move(Container(s, n_partitions, partitions.histogram));
+                container = std::move(Container(s, n_partitions, partitions.histogram, policy));
 
                 for (size_t i = 0; i < partitions.n_partitions; i += Vector::n_elements) {
                     const Vector offset = Vector::load(partitions.offsets + i);
                     const Vector histogram = Vector::load(partitions.histogram + i);
                     success &= _construct(offset, histogram, partitions.values, i);
                 }
+                _finish_stash();
 
+                prefetch_distance = simd::prefetch_distance(size());
+                if (success and policy.placement == memory::Placement::Replicated) {
+                    replicate();
+                }
                 return success;
             } else {
                 partitions.init(values, length, queue);
                 std::atomic<uint8_t> success{1};
 
                 queue.add_task([&](size_t) {
-                    container = std::move(Container(s, n_partitions, partitions.histogram));
+                    container = std::move(Container(s, n_partitions, partitions.histogram, policy));
                 });
                 queue.add_barrier();
                 for (size_t i = 0; i < partitions.n_partitions; i += Vector::n_elements) {
@@ -193,56 +296,39 @@ namespace filters {
                     });
                 }
                 queue.execute_tasks();
+                _finish_stash();
+
+                prefetch_distance = simd::prefetch_distance(size());
+                if (success and policy.placement == memory::Placement::Replicated) {
+                    replicate();
+                }
                 return success;
             }
         }
 
-        size_t count(T *values, size_t length) {
-            PartitionSet partitions(n_partitions);
-            if constexpr (OP::multiThreading == parameter::MultiThreading::Disabled) {
-
-                partitions.init(values, length);
-                size_t counter = 0;
-
-                for (size_t i = 0; i < partitions.n_partitions; i++) {
-                    const T *begin = partitions.values + partitions.offsets[i];
-                    const T *end = begin + partitions.histogram[i];
-                    counter += container.template count<nxor::RF0, nxor::RF1, nxor::RF2>(begin, end, i);
-                }
-
-                return counter;
-            } else {
-                partitions.init(values, length, queue);
+        forceinline
+        M _contains(const Container &local, const Vector &keys, const M mask, const size_t index) const {
+            return local.template contains<nxor::RF0, nxor::RF1, nxor::RF2>(keys, index, mask);
+        }
 
-                std::atomic<size_t> counter{0};
-                size_t remaining_tasks = queue.get_n_tasks_per_level();
-                for (size_t i = 0; i < partitions.n_partitions; i++) {
-                    // add at least one task
-                    size_t n_tasks = 1;
-                    if (remaining_tasks > 0) {
-                        n_tasks = std::max(remaining_tasks / (partitions.n_partitions - i), static_cast<size_t>(1));
-                        remaining_tasks -= n_tasks;
-                    }
+        forceinline
+        void _prefetch(const Container &local, const Vector &keys, const M mask, const size_t index) const {
+            local.template prefetch<nxor::RF0, nxor::RF1, nxor::RF2>(keys, index, mask);
+        }
 
-                    for (size_t j = 0; j < n_tasks; j++) {
-                        queue.add_task([this, &counter, &partitions, i, j, n_tasks](size_t) {
-                            const size_t length = partitions.histogram[i];
-                            const T *begin = partitions.values + partitions.offsets[i] +
-                                             simd::valign<Vector>((length / n_tasks + 1) * j);
-                            const T *end = partitions.values + partitions.offsets[i] +
-                                           std::min(simd::valign<Vector>((length / n_tasks + 1) * (j + 1)), length);
+        void _save(serialize::Writer &writer) const {
+            writer.value(n_retries);
+        }
 
-                            counter += container.template count<nxor::RF0, nxor::RF1, nxor::RF2>(begin, end, i);
-                        });
-                    }
-                }
-                queue.execute_tasks();
+        void _load(serialize::Reader &reader) {
+            n_retries = reader.value<size_t>();
+        }
 
-                return counter;
-            }
+        static std::string signature() {
+            return "Xor;" + std::to_string(k) + ";" + FP::to_string() + ";" + OP::to_string(false);
         }
 
-        size_t size() {
+        size_t size() const {
             return container.length();
         }
 
@@ -254,12 +340,20 @@ namespace filters {
             return n_retries;
         }
 
+        size_t stashed() const {
+            return container.stashed_keys.size();
+        }
+
         std::string to_string() {
             std::string s = "\n{\n";
             s += "\t\"k\": " + std::to_string(k) + ",\n";
             s += "\t\"size\": " + std::to_string(size() * 8) + " bits,\n";
             s += "\t\"n_partitions\": " + std::to_string(n_partitions) + ",\n";
             s += "\t\"n_retries\": " + std::to_string(n_retries) + ",\n";
+            if constexpr (FP::stash) {
+                s += "\t\"n_stashed\": " + std::to_string(stashed()) + ",\n";
+            }
+            s += "\t\"allocation\": " + policy.to_string() + ",\n";
             s += "\t\"filter_params\": " + FP::to_string() + ",\n";
             s += "\t\"optimization_params\": " + OP::to_string() + "\n";
             s += "}\n";
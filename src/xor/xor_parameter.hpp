@@ -9,18 +9,24 @@
 
 namespace filters::nxor {
 
-    static constexpr size_t RF0 = 0, RF1 = 21, RF2 = 42;
+    // RF3 is only used by 4-wise variants
+    static constexpr size_t RF0 = 0, RF1 = 21, RF2 = 42, RF3 = 48;
 
     static constexpr size_t FUSE_SEGMENTS = 128;
 
     enum class Variant : size_t {
-        Standard, Fuse
+        Standard, Fuse, BinaryFuse3, BinaryFuse4
     };
 
-    template<Variant _variant>
+    /**
+     * with stash, keys that can not be peeled are kept in an exact per-filter stash instead of retrying the
+     * partition with new seeds, so construction never fails and needs no retries
+     */
+    template<Variant _variant, bool _stash = false>
     struct XorParameter {
         static constexpr size_t max_n_retries = 16;
         static constexpr Variant variant = _variant;
+        static constexpr bool stash = _stash;
 
         static std::string to_string() {
             std::string s_variant;
@@ -31,16 +37,30 @@ namespace filters::nxor {
                 case Variant::Fuse:
                     s_variant = "Fuse";
                     break;
+                case Variant::BinaryFuse3:
+                    s_variant = "BinaryFuse3";
+                    break;
+                case Variant::BinaryFuse4:
+                    s_variant = "BinaryFuse4";
+                    break;
             }
 
             std::string s = "{";
             s += "\"variant\": \"" + s_variant + "\", ";
-            s += "\"max_n_retries\": " + std::to_string(max_n_retries) + "}";
+            s += "\"max_n_retries\": " + std::to_string(max_n_retries) + ", ";
+            s += "\"stash\": " + std::string(stash ? "true" : "false") + "}";
             return s;
         }
     };
 
     template<size_t> using Standard = XorParameter<Variant::Standard>;
     template<size_t> using Fuse = XorParameter<Variant::Fuse>;
+    template<size_t> using BinaryFuse3 = XorParameter<Variant::BinaryFuse3>;
+    template<size_t> using BinaryFuse4 = XorParameter<Variant::BinaryFuse4>;
+
+    template<size_t> using StandardStash = XorParameter<Variant::Standard, true>;
+    template<size_t> using FuseStash = XorParameter<Variant::Fuse, true>;
+    template<size_t> using BinaryFuse3Stash = XorParameter<Variant::BinaryFuse3, true>;
+    template<size_t> using BinaryFuse4Stash = XorParameter<Variant::BinaryFuse4, true>;
 
 } // filters::xor
@@ -33,6 +33,8 @@ namespace test::bloom {
 
     INSTANTIATE_TYPED_TEST_CASE_P(BloomSectorized512VerticalTestTypes, FilterTest, BloomSectorized512VerticalTestTypes);
 
+    INSTANTIATE_TYPED_TEST_CASE_P(BloomCounting512TestTypes, FilterTest, BloomCounting512TestTypes);
+
 }
 
 MAIN();
@@ -155,5 +155,25 @@ namespace test::bloom {
     using BloomSectorized512VerticalTestTypes = ::testing::Types<BloomAVXSmall2<bloom::Sectorized512Vertical, 0>,
             BloomAVX512Large2<bloom::Sectorized512Vertical, 51605>,
             BloomAVX512Large3<bloom::Sectorized512Vertical, 51536>>;
+
+    /*
+     * Counting Test Types, counters need four times the memory of bits
+     */
+
+    static constexpr size_t s_counting = 4 * s;
+
+    using BloomCounting512TestTypes = ::testing::Types<
+            FilterTestConfig<Bloom, bloom::Counting512, k_l, parameter::MagicMurmurScalar32MT, n_s, s_counting, 0, 2, 2,
+                    1>,
+            FilterTestConfig<Bloom, bloom::Counting512, k_s, parameter::PowerOfTwoMurmurScalar64, n_l, s_counting, 0, 0,
+                    0, 17528>,
+            FilterTestConfig<Bloom, bloom::Counting512, k_s, parameter::MagicMurmurScalar32Partitioned, n_l, s_counting,
+                    n_partitition_l, 0, 0, 88855>,
+            FilterTestConfig<Bloom, bloom::Counting512, k_s, parameter::PowerOfTwoMurmurAVX264Partitioned, n_l,
+                    s_counting, n_partitition_l, 0, 0, 17491>,
+            FilterTestConfig<Bloom, bloom::Counting512, k_s, parameter::MagicMurmurAVX232PartitionedMT, n_l, s_counting,
+                    n_partitition_l, 4, 16, 88855>,
+            FilterTestConfig<Bloom, bloom::Counting512, k_s, parameter::LemireMurmurAVX51264Partitioned, n_l,
+                    s_counting, n_partitition_l, 0, 0, 89861>>;
 }
 
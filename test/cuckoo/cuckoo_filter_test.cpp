@@ -17,6 +17,8 @@ namespace test::cuckoo {
 
     INSTANTIATE_TYPED_TEST_CASE_P(CuckooStandard8TestTypes, FilterTest, CuckooStandard8TestTypes);
 
+    INSTANTIATE_TYPED_TEST_CASE_P(CuckooStandardBFSTestTypes, FilterTest, CuckooStandardBFSTestTypes);
+
 }
 
 MAIN();
@@ -109,6 +109,15 @@ namespace test::cuckoo {
     using CuckooStandard8TestTypes = ::testing::Types<CuckooScalarSmall2<cuckoo::Standard8, 100, 6551>,
             CuckooScalarSmall3<cuckoo::Standard8, 105, 603>, CuckooScalarLarge2<cuckoo::Standard8, 110, 6264863>,
             CuckooAVX2Large3<cuckoo::Standard8, 190, 9310645>, CuckooAVX512Large3<cuckoo::Standard8, 101, 605467>>;
+
+    using CuckooStandardBFSTestTypes = ::testing::Types<CuckooScalarSmall2<cuckoo::Standard4BFS, 100, 4214>,
+            CuckooScalarSmall3<cuckoo::Standard4BFS, 103, 330>, CuckooScalarLarge1<cuckoo::Standard4BFS, 100, 2266>,
+            CuckooScalarLarge3<cuckoo::Standard4BFS, 108, 1120381>,
+            CuckooScalarLarge4<cuckoo::Standard4BFS, 100, 9206>, CuckooAVX2Large4<cuckoo::Standard4BFS, 108, 132038>,
+            CuckooAVX512Large3<cuckoo::Standard4BFS, 103, 300873>, CuckooScalarLarge1<cuckoo::Standard2BFS, 113, 540>,
+            CuckooScalarLarge4<cuckoo::Standard2BFS, 113, 4047>,
+            CuckooAVX512Large2<cuckoo::Standard2BFS, 113, 17217>>;
+
 }
 
 
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <filter.hpp>
+
+namespace test::dispatch {
+
+    namespace parameter = filters::parameter;
+
+    template<parameter::SIMD simd> using OP32 = parameter::OptimizationParameter<parameter::AddressingMode::Lemire,
+            parameter::HashingMode::Murmur, parameter::Partitioning::Enabled, parameter::RegisterSize::_32bit, simd,
+            parameter::MultiThreading::Disabled>;
+    template<parameter::SIMD simd> using OP64 = parameter::OptimizationParameter<parameter::AddressingMode::PowerOfTwo,
+            parameter::HashingMode::Murmur, parameter::Partitioning::Disabled, parameter::RegisterSize::_64bit, simd,
+            parameter::MultiThreading::Disabled>;
+
+    template<parameter::SIMD simd> using Bloom = filters::Filter<filters::FilterType::Bloom,
+            filters::bloom::Blocked512<8>, 8, OP32<simd>>;
+    template<parameter::SIMD simd> using Xor = filters::Filter<filters::FilterType::Xor, filters::nxor::BinaryFuse3<8>,
+            8, OP64<simd>>;
+    template<parameter::SIMD simd> using Cuckoo = filters::Filter<filters::FilterType::Cuckoo,
+            filters::cuckoo::Standard4<12>, 12, OP64<simd>>;
+
+}
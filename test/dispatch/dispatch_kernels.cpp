@@ -0,0 +1,6 @@
+#include <dispatch/dispatch_module.hpp>
+#include "dispatch_filters.hpp"
+
+FILTERS_DISPATCH_MODULE(FILTERS_DISPATCH_KERNEL("bloom", test::dispatch::Bloom<filters::simd::compiled_simd>),
+                        FILTERS_DISPATCH_KERNEL("xor", test::dispatch::Xor<filters::simd::compiled_simd>),
+                        FILTERS_DISPATCH_KERNEL("cuckoo", test::dispatch::Cuckoo<filters::simd::compiled_simd>))
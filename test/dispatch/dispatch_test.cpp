@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include "dispatch_test.hpp"
+
+namespace test::dispatch {
+
+    TEST(DispatchTest, CpuSupportsSelectedSimd) {
+        ASSERT_TRUE(filters::simd::cpu_supports(parameter::SIMD::Scalar));
+        ASSERT_TRUE(filters::simd::cpu_supports(filters::simd::cpu_simd()));
+        // this binary is running, so the cpu supports what it is compiled for
+        ASSERT_TRUE(filters::simd::cpu_supports(filters::simd::compiled_simd));
+    }
+
+    TEST(DispatchTest, LoadAcrossInstructionSets) {
+        load_across<Bloom>(144, 16);
+        load_across<Xor>(115, 0);
+        load_across<Cuckoo>(105, 0);
+    }
+
+#ifdef DISPATCH_MODULE_PREFIX
+
+    TEST(DispatchTest, ModuleMatchesScalarFilter) {
+        filters::dispatch::Dispatcher dispatcher(DISPATCH_MODULE_PREFIX);
+        ASSERT_EQ(dispatcher.simd(), filters::simd::cpu_simd()) << "Dispatcher has not selected the widest module.";
+
+        dispatch<Bloom>(dispatcher, "bloom", 144, 16);
+        dispatch<Xor>(dispatcher, "xor", 115, 0);
+        dispatch<Cuckoo>(dispatcher, "cuckoo", 105, 0);
+    }
+
+#endif
+
+}
+
+MAIN();
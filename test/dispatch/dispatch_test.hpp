@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <dispatch/dispatcher.hpp>
+#include <simd/cpu.hpp>
+#include "dispatch_filters.hpp"
+#include "../tester.hpp"
+
+namespace test::dispatch {
+
+    static constexpr size_t n = 100000;
+
+    /**
+     * loads a filter built for the widest compiled instruction set with every narrower one
+     */
+    template<template<parameter::SIMD> typename F>
+    void load_across(const size_t s, const size_t n_partitions) {
+        using Built = F<filters::simd::compiled_simd>;
+        using T = typename Built::T;
+        T *data = environment->template get_data<T>();
+
+        auto built = std::make_unique<Built>(s, n_partitions, 0, 0);
+        ASSERT_TRUE(built->construct(data, n)) << "Building filter has failed.";
+        const size_t n_matches = built->count(data, 11 * n);
+
+        const std::string path = ::testing::TempDir() + "dispatch_test.bin";
+        built->save(path);
+
+        auto check = [&]<parameter::SIMD simd>() {
+            if constexpr (static_cast<size_t>(simd) <= static_cast<size_t>(filters::simd::compiled_simd)) {
+                auto loaded = std::make_unique<F<simd>>(s, n_partitions, 0, 0);
+                loaded->load(path);
+                ASSERT_EQ(loaded->count(data, 11 * n), n_matches) << "Loaded filter does not match saved filter.";
+            }
+        };
+        check.template operator()<parameter::SIMD::Scalar>();
+        check.template operator()<parameter::SIMD::AVX2>();
+        check.template operator()<parameter::SIMD::AVX512>();
+        std::remove(path.c_str());
+    }
+
+    /**
+     * builds a filter with the kernels of a dispatch module, it has to match the filter of this binary
+     */
+    template<template<parameter::SIMD> typename F>
+    void dispatch(const filters::dispatch::Dispatcher &dispatcher, const std::string &name, const size_t s,
+                  const size_t n_partitions) {
+        using Scalar = F<parameter::SIMD::Scalar>;
+        using T = typename Scalar::T;
+        T *data = environment->template get_data<T>();
+
+        const filters::dispatch::Kernels<T> &kernels = dispatcher.kernels<T>(name);
+        void *filter = kernels.create(s, n_partitions, 0, 0);
+        ASSERT_TRUE(kernels.construct(filter, data, n)) << "Building filter has failed.";
+        ASSERT_EQ(kernels.count(filter, data, n), n) << "Filter has false negatives.";
+        const size_t n_matches = kernels.count(filter, data, 11 * n);
+
+        const std::string path = ::testing::TempDir() + "dispatch_test.bin";
+        kernels.save(filter, path.c_str());
+        kernels.destroy(filter);
+
+        auto loaded = std::make_unique<Scalar>(s, n_partitions, 0, 0);
+        loaded->load(path);
+        std::remove(path.c_str());
+        ASSERT_EQ(loaded->count(data, 11 * n), n_matches) << "Module does not match scalar filter.";
+    }
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include <filter_catalogue.hpp>
+#include "tester.hpp"
+
+/**
+ * FilterHandleTest, the handle is created from runtime parameters and compared with the templated filter
+ */
+template<typename _Catalogue, typename _Variant, size_t _k, filters::parameter::SIMD _simd, size_t _n, size_t _s,
+        size_t _n_partitions, size_t _n_threads, size_t _n_tasks_per_level, int64_t _expected_fp,
+        filters::parameter::Partitioning _partitioning = filters::parameter::Partitioning::Enabled,
+        filters::parameter::Deduplication _deduplication = filters::parameter::Deduplication::Disabled>
+struct FilterHandleTestConfig {
+    using Catalogue = _Catalogue;
+    using Variant = _Variant;
+    static constexpr size_t k = _k;
+    static constexpr filters::parameter::SIMD simd = _simd;
+    static constexpr size_t n = _n;
+    static constexpr size_t s = _s;
+    static constexpr size_t n_partitions = _n_partitions;
+    static constexpr size_t n_threads = _n_threads;
+    static constexpr size_t n_tasks_per_level = _n_tasks_per_level;
+    static constexpr int64_t expected_fp = _expected_fp;
+    static constexpr filters::parameter::Partitioning partitioning = _partitioning;
+    static constexpr filters::parameter::Deduplication deduplication = _deduplication;
+
+    // the instantiation the handle has to pick, see DefaultCatalogue
+    using OptimizationParameter = filters::parameter::OptimizationParameter<filters::parameter::AddressingMode::Lemire,
+            filters::parameter::HashingMode::Murmur,
+            (n_partitions > 1) ? partitioning : filters::parameter::Partitioning::Disabled,
+            Catalogue::register_size, simd,
+            (n_threads > 1) ? filters::parameter::MultiThreading::Enabled
+                            : filters::parameter::MultiThreading::Disabled, deduplication>;
+    using Filter = filters::Filter<Variant::type, typename Variant::template FP<k>, k, OptimizationParameter>;
+
+    static_assert(n <= max_n, "n is too large!");
+};
+
+template<typename TypeParam>
+class FilterHandleTest : public ::testing::Test {
+
+  public:
+    using T = typename TypeParam::Catalogue::T;
+
+    T *data;
+    size_t size = 11 * TypeParam::n;
+
+    void SetUp() override {
+        data = environment->template get_data<T>();
+    }
+
+    filters::FilterConfig config() const {
+        return {TypeParam::Variant::type, TypeParam::Variant::name, TypeParam::k, TypeParam::s,
+                TypeParam::n_partitions, TypeParam::n_threads, TypeParam::n_tasks_per_level, TypeParam::simd,
+                TypeParam::partitioning, TypeParam::deduplication};
+    }
+
+};
+
+TYPED_TEST_CASE_P(FilterHandleTest);
+
+TYPED_TEST_P(FilterHandleTest, ConstructAndCount) {
+    using T = typename TestFixture::T;
+
+    filters::FilterHandle<T> handle(TypeParam::Catalogue::module(), this->config());
+    ASSERT_EQ(handle.simd(), TypeParam::simd) << "Handle has picked another instruction set.";
+
+    bool success = handle.construct(this->data, TypeParam::n);
+    ASSERT_TRUE(success) << "could not build filter";
+    ASSERT_EQ(handle.count(this->data, TypeParam::n), TypeParam::n) << "Filter has false negatives.";
+
+    const size_t n_matches = handle.count(this->data, this->size);
+    std::vector<uint64_t> bitmap((this->size + 63) / 64);
+    ASSERT_EQ(handle.probe_bitmap(this->data, this->size, bitmap.data()), n_matches)
+                                << "Batched probe does not match count.";
+    size_t n_bits = 0;
+    for (uint64_t word : bitmap) {
+        n_bits += std::popcount(word);
+    }
+    ASSERT_EQ(n_bits, n_matches) << "Bitmap does not match count.";
+
+    auto filter = std::make_unique<typename TypeParam::Filter>(TypeParam::s, TypeParam::n_partitions,
+            TypeParam::n_threads, TypeParam::n_tasks_per_level);
+    ASSERT_TRUE(filter->construct(this->data, TypeParam::n)) << "could not build templated filter";
+    ASSERT_EQ(filter->size(), handle.size()) << "Handle has picked another filter.";
+    ASSERT_EQ(filter->count(this->data, this->size), n_matches) << "Handle has picked another filter.";
+
+    const size_t false_positives = n_matches - TypeParam::n;
+    std::cout << "#false positives: " << false_positives << std::endl;
+    if (TypeParam::expected_fp >= 0) {
+        ASSERT_EQ(false_positives, TypeParam::expected_fp) << "Number of false positive is not equal.";
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(FilterHandleTest, ConstructAndCount);
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdio>
 #include <gtest/gtest.h>
 #include <random>
+#include <vector>
 #include <filter.hpp>
 #include <perfevent.hpp>
 #include "tester.hpp"
@@ -87,6 +89,9 @@ TYPED_TEST_P(FilterTest, ConstructAndCount) {
         bool success = filter->construct(this->data, this->n);
         std::cout << filter->to_string() << std::endl;
         ASSERT_TRUE(success) << "Building filter has failed.";
+        if constexpr (requires { requires TypeParam::FilterParameter::stash; }) {
+            ASSERT_GT(filter->stashed(), 0) << "Filter has not stashed any keys.";
+        }
 
         size_t false_negatives = filter->count(this->data, this->n);
         ASSERT_EQ(false_negatives, this->n) << "Filter has false negatives.";
@@ -98,6 +103,100 @@ TYPED_TEST_P(FilterTest, ConstructAndCount) {
         }
     }
 
+    // test probe interfaces
+    if constexpr (requires(F &f, const typename TestFixture::T *values, uint32_t *positions, uint64_t *bitmap) {
+        f.probe(values, 0, positions);
+        f.probe_bitmap(values, 0, bitmap);
+    }) {
+        std::cout << "test probe" << std::endl;
+        std::vector<uint32_t> positions(this->size);
+        std::vector<uint64_t> bitmap((this->size + 63) / 64);
+
+        // probe an unaligned input to cover masked loads
+        const size_t offset = 1;
+        const size_t length = this->size - offset;
+        size_t n_matches = filter->probe(this->data + offset, length, positions.data());
+        ASSERT_EQ(n_matches, false_positives + this->n - offset) << "Probe does not match count.";
+        for (size_t i = 0; i + offset < this->n; i++) {
+            ASSERT_EQ(positions[i], i) << "Probe has false negatives.";
+        }
+        for (size_t i = 1; i < n_matches; i++) {
+            ASSERT_LT(positions[i - 1], positions[i]) << "Probe positions are not ordered.";
+        }
+
+        size_t n_bitmap_matches = filter->probe_bitmap(this->data + offset, length, bitmap.data());
+        ASSERT_EQ(n_bitmap_matches, n_matches) << "Bitmap probe does not match probe.";
+        size_t n_set_bits = 0;
+        for (size_t i = 0; i < n_matches; i++) {
+            ASSERT_TRUE((bitmap[positions[i] / 64] >> (positions[i] % 64)) & 0b1) << "Bitmap does not match probe.";
+        }
+        for (uint64_t word : bitmap) {
+            n_set_bits += __builtin_popcountll(word);
+        }
+        ASSERT_EQ(n_set_bits, n_matches) << "Bitmap has too many bits set.";
+    }
+
+    // test software prefetching
+    if constexpr (requires(F &f) { f.prefetch_distance; }) {
+        std::cout << "test prefetch" << std::endl;
+        const size_t prefetch_distance = filter->prefetch_distance;
+        filter->prefetch_distance = filters::simd::default_prefetch_distance;
+
+        ASSERT_EQ(filter->count(this->data, this->size), false_positives + this->n)
+                                    << "Prefetching count does not match count.";
+        filter->prefetch_distance = prefetch_distance;
+    }
+
+    // test interleaved lookups
+    if constexpr (requires(F &f, const typename TestFixture::T *values) { f.count_interleaved(values, 0); }) {
+        std::cout << "test interleaved count" << std::endl;
+        size_t n_matches = 0;
+        for (size_t i = 0; i < this->size; i++) {
+            n_matches += filter->contains(this->data[i]);
+        }
+
+        ASSERT_EQ(filter->count_interleaved(this->data, this->size), n_matches)
+                                    << "Interleaved count does not match contains.";
+        ASSERT_EQ(filter->count_interleaved(this->data, this->size, 1), n_matches)
+                                    << "Interleaved count does not match contains.";
+    }
+
+    // test serialization
+    if constexpr (requires(F &f, const std::string &path) {
+        f.save(path);
+        f.load(path);
+    }) {
+        std::cout << "test save and load" << std::endl;
+        const std::string path = ::testing::TempDir() + "filter_test.bin";
+        filter->save(path);
+
+        auto loaded = std::make_unique<F>(this->s, this->n_partitions, this->n_threads, this->n_tasks_per_level);
+        loaded->load(path);
+        std::remove(path.c_str());
+
+        ASSERT_EQ(loaded->size(), filter->size()) << "Loaded filter has a different size.";
+        ASSERT_EQ(loaded->count(this->data, this->n), this->n) << "Loaded filter has false negatives.";
+        ASSERT_EQ(loaded->count(this->data, this->size), false_positives + this->n)
+                                    << "Loaded filter does not match saved filter.";
+    }
+
+    // test streaming construction
+    if constexpr (TypeParam::type == filters::FilterType::Xor) {
+        std::cout << "test builder" << std::endl;
+        auto built = std::make_unique<F>(this->s, this->n_partitions, this->n_threads, this->n_tasks_per_level);
+        filters::nxor::XorBuilder<F> builder(*built, ::testing::TempDir());
+
+        const size_t chunk_size = this->n / 3 + 1;
+        for (size_t begin = 0; begin < this->n; begin += chunk_size) {
+            builder.add(this->data + begin, std::min(chunk_size, this->n - begin));
+        }
+        ASSERT_TRUE(builder.finish()) << "Building filter has failed.";
+
+        ASSERT_EQ(built->count(this->data, this->n), this->n) << "Built filter has false negatives.";
+        ASSERT_EQ(built->count(this->data, this->size), false_positives + this->n)
+                                    << "Built filter does not match constructed filter.";
+    }
+
     if constexpr (F::supports_add) {
         std::cout << "test add" << std::endl;
         filter->init(partitions.histogram);
@@ -156,6 +255,60 @@ TYPED_TEST_P(FilterTest, ConstructAndCount) {
     double false_positive_rate = static_cast<double>(false_positives) / static_cast<double>(this->size - this->n);
     std::cout << "#false positives: " << false_positives << std::endl;
     std::cout << std::setprecision(10) << "false positive rate: " << false_positive_rate << std::endl;
+
+    if constexpr (requires(const F &f, typename F::BitFilter &bits) { f.export_bits(bits); }) {
+        std::cout << "test export" << std::endl;
+        auto bits = std::make_unique<typename F::BitFilter>(this->s, this->n_partitions, this->n_threads,
+                this->n_tasks_per_level);
+        filter->export_bits(*bits);
+
+        ASSERT_EQ(bits->count(this->data, this->size), false_positives + this->n)
+                                    << "Exported filter does not match filter.";
+    }
+
+    if constexpr (requires { requires F::supports_remove; }) {
+        std::cout << "test remove" << std::endl;
+        const size_t half = this->n / 2;
+        ASSERT_EQ(filter->remove_all(this->data, half), half) << "Removing keys has failed.";
+
+        size_t false_negatives = 0;
+        for (size_t i = half; i < this->n; i++) {
+            false_negatives += filter->contains(this->data[i]);
+        }
+        ASSERT_EQ(false_negatives, this->n - half) << "Filter has false negatives after removing other keys.";
+
+        if constexpr (F::supports_add) {
+            bool success = true;
+            for (size_t i = half; i < this->n; i++) {
+                success &= filter->remove(this->data[i]);
+            }
+            ASSERT_TRUE(success) << "Removing keys has failed.";
+        } else {
+            ASSERT_EQ(filter->remove_all(this->data + half, this->n - half), this->n - half)
+                                        << "Removing keys has failed.";
+        }
+        ASSERT_EQ(filter->count(this->data, this->size), 0) << "Filter is not empty after removing all keys.";
+    }
+
+    if constexpr (requires { requires F::supports_failsafe_add; }) {
+        std::cout << "test add beyond capacity" << std::endl;
+        filter->init(partitions.histogram);
+
+        // up to twice the planned number of keys, adds start to fail but must not drop keys that were accepted before
+        constexpr size_t max_rejected = 100;
+        std::vector<bool> accepted(2 * this->n);
+        size_t n_added = 0, n_rejected = 0;
+        for (; n_added < 2 * this->n and n_rejected < max_rejected; n_added++) {
+            accepted[n_added] = filter->add(this->data[n_added]);
+            n_rejected += not accepted[n_added];
+        }
+
+        size_t false_negatives = 0;
+        for (size_t i = 0; i < n_added; i++) {
+            false_negatives += accepted[i] and not filter->contains(this->data[i]);
+        }
+        ASSERT_EQ(false_negatives, 0) << "Rejected adds have dropped accepted keys.";
+    }
 }
 
 REGISTER_TYPED_TEST_CASE_P(FilterTest, ConstructAndCount);
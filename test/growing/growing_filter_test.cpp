@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+#include "growing_filter_test.hpp"
+
+namespace test::growing {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(GrowingTestTypes, GrowingFilterTest, GrowingTestTypes);
+
+    /*
+     * a random walk cuckoo filter drops its last victim if an add fails, so it must not be chained
+     */
+    TEST(GrowingFilterConstraintTest, RejectsFiltersThatDropKeysOnFailure) {
+        using RandomWalk = filters::Filter<filters::FilterType::Cuckoo, cuckoo::Standard4<12>, 12,
+                parameter::PowerOfTwoMurmurScalar64>;
+        using BFS = filters::Filter<filters::FilterType::Cuckoo, cuckoo::Standard4BFS<12>, 12,
+                parameter::PowerOfTwoMurmurScalar64>;
+        using Xor = filters::Filter<filters::FilterType::Xor, filters::nxor::BinaryFuse3<8>, 8,
+                parameter::PowerOfTwoMurmurScalar64>;
+
+        EXPECT_TRUE(RandomWalk::supports_add);
+        EXPECT_FALSE(filters::growing::FailsafeAdd<RandomWalk>);
+        EXPECT_TRUE(filters::growing::FailsafeAdd<BFS>);
+        EXPECT_FALSE(filters::growing::FailsafeAdd<Xor>);
+    }
+
+}
+
+MAIN();
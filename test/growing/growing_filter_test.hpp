@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <bloom/bloom_parameter.hpp>
+#include <cuckoo/cuckoo_parameter.hpp>
+#include "../growing_filter_test.hpp"
+
+namespace test::growing {
+
+    namespace parameter = filters::parameter;
+    namespace bloom = filters::bloom;
+    namespace cuckoo = filters::cuckoo;
+
+    static constexpr size_t n_s = 1000, n_l = 1000000;
+
+    static constexpr size_t n_partitions_l = 16;
+
+    /*
+     * a first stage of n / 16 keys and a growth of 2 add up to 5 stages
+     */
+
+    using GrowingTestTypes = ::testing::Types<
+            GrowingTestConfig<filters::FilterType::Bloom, bloom::Blocked512, 8, parameter::PowerOfTwoMurmurScalar64,
+                    n_l, 144, 0, 5, 27198>,
+            GrowingTestConfig<filters::FilterType::Bloom, bloom::Blocked512, 8,
+                    parameter::MagicMurmurScalar32Partitioned, n_l, 144, n_partitions_l, 5, 112479>,
+            GrowingTestConfig<filters::FilterType::Bloom, bloom::Sectorized256Vertical, 8,
+                    parameter::LemireMurmurAVX232Partitioned, n_l, 144, n_partitions_l, 5, 148597>,
+            GrowingTestConfig<filters::FilterType::Cuckoo, cuckoo::Standard4BFS, 12, parameter::LemireMurmurScalar64,
+                    n_l, 105, 0, 5, 66173>,
+            GrowingTestConfig<filters::FilterType::Cuckoo, cuckoo::Standard2BFS, 8, parameter::MagicMurmurScalar32, n_s,
+                    105, 0, 5, 538>>;
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <filter.hpp>
+#include "tester.hpp"
+
+/**
+ * GrowingTestConfig, the first stage has a capacity of n / 16 keys, hence the chain has to grow several times
+ */
+template<filters::FilterType _type, template<size_t> typename FP, size_t _k, typename OP, size_t _n, size_t _s,
+        size_t _n_partitions, size_t _expected_stages, int64_t _expected_fp>
+struct GrowingTestConfig {
+    static constexpr filters::FilterType type = _type;
+    using FilterParameter = FP<_k>;
+    static constexpr size_t k = _k;
+    using OptimizationParameter = OP;
+    static constexpr size_t n = _n;
+    static constexpr size_t s = _s;
+    static constexpr size_t n_partitions = _n_partitions;
+    static constexpr size_t capacity = _n / 16;
+    static constexpr size_t expected_stages = _expected_stages;
+    static constexpr int64_t expected_fp = _expected_fp;
+
+    static_assert(n <= max_n, "n is too large!");
+};
+
+/**
+ * Test
+ * @tparam TypeParam
+ */
+template<typename TypeParam>
+class GrowingFilterTest : public ::testing::Test {
+
+  public:
+    using Vector = filters::simd::Vector<TypeParam::OptimizationParameter::registerSize,
+            TypeParam::OptimizationParameter::simd>;
+    using T = typename Vector::T;
+
+    T *data;
+    size_t size = 11 * TypeParam::n;
+
+    void SetUp() override {
+        data = environment->template get_data<T>();
+    }
+
+};
+
+TYPED_TEST_CASE_P(GrowingFilterTest);
+
+TYPED_TEST_P(GrowingFilterTest, AddAndCount) {
+    using F = filters::Filter<TypeParam::type, typename TypeParam::FilterParameter, TypeParam::k,
+            typename TypeParam::OptimizationParameter>;
+    using GF = filters::growing::GrowingFilter<F>;
+
+    auto filter = std::make_unique<GF>(TypeParam::s, TypeParam::n_partitions, 0, 0, TypeParam::capacity);
+
+    bool success = true;
+    for (size_t i = 0; i < TypeParam::n; i++) {
+        success &= filter->add(this->data[i]);
+    }
+    std::cout << filter->to_string() << std::endl;
+    ASSERT_TRUE(success) << "Adding keys has failed.";
+    ASSERT_EQ(filter->n_keys(), TypeParam::n) << "Filter has lost keys.";
+    ASSERT_EQ(filter->n_stages(), TypeParam::expected_stages) << "Filter has not grown as expected.";
+
+    ASSERT_EQ(filter->count(this->data, TypeParam::n), TypeParam::n) << "Filter has false negatives.";
+
+    size_t n_matches = 0;
+    for (size_t i = 0; i < this->size; i++) {
+        n_matches += filter->contains(this->data[i]);
+    }
+    ASSERT_EQ(filter->count(this->data, this->size), n_matches) << "Count does not match contains.";
+
+    const size_t false_positives = n_matches - TypeParam::n;
+    std::cout << "#false positives: " << false_positives << std::endl;
+    if (TypeParam::expected_fp >= 0) {
+        ASSERT_EQ(false_positives, TypeParam::expected_fp) << "Number of false positive is not equal.";
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(GrowingFilterTest, AddAndCount);
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include "filter_handle_test.hpp"
+
+namespace test::handle {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(FilterHandleTestTypes, FilterHandleTest, FilterHandleTestTypes);
+
+    TEST(FilterCatalogueTest, SelectsNarrowerSimd) {
+        filters::FilterConfig config{filters::FilterType::Bloom, catalogue::Blocked512::name, 8, 144};
+
+        config.simd = parameter::SIMD::AVX2;
+        filters::FilterHandle<Catalogue::T> avx2(Catalogue::module(), config);
+        ASSERT_EQ(avx2.simd(), parameter::SIMD::AVX2);
+
+        config.simd = parameter::SIMD::AVX512;
+        filters::FilterHandle<Catalogue::T> widest(Catalogue::module(), config);
+        ASSERT_EQ(widest.simd(), std::min(filters::simd::cpu_simd(), filters::simd::compiled_simd));
+    }
+
+    TEST(FilterCatalogueTest, RejectsUnknownFilter) {
+        filters::FilterConfig config{filters::FilterType::Bloom, catalogue::Blocked512::name, 5, 144};
+        ASSERT_THROW(filters::FilterHandle<Catalogue::T>(Catalogue::module(), config), std::runtime_error);
+
+        config = {filters::FilterType::Cuckoo, catalogue::Blocked512::name, 8, 144};
+        ASSERT_THROW(filters::FilterHandle<Catalogue::T>(Catalogue::module(), config), std::runtime_error);
+
+        config = {filters::FilterType::Cuckoo, catalogue::Standard4::name, 8, 105};
+        config.deduplication = parameter::Deduplication::Enabled;
+        ASSERT_THROW(filters::FilterHandle<Catalogue::T>(Catalogue::module(), config), std::runtime_error);
+    }
+
+}
+
+MAIN();
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <filter_catalogue.hpp>
+#include "../filter_handle_test.hpp"
+
+namespace test::handle {
+
+    namespace parameter = filters::parameter;
+    namespace catalogue = filters::catalogue;
+
+    using Catalogue = filters::DefaultCatalogue<parameter::RegisterSize::_32bit>;
+    // ribbon filters need 64-bit registers
+    using RibbonCatalogue = filters::FilterCatalogue<parameter::RegisterSize::_64bit, parameter::AddressingMode::Lemire,
+            parameter::HashingMode::Murmur, catalogue::Standard64>;
+
+    static constexpr size_t n_s = 1000, n_l = 1000000;
+
+    static constexpr size_t n_partitions_l = 16;
+
+    template<typename Variant, size_t k, parameter::SIMD simd, size_t s, int64_t expected_fp> using HandleSmall =
+            FilterHandleTestConfig<Catalogue, Variant, k, simd, n_s, s, 0, 0, 0, expected_fp>;
+    template<typename Variant, size_t k, parameter::SIMD simd, size_t s, int64_t expected_fp> using HandleLarge =
+            FilterHandleTestConfig<Catalogue, Variant, k, simd, n_l, s, 0, 0, 0, expected_fp>;
+    template<typename Variant, size_t k, parameter::SIMD simd, size_t s, int64_t expected_fp> using HandleLargeMT =
+            FilterHandleTestConfig<Catalogue, Variant, k, simd, n_l, s, 0, 4, 16, expected_fp>;
+    template<typename Variant, size_t k, parameter::SIMD simd, size_t s, int64_t expected_fp> using
+            HandleLargePartitioned = FilterHandleTestConfig<Catalogue, Variant, k, simd, n_l, s, n_partitions_l, 0, 0,
+            expected_fp>;
+    template<typename Variant, size_t k, parameter::SIMD simd, size_t s, int64_t expected_fp> using
+            HandleLargePartitionedMT = FilterHandleTestConfig<Catalogue, Variant, k, simd, n_l, s, n_partitions_l, 4,
+            16, expected_fp>;
+    template<typename Variant, size_t k, parameter::SIMD simd, size_t s, int64_t expected_fp> using
+            HandleLargeHashed = FilterHandleTestConfig<Catalogue, Variant, k, simd, n_l, s, n_partitions_l, 0, 0,
+            expected_fp, parameter::Partitioning::Hashed>;
+    template<typename Variant, size_t k, parameter::SIMD simd, size_t s, int64_t expected_fp> using
+            HandleLargeHashedMTDedup = FilterHandleTestConfig<Catalogue, Variant, k, simd, n_l, s, n_partitions_l, 4,
+            16, expected_fp, parameter::Partitioning::Hashed, parameter::Deduplication::Enabled>;
+    template<typename Variant, size_t k, parameter::SIMD simd, size_t s, int64_t expected_fp> using
+            HandleRibbonHashedMTDedup = FilterHandleTestConfig<RibbonCatalogue, Variant, k, simd, n_l, s,
+            n_partitions_l, 4, 16, expected_fp, parameter::Partitioning::Hashed, parameter::Deduplication::Enabled>;
+
+    using FilterHandleTestTypes = ::testing::Types<
+            HandleSmall<catalogue::Blocked512, 8, parameter::SIMD::Scalar, 144, 47>,
+            HandleLarge<catalogue::Blocked512, 4, parameter::SIMD::AVX2, 144, 644999>,
+            HandleLargePartitionedMT<catalogue::Blocked512, 6, parameter::SIMD::AVX512, 144, 174258>,
+            HandleLargePartitioned<catalogue::Standard4, 4, parameter::SIMD::AVX2, 130, 3465638>,
+            HandleLargeMT<catalogue::Standard4, 8, parameter::SIMD::AVX512, 105, 293223>,
+            HandleLargePartitionedMT<catalogue::BinaryFuse3, 8, parameter::SIMD::Scalar, 125, 39523>,
+            HandleLarge<catalogue::BinaryFuse3, 16, parameter::SIMD::AVX512, 115, 155>,
+            HandleLargeHashedMTDedup<catalogue::BinaryFuse3, 8, parameter::SIMD::AVX2, 125, 38921>,
+            HandleLargeHashed<catalogue::Standard4BFS, 8, parameter::SIMD::AVX512, 105, 296153>,
+            HandleLargePartitioned<catalogue::BinaryFuse3Stash, 8, parameter::SIMD::AVX2, 105, 38920>,
+            HandleRibbonHashedMTDedup<catalogue::Standard64, 8, parameter::SIMD::Scalar, 110, 38705>,
+            HandleLargeMT<catalogue::VQFStandard, 8, parameter::SIMD::AVX2, 110, 42539>,
+            HandleLargeHashed<catalogue::PrefixStandard, 8, parameter::SIMD::AVX512, 105, 27358>>;
+
+}
@@ -0,0 +1,10 @@
+#include <gtest/gtest.h>
+#include "hash_test.hpp"
+
+namespace test::hash {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(HashTestTypes, HasherTest, HashTestTypes);
+
+}
+
+MAIN();
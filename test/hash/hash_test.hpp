@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include "../hasher_test.hpp"
+
+namespace test::hash {
+
+    using HashingMode = filters::parameter::HashingMode;
+    using RegisterSize = filters::parameter::RegisterSize;
+
+    using HashTestTypes = ::testing::Types<HasherTestConfig<HashingMode::Murmur, RegisterSize::_32bit>,
+            HasherTestConfig<HashingMode::Murmur, RegisterSize::_64bit>,
+            HasherTestConfig<HashingMode::Fasthash, RegisterSize::_32bit>,
+            HasherTestConfig<HashingMode::Fasthash, RegisterSize::_64bit>,
+            HasherTestConfig<HashingMode::SimpleTabulation, RegisterSize::_32bit>,
+            HasherTestConfig<HashingMode::SimpleTabulation, RegisterSize::_64bit>,
+            HasherTestConfig<HashingMode::XXHash, RegisterSize::_32bit>,
+            HasherTestConfig<HashingMode::XXHash, RegisterSize::_64bit>>;
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <filter.hpp>
+#include "tester.hpp"
+
+template<filters::parameter::HashingMode _hashingMode, filters::parameter::RegisterSize _registerSize>
+struct HasherTestConfig {
+    static constexpr filters::parameter::HashingMode hashingMode = _hashingMode;
+    static constexpr filters::parameter::RegisterSize registerSize = _registerSize;
+};
+
+/**
+ * Test
+ * @tparam TypeParam
+ */
+template<typename TypeParam>
+class HasherTest : public ::testing::Test {
+
+  public:
+
+    void SetUp() override {
+    }
+
+    void TearDown() override {
+    }
+
+};
+
+TYPED_TEST_CASE_P(HasherTest);
+
+/**
+ * every lane of an AVX2 or AVX-512 hasher has to hash like the scalar hasher
+ */
+TYPED_TEST_P(HasherTest, VectorsMatchScalar) {
+    using SV = filters::simd::Vector<TypeParam::registerSize, filters::parameter::SIMD::Scalar>;
+    using V2 = filters::simd::Vector<TypeParam::registerSize, filters::parameter::SIMD::AVX2>;
+    using V512 = filters::simd::Vector<TypeParam::registerSize, filters::parameter::SIMD::AVX512>;
+    using SH = filters::hash::Hasher<TypeParam::hashingMode, SV, 0>;
+    using H2 = filters::hash::Hasher<TypeParam::hashingMode, V2, 0>;
+    using H512 = filters::hash::Hasher<TypeParam::hashingMode, V512, 0>;
+    using T = typename SV::T;
+
+    std::mt19937_64 gen(42);
+    alignas(64) T values[V512::n_elements];
+
+    for (size_t i = 0; i < 100000; i++) {
+        for (T &value : values) {
+            value = gen();
+        }
+
+        const V2 hash2 = H2::hash(V2::load(values));
+        const V512 hash512 = H512::hash(V512::load(values));
+        const V2 rehash2 = H2::template rehash<1>(hash2, V2::load(values));
+        const V512 rehash512 = H512::template rehash<1>(hash512, V512::load(values));
+
+        for (size_t j = 0; j < V512::n_elements; j++) {
+            const SV hash = SH::hash(SV(values[j]));
+            const SV rehash = SH::template rehash<1>(hash, SV(values[j]));
+            ASSERT_EQ(hash512.elements[j], hash.vector) << "AVX-512 hash differs from scalar hash.";
+            ASSERT_EQ(rehash512.elements[j], rehash.vector) << "AVX-512 rehash differs from scalar rehash.";
+            if (j < V2::n_elements) {
+                ASSERT_EQ(hash2.elements[j], hash.vector) << "AVX2 hash differs from scalar hash.";
+                ASSERT_EQ(rehash2.elements[j], rehash.vector) << "AVX2 rehash differs from scalar rehash.";
+            }
+        }
+    }
+}
+
+/**
+ * sequential keys have to be spread evenly over the buckets selected by the high (and low) hash bits
+ */
+TYPED_TEST_P(HasherTest, SequentialKeysAreUniform) {
+    using SV = filters::simd::Vector<TypeParam::registerSize, filters::parameter::SIMD::Scalar>;
+    using SH = filters::hash::Hasher<TypeParam::hashingMode, SV, 0>;
+    using T = typename SV::T;
+
+    static constexpr size_t n_bits = 8;
+    static constexpr size_t n_buckets = 1ull << n_bits;
+    static constexpr size_t n_keys = n_buckets * 4096;
+
+    std::vector<size_t> high(n_buckets, 0), low(n_buckets, 0);
+    for (size_t i = 0; i < n_keys; i++) {
+        const T hash = SH::hash(SV(static_cast<T>(i))).vector;
+        high[hash >> (sizeof(T) * 8 - n_bits)]++;
+        low[hash & (n_buckets - 1)]++;
+    }
+
+    // 4096 expected keys per bucket, a deviation of 10% is more than 6 standard deviations
+    for (size_t i = 0; i < n_buckets; i++) {
+        ASSERT_NEAR(high[i], n_keys / n_buckets, n_keys / n_buckets / 10) << "High hash bits are skewed.";
+        ASSERT_NEAR(low[i], n_keys / n_buckets, n_keys / n_buckets / 10) << "Low hash bits are skewed.";
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(HasherTest, VectorsMatchScalar, SequentialKeysAreUniform);
@@ -13,6 +13,8 @@ namespace test::morton {
 
     INSTANTIATE_TYPED_TEST_CASE_P(CuckooMorton3_25TestTypes, FilterTest, CuckooMorton3_25TestTypes);
 
+    INSTANTIATE_TYPED_TEST_CASE_P(CuckooMortonBFSTestTypes, FilterTest, CuckooMortonBFSTestTypes);
+
 }
 
 MAIN();
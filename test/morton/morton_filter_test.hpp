@@ -71,7 +71,7 @@ namespace test::morton {
             MortonAVXSmall1<cuckoo::Morton2_30_0, 142, 42>, MortonAVXSmall2<cuckoo::Morton2_30_0, 100, 1>,
             MortonScalarLarge1<cuckoo::Morton2_30_0, 123, 262>, MortonScalarLarge2<cuckoo::Morton2_30_0, 184, 721935>,
             MortonScalarLarge3<cuckoo::Morton2_30_0, 156, 184349>, MortonScalarLarge4<cuckoo::Morton2_30_0, 126, 1418>,
-            MortonScalarLarge5<cuckoo::Morton2_30_0, 124, 531>, MortonAVX2Large1<cuckoo::Morton2_30_0, 124, 152>,
+            MortonScalarLarge5<cuckoo::Morton2_30_0, 124, 211>, MortonAVX2Large1<cuckoo::Morton2_30_0, 124, 152>,
             MortonAVX2Large2<cuckoo::Morton2_30_0, 168, 365282>, MortonAVX2Large3<cuckoo::Morton2_30_0, 400, 1811828>,
             MortonAVX2Large4<cuckoo::Morton2_30_0, 142, 21297>, MortonAVX512Large1<cuckoo::Morton2_30_0, 142, 36983>,
             MortonAVX512Large2<cuckoo::Morton2_30_0, 133, 5804>, MortonAVX512Large3<cuckoo::Morton2_30_0, 143, 46606>,
@@ -123,4 +123,9 @@ namespace test::morton {
             MortonAVX2Large4<cuckoo::Morton3_25_0, 130, 26812>, MortonAVX512Large1<cuckoo::Morton3_25_0, 134, 36983>,
             MortonAVX512Large2<cuckoo::Morton3_25_0, 126, 7278>, MortonAVX512Large3<cuckoo::Morton3_25_0, 134, 58174>,
             MortonAVX512Large4<cuckoo::Morton3_25_0, 123, 3368>>;
+
+    using CuckooMortonBFSTestTypes = ::testing::Types<MortonScalarSmall3<cuckoo::MortonOptBFS, 145, 41>,
+            MortonScalarLarge1<cuckoo::MortonOptBFS, 112, 299>, MortonScalarLarge5<cuckoo::MortonOptBFS, 112, 349>,
+            MortonAVX512Large3<cuckoo::MortonOptBFS, 140, 38197>, MortonAVX2Large2<cuckoo::MortonOptBFS, 142, 488372>>;
+
 }
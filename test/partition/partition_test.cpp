@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include "partition_test.hpp"
+
+namespace test::partition {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(PartitionHashedTestTypes, FilterTest, PartitionHashedTestTypes);
+    INSTANTIATE_TYPED_TEST_CASE_P(PartitionDedupTestTypes, FilterTest, PartitionDedupTestTypes);
+
+    TEST(PartitionerTest, HashedBalancesStridedKeys) {
+        static constexpr size_t n_keys = 1 << 20, n_partitions = 64, zero_bits = 8;
+
+        ASSERT_EQ((largest_partition<parameter::Partitioning::Enabled, parameter::RegisterSize::_64bit>(n_keys,
+                n_partitions, zero_bits)), n_keys) << "Strided keys are expected to share a partition.";
+
+        // expected are 16384 keys per partition
+        ASSERT_LT((largest_partition<parameter::Partitioning::Hashed, parameter::RegisterSize::_64bit>(n_keys,
+                n_partitions, zero_bits)), n_keys / n_partitions * 11 / 10) << "Hashed partitions are unbalanced.";
+        ASSERT_LT((largest_partition<parameter::Partitioning::Hashed, parameter::RegisterSize::_32bit>(n_keys,
+                n_partitions, zero_bits)), n_keys / n_partitions * 11 / 10) << "Hashed partitions are unbalanced.";
+    }
+
+    TEST(PartitionerTest, DeduplicationBuildsFromDuplicates) {
+        static constexpr size_t n_keys = 100000, n_copies = 16;
+
+        construct_duplicates<filters::FilterType::Cuckoo, cuckoo::Standard4<12>, 12,
+                parameter::LemireMurmurScalar64Dedup>(n_keys, n_copies, 105, 1, 0, 0);
+        construct_duplicates<filters::FilterType::Cuckoo, cuckoo::Standard4<12>, 12,
+                parameter::PowerOfTwoMurmurAVX51264PartitionedDedup>(n_keys, n_copies, 105, n_partitions_l, 0, 0);
+        construct_duplicates<filters::FilterType::Xor, nxor::BinaryFuse3<8>, 8, parameter::LemireMurmurScalar64Dedup>(
+                n_keys, n_copies, 115, 1, 0, 0);
+        construct_duplicates<filters::FilterType::Xor, nxor::Standard<8>, 8,
+                parameter::PowerOfTwoMurmurAVX232HashedMTDedup>(n_keys, n_copies, 125, n_partitions_l, 4, 16);
+    }
+
+}
+
+MAIN();
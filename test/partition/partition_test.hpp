@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <bloom/bloom_parameter.hpp>
+#include <xor/xor_parameter.hpp>
+#include <cuckoo/cuckoo_parameter.hpp>
+#include <prefix/prefix_parameter.hpp>
+#include "../filter_test.hpp"
+
+namespace test::partition {
+
+    namespace parameter = filters::parameter;
+    namespace bloom = filters::bloom;
+    namespace nxor = filters::nxor;
+    namespace cuckoo = filters::cuckoo;
+    namespace prefix = filters::prefix;
+
+    static constexpr size_t n_s = 1000, n_l = 1000000;
+
+    static constexpr size_t n_partitions_s = 2, n_partitions_l = 16;
+
+    /*
+     * Hashed Partitioning Test Types
+     */
+
+    using PartitionHashedTestTypes = ::testing::Types<
+            FilterTestConfig<filters::FilterType::Bloom, bloom::Blocked512, 16, parameter::LemireMurmurScalar64Hashed,
+                    n_l, 150, n_partitions_l, 0, 0, 664>,
+            FilterTestConfig<filters::FilterType::Xor, nxor::Standard, 8, parameter::PowerOfTwoMurmurAVX232HashedMT,
+                    n_l, 125, n_partitions_l, 4, 16, 40626>,
+            FilterTestConfig<filters::FilterType::Xor, nxor::BinaryFuse4, 7, parameter::LemireMurmurAVX232HashedMT, n_s,
+                    500, n_partitions_s, 2, 2, 83>,
+            FilterTestConfig<filters::FilterType::Cuckoo, cuckoo::Standard4, 12,
+                    parameter::PowerOfTwoMurmurAVX51264Hashed, n_l, 105, n_partitions_l, 0, 0, 10858>,
+            FilterTestConfig<filters::FilterType::Prefix, prefix::Standard, 8, parameter::LemireMurmurScalar32HashedMT,
+                    n_l, 105, n_partitions_l, 4, 16, 27410>>;
+
+    /*
+     * Deduplication Test Types
+     */
+
+    using PartitionDedupTestTypes = ::testing::Types<
+            FilterTestConfig<filters::FilterType::Bloom, bloom::Blocked512, 16, parameter::LemireMurmurScalar64Dedup,
+                    n_l, 150, n_partitions_l, 0, 0, 646>,
+            FilterTestConfig<filters::FilterType::Xor, nxor::Standard, 8, parameter::PowerOfTwoMurmurAVX232HashedMTDedup,
+                    n_l, 125, n_partitions_l, 4, 16, 40626>,
+            FilterTestConfig<filters::FilterType::Cuckoo, cuckoo::Standard4, 12,
+                    parameter::PowerOfTwoMurmurAVX51264PartitionedDedup, n_l, 105, n_partitions_l, 0, 0, 13446>,
+            FilterTestConfig<filters::FilterType::Prefix, prefix::Standard, 8,
+                    parameter::LemireMurmurAVX51264PartitionedDedup, n_l, 105, n_partitions_l, 0, 0, 27479>>;
+
+    /**
+     * builds a filter from keys that occur n_copies times each, without deduplication neither cuckoo nor xor filters
+     * can store more than a few copies of a key
+     */
+    template<filters::FilterType type, typename FP, size_t k, typename OP>
+    void construct_duplicates(const size_t n_keys, const size_t n_copies, const size_t s, const size_t n_partitions,
+                              const size_t n_threads, const size_t n_tasks_per_level) {
+        using F = filters::Filter<type, FP, k, OP>;
+        using Vector = typename F::Vector;
+        using T = typename Vector::T;
+
+        const size_t length = n_keys * n_copies;
+        T *keys = filters::simd::valloc<Vector>(filters::simd::valign<Vector>(length * sizeof(T)));
+        for (size_t i = 0; i < length; i++) {
+            // copies of a key are spread over the whole input
+            keys[i] = static_cast<T>((i % n_keys) * 0x9e3779b1);
+        }
+
+        typename F::BuildPartitionSet partitions(n_partitions);
+        if constexpr (OP::multiThreading == parameter::MultiThreading::Enabled) {
+            filters::task::TaskQueue<OP::multiThreading> queue(n_threads, n_tasks_per_level);
+            partitions.init(keys, length, queue);
+            queue.execute_tasks();
+        } else {
+            partitions.init(keys, length);
+        }
+
+        size_t n_distinct = 0;
+        for (size_t partition = 0; partition < partitions.n_partitions; partition++) {
+            const T *begin = partitions.values + partitions.offsets[partition];
+            const T *end = begin + partitions.histogram[partition];
+            ASSERT_TRUE(std::adjacent_find(begin, end) == end) << "Partition contains duplicates.";
+            n_distinct += partitions.histogram[partition];
+        }
+        ASSERT_EQ(n_distinct, n_keys) << "Deduplication has dropped distinct keys.";
+
+        auto filter = std::make_unique<F>(s, n_partitions, n_threads, n_tasks_per_level);
+        ASSERT_TRUE(filter->construct(keys, length)) << "Building filter has failed.";
+        ASSERT_EQ(filter->count(keys, length), length) << "Filter has false negatives.";
+
+        free(keys);
+    }
+
+    /**
+     * keys with the low bits cleared end up in a single partition of low bit partitioning, hashed partitioning has to
+     * spread them over all partitions
+     */
+    template<parameter::Partitioning partitioning, parameter::RegisterSize registerSize>
+    size_t largest_partition(const size_t n_keys, const size_t n_partitions, const size_t zero_bits) {
+        using Vector = filters::simd::Vector<registerSize, parameter::SIMD::Scalar>;
+        using T = typename Vector::T;
+
+        T *keys = new T[n_keys];
+        for (size_t i = 0; i < n_keys; i++) {
+            keys[i] = static_cast<T>(i << zero_bits);
+        }
+
+        filters::partition::PartitionSet<partitioning, Vector> partitions(n_partitions);
+        partitions.init(keys, n_keys);
+
+        size_t largest = 0;
+        for (size_t partition = 0; partition < n_partitions; partition++) {
+            largest = std::max<size_t>(largest, partitions.histogram[partition]);
+            for (size_t i = 0; i < partitions.histogram[partition]; i++) {
+                const T key = partitions.values[partitions.offsets[partition] + i];
+                EXPECT_EQ(filters::partition::partition_of<partitioning>(key, n_partitions), partition)
+                                    << "Key is not in its partition.";
+            }
+        }
+
+        delete[](keys);
+        return largest;
+    }
+
+}
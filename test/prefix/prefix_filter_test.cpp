@@ -0,0 +1,12 @@
+#include <gtest/gtest.h>
+#include "prefix_filter_test.hpp"
+
+namespace test::prefix {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(PrefixStandardTestTypes, FilterTest, PrefixStandardTestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(PrefixCompactTestTypes, FilterTest, PrefixCompactTestTypes);
+
+}
+
+MAIN();
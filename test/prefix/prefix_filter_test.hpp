@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <prefix/prefix_parameter.hpp>
+#include "../filter_test.hpp"
+
+namespace test::prefix {
+
+    namespace parameter = filters::parameter;
+    namespace prefix = filters::prefix;
+
+    static constexpr size_t n_s = 1000, n_l = 1000000;
+
+    static constexpr size_t n_partition_s = 2, n_partition_l = 16;
+
+    // bins hold 8 or 16-bit fingerprints only
+    static constexpr filters::FilterType Prefix = filters::FilterType::Prefix;
+
+    /*
+     * Small Test Types
+     */
+
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixScalarSmall1 = FilterTestConfig<
+            Prefix, FP, 8, parameter::MagicMurmurScalar32MT, n_s, s, 0, 2, 2, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixScalarSmall2 = FilterTestConfig<
+            Prefix, FP, 16, parameter::LemireMurmurScalar64Partitioned, n_s, s, n_partition_s, 0, 0, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixAVXSmall1 = FilterTestConfig<
+            Prefix, FP, 8, parameter::LemireMurmurAVX232Partitioned, n_s, s, n_partition_s, 0, 0, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixAVXSmall2 = FilterTestConfig<
+            Prefix, FP, 16, parameter::PowerOfTwoMurmurAVX51264Partitioned, n_s, s, n_partition_l, 0, 0, expected_fp>;
+
+    /*
+     * Large Test Types
+     */
+
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixScalarLarge1 = FilterTestConfig<
+            Prefix, FP, 16, parameter::PowerOfTwoMurmurScalar64, n_l, s, 0, 0, 0, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixScalarLarge2 = FilterTestConfig<
+            Prefix, FP, 8, parameter::MagicMurmurScalar32Partitioned, n_l, s, n_partition_l, 0, 0, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixScalarLarge3 = FilterTestConfig<
+            Prefix, FP, 8, parameter::LemireMurmurScalar32MT, n_l, s, 0, 4, 16, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixAVX2Large1 = FilterTestConfig<
+            Prefix, FP, 16, parameter::PowerOfTwoMurmurAVX264Partitioned, n_l, s, n_partition_l, 0, 0, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixAVX2Large2 = FilterTestConfig<
+            Prefix, FP, 8, parameter::MagicMurmurAVX232PartitionedMT, n_l, s, n_partition_l, 4, 16, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixAVX2Large3 = FilterTestConfig<
+            Prefix, FP, 16, parameter::LemireMurmurAVX232Partitioned, n_l, s, n_partition_l, 0, 0, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixAVX512Large1 = FilterTestConfig<
+            Prefix, FP, 8, parameter::PowerOfTwoMurmurAVX51232PartitionedMT, n_l, s, n_partition_l, 4, 16, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using PrefixAVX512Large2 = FilterTestConfig<
+            Prefix, FP, 16, parameter::LemireMurmurAVX51264Partitioned, n_l, s, n_partition_l, 0, 0, expected_fp>;
+
+    /*
+     * Variant Test Types
+     */
+
+    using PrefixStandardTestTypes = ::testing::Types<PrefixScalarSmall1<prefix::Standard, 105, 25>,
+            PrefixScalarSmall2<prefix::Standard, 105, 0>, PrefixAVXSmall1<prefix::Standard, 105, 21>,
+            PrefixAVXSmall2<prefix::Standard, 105, 0>, PrefixScalarLarge1<prefix::Standard, 105, 66>,
+            PrefixScalarLarge2<prefix::Standard, 105, 26914>, PrefixScalarLarge3<prefix::Standard, 105, 27610>,
+            PrefixAVX2Large1<prefix::Standard, 105, 71>, PrefixAVX2Large2<prefix::Standard, 105, 26914>,
+            PrefixAVX2Large3<prefix::Standard, 105, 162>, PrefixAVX512Large1<prefix::Standard, 105, 15141>,
+            PrefixAVX512Large2<prefix::Standard, 105, 154>>;
+
+    using PrefixCompactTestTypes = ::testing::Types<PrefixScalarSmall1<prefix::Compact, 105, 26>,
+            PrefixScalarSmall2<prefix::Compact, 105, 0>, PrefixAVXSmall1<prefix::Compact, 105, 25>,
+            PrefixAVXSmall2<prefix::Compact, 105, 0>, PrefixScalarLarge1<prefix::Compact, 105, 66>,
+            PrefixScalarLarge2<prefix::Compact, 105, 28893>, PrefixScalarLarge3<prefix::Compact, 105, 29382>,
+            PrefixAVX2Large1<prefix::Compact, 105, 71>, PrefixAVX2Large2<prefix::Compact, 105, 28893>,
+            PrefixAVX2Large3<prefix::Compact, 105, 177>, PrefixAVX512Large1<prefix::Compact, 105, 15141>,
+            PrefixAVX512Large2<prefix::Compact, 105, 159>>;
+
+}
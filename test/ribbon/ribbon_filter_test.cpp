@@ -0,0 +1,20 @@
+#include <gtest/gtest.h>
+#include "ribbon_filter_test.hpp"
+
+namespace test::ribbon {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonStandard64TestTypes, FilterTest, RibbonStandard64TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonStandard128TestTypes, FilterTest, RibbonStandard128TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonHomogeneous64TestTypes, FilterTest, RibbonHomogeneous64TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonHomogeneous128TestTypes, FilterTest, RibbonHomogeneous128TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonBumped64TestTypes, FilterTest, RibbonBumped64TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonBumped128TestTypes, FilterTest, RibbonBumped128TestTypes);
+
+}
+
+MAIN();
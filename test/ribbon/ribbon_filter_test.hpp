@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <ribbon/ribbon_parameter.hpp>
+#include "../filter_test.hpp"
+
+namespace test::ribbon {
+
+    namespace parameter = filters::parameter;
+    namespace ribbon = filters::ribbon;
+
+    static constexpr size_t n_s = 1000, n_l = 1000000;
+
+    static constexpr size_t n_partition_s = 2, n_partition_l = 16;
+
+    // ribbon filters need 64-bit registers, so there are no 32-bit test types
+    static constexpr filters::FilterType Ribbon = filters::FilterType::Ribbon;
+
+    /*
+     * Small Test Types
+     */
+
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using RibbonScalarSmall =
+            FilterTestConfig<Ribbon, FP, 10, parameter::MagicMurmurScalar64MT, n_s, s, 0, 2, 2, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using RibbonAVXSmall1 =
+            FilterTestConfig<Ribbon, FP, 7, parameter::LemireMurmurAVX264Partitioned, n_s, s, n_partition_s, 0, 0,
+                    expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using RibbonAVXSmall2 =
+            FilterTestConfig<Ribbon, FP, 13, parameter::PowerOfTwoMurmurAVX51264Partitioned, n_s, s, n_partition_l, 0,
+                    0, expected_fp>;
+
+    /*
+     * Large Test Types
+     */
+
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using RibbonScalarLarge1 =
+            FilterTestConfig<Ribbon, FP, 15, parameter::PowerOfTwoMurmurScalar64, n_l, s, 0, 0, 0, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using RibbonScalarLarge2 =
+            FilterTestConfig<Ribbon, FP, 8, parameter::MagicMurmurScalar64, n_l, s, 0, 0, 0, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using RibbonScalarLarge3 =
+            FilterTestConfig<Ribbon, FP, 6, parameter::LemireMurmurScalar64PartitionedMT, n_l, s, n_partition_l, 4, 16,
+                    expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using RibbonAVX2Large1 =
+            FilterTestConfig<Ribbon, FP, 16, parameter::PowerOfTwoMurmurAVX264Partitioned, n_l, s, n_partition_l, 0, 0,
+                    expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using RibbonAVX2Large2 =
+            FilterTestConfig<Ribbon, FP, 5, parameter::MagicMurmurAVX264PartitionedMT, n_l, s, n_partition_l, 4, 16,
+                    expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using RibbonAVX512Large1 =
+            FilterTestConfig<Ribbon, FP, 11, parameter::MagicMurmurAVX51264Partitioned, n_l, s, n_partition_l, 0, 0,
+                    expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using RibbonAVX512Large2 =
+            FilterTestConfig<Ribbon, FP, 20, parameter::LemireMurmurAVX51264PartitionedMT, n_l, s, n_partition_l, 4, 16,
+                    expected_fp>;
+
+
+    /*
+     * Variant Test Types
+     */
+
+    using RibbonStandard64TestTypes = ::testing::Types<RibbonScalarSmall<ribbon::Standard64, 110, 7>,
+            RibbonAVXSmall1<ribbon::Standard64, 110, 87>, RibbonAVXSmall2<ribbon::Standard64, 110, 2>,
+            RibbonScalarLarge1<ribbon::Standard64, 110, 276>, RibbonScalarLarge2<ribbon::Standard64, 110, 39199>,
+            RibbonScalarLarge3<ribbon::Standard64, 110, 155950>, RibbonAVX2Large1<ribbon::Standard64, 110, 144>,
+            RibbonAVX2Large2<ribbon::Standard64, 110, 312312>, RibbonAVX512Large1<ribbon::Standard64, 110, 4863>,
+            RibbonAVX512Large2<ribbon::Standard64, 110, 15>>;
+
+    using RibbonStandard128TestTypes = ::testing::Types<RibbonScalarSmall<ribbon::Standard128, 105, 12>,
+            RibbonAVXSmall1<ribbon::Standard128, 105, 84>, RibbonAVXSmall2<ribbon::Standard128, 105, 2>,
+            RibbonScalarLarge1<ribbon::Standard128, 105, 314>, RibbonScalarLarge2<ribbon::Standard128, 105, 39124>,
+            RibbonScalarLarge3<ribbon::Standard128, 105, 156862>, RibbonAVX2Large1<ribbon::Standard128, 105, 152>,
+            RibbonAVX2Large2<ribbon::Standard128, 105, 312757>, RibbonAVX512Large1<ribbon::Standard128, 105, 4905>,
+            RibbonAVX512Large2<ribbon::Standard128, 105, 13>>;
+
+    using RibbonHomogeneous64TestTypes = ::testing::Types<RibbonScalarSmall<ribbon::Homogeneous64, 110, 13>,
+            RibbonAVXSmall1<ribbon::Homogeneous64, 110, 69>, RibbonAVXSmall2<ribbon::Homogeneous64, 110, 2>,
+            RibbonScalarLarge1<ribbon::Homogeneous64, 110, 277>, RibbonScalarLarge2<ribbon::Homogeneous64, 110, 39311>,
+            RibbonScalarLarge3<ribbon::Homogeneous64, 110, 158627>, RibbonAVX2Large1<ribbon::Homogeneous64, 110, 139>,
+            RibbonAVX2Large2<ribbon::Homogeneous64, 110, 313053>, RibbonAVX512Large1<ribbon::Homogeneous64, 110, 4868>,
+            RibbonAVX512Large2<ribbon::Homogeneous64, 110, 2644>>;
+
+    using RibbonHomogeneous128TestTypes = ::testing::Types<RibbonScalarSmall<ribbon::Homogeneous128, 105, 10>,
+            RibbonAVXSmall1<ribbon::Homogeneous128, 105, 69>, RibbonAVXSmall2<ribbon::Homogeneous128, 105, 3>,
+            RibbonScalarLarge1<ribbon::Homogeneous128, 105, 301>, RibbonScalarLarge2<ribbon::Homogeneous128, 105, 39292>,
+            RibbonScalarLarge3<ribbon::Homogeneous128, 105, 155560>, RibbonAVX2Large1<ribbon::Homogeneous128, 105, 152>,
+            RibbonAVX2Large2<ribbon::Homogeneous128, 105, 313240>, RibbonAVX512Large1<ribbon::Homogeneous128, 105, 4864>,
+            RibbonAVX512Large2<ribbon::Homogeneous128, 105, 10>>;
+
+    using RibbonBumped64TestTypes = ::testing::Types<RibbonScalarSmall<ribbon::Bumped64, 102, 10>,
+            RibbonAVXSmall1<ribbon::Bumped64, 102, 70>, RibbonAVXSmall2<ribbon::Bumped64, 102, 2>,
+            RibbonScalarLarge1<ribbon::Bumped64, 102, 279>, RibbonScalarLarge2<ribbon::Bumped64, 102, 39312>,
+            RibbonScalarLarge3<ribbon::Bumped64, 102, 156031>, RibbonAVX2Large1<ribbon::Bumped64, 102, 156>,
+            RibbonAVX2Large2<ribbon::Bumped64, 102, 312002>, RibbonAVX512Large1<ribbon::Bumped64, 102, 4956>,
+            RibbonAVX512Large2<ribbon::Bumped64, 102, 9>>;
+
+    using RibbonBumped128TestTypes = ::testing::Types<RibbonScalarSmall<ribbon::Bumped128, 101, 9>,
+            RibbonAVXSmall1<ribbon::Bumped128, 101, 78>, RibbonAVXSmall2<ribbon::Bumped128, 101, 2>,
+            RibbonScalarLarge1<ribbon::Bumped128, 101, 303>, RibbonScalarLarge2<ribbon::Bumped128, 101, 39270>,
+            RibbonScalarLarge3<ribbon::Bumped128, 101, 156198>, RibbonAVX2Large1<ribbon::Bumped128, 101, 137>,
+            RibbonAVX2Large2<ribbon::Bumped128, 101, 313224>, RibbonAVX512Large1<ribbon::Bumped128, 101, 4747>,
+            RibbonAVX512Large2<ribbon::Bumped128, 101, 6>>;
+
+}
@@ -6,6 +6,9 @@
 #include "xor/xor_filter_test.hpp"
 #include "xor/xor_filter_pointer_test.hpp"
 #include "cuckoo/cuckoo_filter_test.hpp"
+#include "ribbon/ribbon_filter_test.hpp"
+#include "vqf/vqf_filter_test.hpp"
+#include "prefix/prefix_filter_test.hpp"
 #include "morton/morton_filter_test.hpp"
 #include "morton/morton_ota_filter_test.hpp"
 #include "cuckoo/cuckoo_filter_pointer_test.hpp"
@@ -13,6 +16,10 @@
 #include "vacuumfilter/vacuumfilter_test.hpp"
 #include "amd_mortonfilter/amd_mortonfilter_test.hpp"
 #include "div/div_test.hpp"
+#include "hash/hash_test.hpp"
+#include "partition/partition_test.hpp"
+#include "growing/growing_filter_test.hpp"
+#include "handle/filter_handle_test.hpp"
 
 #ifdef ENABLE_BSD
 
@@ -53,6 +60,8 @@ namespace test::bloom {
 
     INSTANTIATE_TYPED_TEST_CASE_P(BloomSectorized512VerticalTestTypes, FilterTest, BloomSectorized512VerticalTestTypes);
 
+    INSTANTIATE_TYPED_TEST_CASE_P(BloomCounting512TestTypes, FilterTest, BloomCounting512TestTypes);
+
 }
 
 namespace test::bloom::pointer {
@@ -67,6 +76,12 @@ namespace test::nxor {
 
     INSTANTIATE_TYPED_TEST_CASE_P(XorFuseTestTypes, FilterTest, XorFuseTestTypes);
 
+    INSTANTIATE_TYPED_TEST_CASE_P(XorBinaryFuse3TestTypes, FilterTest, XorBinaryFuse3TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(XorBinaryFuse4TestTypes, FilterTest, XorBinaryFuse4TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(XorStashTestTypes, FilterTest, XorStashTestTypes);
+
 }
 
 namespace test::nxor::pointer {
@@ -75,6 +90,38 @@ namespace test::nxor::pointer {
 
 }
 
+namespace test::ribbon {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonStandard64TestTypes, FilterTest, RibbonStandard64TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonStandard128TestTypes, FilterTest, RibbonStandard128TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonHomogeneous64TestTypes, FilterTest, RibbonHomogeneous64TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonHomogeneous128TestTypes, FilterTest, RibbonHomogeneous128TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonBumped64TestTypes, FilterTest, RibbonBumped64TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(RibbonBumped128TestTypes, FilterTest, RibbonBumped128TestTypes);
+
+}
+
+namespace test::vqf {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(VQFStandardTestTypes, FilterTest, VQFStandardTestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(VQFShortcutTestTypes, FilterTest, VQFShortcutTestTypes);
+
+}
+
+namespace test::prefix {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(PrefixStandardTestTypes, FilterTest, PrefixStandardTestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(PrefixCompactTestTypes, FilterTest, PrefixCompactTestTypes);
+
+}
+
 namespace test::cuckoo {
 
     INSTANTIATE_TYPED_TEST_CASE_P(CuckooStandard2TestTypes, FilterTest, CuckooStandard2TestTypes);
@@ -91,6 +138,8 @@ namespace test::cuckoo {
 
     INSTANTIATE_TYPED_TEST_CASE_P(CuckooStandard8TestTypes, FilterTest, CuckooStandard8TestTypes);
 
+    INSTANTIATE_TYPED_TEST_CASE_P(CuckooStandardBFSTestTypes, FilterTest, CuckooStandardBFSTestTypes);
+
 }
 
 namespace test::cuckoo::pointer {
@@ -111,6 +160,8 @@ namespace test::morton {
 
     INSTANTIATE_TYPED_TEST_CASE_P(CuckooMorton3_25TestTypes, FilterTest, CuckooMorton3_25TestTypes);
 
+    INSTANTIATE_TYPED_TEST_CASE_P(CuckooMortonBFSTestTypes, FilterTest, CuckooMortonBFSTestTypes);
+
 }
 
 namespace test::morton_ota {
@@ -233,4 +284,29 @@ namespace test::div {
 
 }
 
+namespace test::hash {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(HashTestTypes, HasherTest, HashTestTypes);
+
+}
+
+namespace test::partition {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(PartitionHashedTestTypes, FilterTest, PartitionHashedTestTypes);
+    INSTANTIATE_TYPED_TEST_CASE_P(PartitionDedupTestTypes, FilterTest, PartitionDedupTestTypes);
+
+}
+
+namespace test::growing {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(GrowingTestTypes, GrowingFilterTest, GrowingTestTypes);
+
+}
+
+namespace test::handle {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(FilterHandleTestTypes, FilterHandleTest, FilterHandleTestTypes);
+
+}
+
 MAIN();
@@ -0,0 +1,12 @@
+#include <gtest/gtest.h>
+#include "vqf_filter_test.hpp"
+
+namespace test::vqf {
+
+    INSTANTIATE_TYPED_TEST_CASE_P(VQFStandardTestTypes, FilterTest, VQFStandardTestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(VQFShortcutTestTypes, FilterTest, VQFShortcutTestTypes);
+
+}
+
+MAIN();
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <vqf/vqf_parameter.hpp>
+#include "../filter_test.hpp"
+
+namespace test::vqf {
+
+    namespace parameter = filters::parameter;
+    namespace vqf = filters::vqf;
+
+    static constexpr size_t n_s = 1000, n_l = 1000000;
+
+    static constexpr size_t n_partition_s = 2, n_partition_l = 16;
+
+    // blocks hold 8 or 16-bit fingerprints only
+    static constexpr filters::FilterType VectorQuotient = filters::FilterType::VectorQuotient;
+
+    /*
+     * Small Test Types
+     */
+
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using VQFScalarSmall1 = FilterTestConfig<
+            VectorQuotient, FP, 8, parameter::MagicMurmurScalar32MT, n_s, s, 0, 2, 2, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using VQFScalarSmall2 = FilterTestConfig<
+            VectorQuotient, FP, 16, parameter::LemireMurmurScalar64Partitioned, n_s, s, n_partition_s, 0, 0,
+            expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using VQFAVXSmall1 = FilterTestConfig<
+            VectorQuotient, FP, 8, parameter::LemireMurmurAVX232Partitioned, n_s, s, n_partition_s, 0, 0,
+            expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using VQFAVXSmall2 = FilterTestConfig<
+            VectorQuotient, FP, 16, parameter::PowerOfTwoMurmurAVX51264Partitioned, n_s, s, n_partition_l, 0, 0,
+            expected_fp>;
+
+    /*
+     * Large Test Types
+     */
+
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using VQFScalarLarge1 = FilterTestConfig<
+            VectorQuotient, FP, 16, parameter::PowerOfTwoMurmurScalar64, n_l, s, 0, 0, 0, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using VQFScalarLarge2 = FilterTestConfig<
+            VectorQuotient, FP, 8, parameter::MagicMurmurScalar32Partitioned, n_l, s, n_partition_l, 0, 0,
+            expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using VQFScalarLarge3 = FilterTestConfig<
+            VectorQuotient, FP, 8, parameter::LemireMurmurScalar32MT, n_l, s, 0, 4, 16, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using VQFAVX2Large1 = FilterTestConfig<
+            VectorQuotient, FP, 16, parameter::PowerOfTwoMurmurAVX264Partitioned, n_l, s, n_partition_l, 0, 0,
+            expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using VQFAVX2Large2 = FilterTestConfig<
+            VectorQuotient, FP, 8, parameter::MagicMurmurAVX232PartitionedMT, n_l, s, n_partition_l, 4, 16,
+            expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using VQFAVX512Large1 = FilterTestConfig<
+            VectorQuotient, FP, 8, parameter::PowerOfTwoMurmurAVX51232PartitionedMT, n_l, s, n_partition_l, 4, 16,
+            expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using VQFAVX512Large2 = FilterTestConfig<
+            VectorQuotient, FP, 16, parameter::LemireMurmurAVX51264Partitioned, n_l, s, n_partition_l, 0, 0,
+            expected_fp>;
+
+    /*
+     * Variant Test Types
+     */
+
+    using VQFStandardTestTypes = ::testing::Types<VQFScalarSmall1<vqf::Standard, 110, 40>,
+            VQFScalarSmall2<vqf::Standard, 110, 0>, VQFAVXSmall1<vqf::Standard, 110, 41>,
+            VQFAVXSmall2<vqf::Standard, 110, 0>, VQFScalarLarge1<vqf::Standard, 110, 117>,
+            VQFScalarLarge2<vqf::Standard, 110, 42035>, VQFScalarLarge3<vqf::Standard, 110, 42539>,
+            VQFAVX2Large1<vqf::Standard, 110, 132>, VQFAVX2Large2<vqf::Standard, 110, 42035>,
+            VQFAVX512Large1<vqf::Standard, 110, 29631>, VQFAVX512Large2<vqf::Standard, 110, 186>>;
+
+    using VQFShortcutTestTypes = ::testing::Types<VQFScalarSmall1<vqf::Shortcut, 110, 37>,
+            VQFScalarSmall2<vqf::Shortcut, 110, 0>, VQFAVXSmall1<vqf::Shortcut, 110, 37>,
+            VQFAVXSmall2<vqf::Shortcut, 110, 0>, VQFScalarLarge1<vqf::Shortcut, 110, 116>,
+            VQFScalarLarge2<vqf::Shortcut, 110, 42167>, VQFScalarLarge3<vqf::Shortcut, 110, 42211>,
+            VQFAVX2Large1<vqf::Shortcut, 110, 142>, VQFAVX2Large2<vqf::Shortcut, 110, 42167>,
+            VQFAVX512Large1<vqf::Shortcut, 110, 29612>, VQFAVX512Large2<vqf::Shortcut, 110, 199>>;
+
+}
@@ -7,6 +7,12 @@ namespace test::nxor {
 
     INSTANTIATE_TYPED_TEST_CASE_P(XorFuseTestTypes, FilterTest, XorFuseTestTypes);
 
+    INSTANTIATE_TYPED_TEST_CASE_P(XorBinaryFuse3TestTypes, FilterTest, XorBinaryFuse3TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(XorBinaryFuse4TestTypes, FilterTest, XorBinaryFuse4TestTypes);
+
+    INSTANTIATE_TYPED_TEST_CASE_P(XorStashTestTypes, FilterTest, XorStashTestTypes);
+
 }
 
 MAIN();
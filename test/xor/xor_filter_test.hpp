@@ -13,7 +13,7 @@ namespace test::nxor {
 
     static constexpr size_t k_s = 8, k_l = 16;
 
-    static constexpr size_t n_partition_s = 2, n_partition_l = 16;
+    static constexpr size_t n_partition_s = 2, n_partition_l = 16, n_partition_xl = 4096;
 
     static constexpr filters::FilterType Xor = filters::FilterType::Xor;
 
@@ -38,6 +38,8 @@ namespace test::nxor {
             FP, 8, parameter::MagicMurmurScalar32, n_l, s, 0, 0, 0, expected_fp>;
     template<template<size_t> typename FP, size_t s, int64_t expected_fp> using XorScalarLarge3 = FilterTestConfig<Xor,
             FP, 6, parameter::LemireMurmurScalar32PartitionedMT, n_l, s, n_partition_l, 4, 16, expected_fp>;
+    template<template<size_t> typename FP, size_t s, int64_t expected_fp> using XorScalarLarge4 = FilterTestConfig<Xor,
+            FP, 8, parameter::LemireMurmurScalar32Partitioned, n_l, s, n_partition_xl, 0, 0, expected_fp>;
     template<template<size_t> typename FP, size_t s, int64_t expected_fp> using XorAVX2Large1 = FilterTestConfig<Xor,
             FP, 16, parameter::PowerOfTwoMurmurAVX264Partitioned, n_l, s, n_partition_l, 0, 0, expected_fp>;
     template<template<size_t> typename FP, size_t s, int64_t expected_fp> using XorAVX2Large2 = FilterTestConfig<Xor,
@@ -59,7 +61,8 @@ namespace test::nxor {
     using XorStandardTestTypes = ::testing::Types<XorScalarSmall<nxor::Standard, 125, 8>,
             XorAVXSmall1<nxor::Standard, 125, 67>, XorAVXSmall2<nxor::Standard, 125, 3>,
             XorScalarLarge1<nxor::Standard, 125, 326>, XorScalarLarge2<nxor::Standard, 125, 39041>,
-            XorScalarLarge3<nxor::Standard, 125, 156567>, XorAVX2Large1<nxor::Standard, 125, 159>,
+            XorScalarLarge3<nxor::Standard, 125, 156567>, XorScalarLarge4<nxor::Standard, 125, 39057>,
+            XorAVX2Large1<nxor::Standard, 125, 159>,
             XorAVX2Large2<nxor::Standard, 125, 312591>, XorAVX2Large3<nxor::Standard, 125, 624988>,
             XorAVX512Large1<nxor::Standard, 125, 40397>, XorAVX512Large2<nxor::Standard, 125, 4926>,
             XorAVX512Large3<nxor::Standard, 125, 19320>>;
@@ -70,4 +73,29 @@ namespace test::nxor {
             XorAVX2Large1<nxor::Fuse, 110, 148>, XorAVX2Large2<nxor::Fuse, 130, 313145>,
             XorAVX2Large3<nxor::Fuse, 117, 624459>, XorAVX512Large1<nxor::Fuse, 110, 39440>,
             XorAVX512Large2<nxor::Fuse, 117, 4930>, XorAVX512Large3<nxor::Fuse, 117, 19613>>;
+
+    using XorBinaryFuse3TestTypes = ::testing::Types<XorScalarSmall<nxor::BinaryFuse3, 300, 9>,
+            XorAVXSmall1<nxor::BinaryFuse3, 500, 66>, XorAVXSmall2<nxor::BinaryFuse3, 500, 0>,
+            XorScalarLarge1<nxor::BinaryFuse3, 113, 297>, XorScalarLarge2<nxor::BinaryFuse3, 117, 39167>,
+            XorScalarLarge3<nxor::BinaryFuse3, 125, 156618>, XorAVX2Large1<nxor::BinaryFuse3, 125, 135>,
+            XorAVX2Large2<nxor::BinaryFuse3, 125, 312552>, XorAVX2Large3<nxor::BinaryFuse3, 125, 625437>,
+            XorAVX512Large1<nxor::BinaryFuse3, 125, 39049>, XorAVX512Large2<nxor::BinaryFuse3, 125, 4884>,
+            XorAVX512Large3<nxor::BinaryFuse3, 125, 19478>>;
+
+    using XorBinaryFuse4TestTypes = ::testing::Types<XorScalarSmall<nxor::BinaryFuse4, 300, 7>,
+            XorAVXSmall1<nxor::BinaryFuse4, 500, 81>, XorAVXSmall2<nxor::BinaryFuse4, 500, 1>,
+            XorScalarLarge1<nxor::BinaryFuse4, 110, 298>, XorScalarLarge2<nxor::BinaryFuse4, 117, 38867>,
+            XorScalarLarge3<nxor::BinaryFuse4, 120, 155830>, XorAVX2Large1<nxor::BinaryFuse4, 120, 150>,
+            XorAVX2Large2<nxor::BinaryFuse4, 120, 312138>, XorAVX2Large3<nxor::BinaryFuse4, 120, 624978>,
+            XorAVX512Large1<nxor::BinaryFuse4, 120, 39080>, XorAVX512Large2<nxor::BinaryFuse4, 120, 4889>,
+            XorAVX512Large3<nxor::BinaryFuse4, 120, 19510>>;
+
+    /*
+     * Stash Test Types, the sizes are too small to peel all keys
+     */
+
+    using XorStashTestTypes = ::testing::Types<XorScalarSmall<nxor::StandardStash, 110, 10>,
+            XorScalarLarge2<nxor::StandardStash, 115, 38997>, XorAVX2Large2<nxor::StandardStash, 118, 312063>,
+            XorAVX512Large2<nxor::FuseStash, 105, 4896>, XorScalarLarge3<nxor::BinaryFuse3Stash, 105, 155208>,
+            XorAVX2Large3<nxor::BinaryFuse4Stash, 100, 623196>>;
 }